@@ -4,6 +4,8 @@
 #include "CppUnitTest.h"
 
 #include <DiaDataSource.h>
+#include <DiaParallelHash.h>
+#include <DiaStructuralHash.h>
 #include <SymbolTypes/DiaPointer.h>
 
 #define SIMPLE_HASHABLES_PDB_FILE_PATH CTESTS_ADHOC_RESOURCES_DIR L"simple_hashables.pdb"
@@ -160,5 +162,157 @@ TEST_CLASS(ComplexStructs)
 
         Assert::AreEqual(capturedStructHash, recursivePointerDecayType.calcHash());
     }
+
+    TEST_METHOD(StructuralHashOfRecursiveStruct)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(COMPLEX_HASHABLES_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+        const auto recursiveStruct = dataSource.getStruct(AnyString{"RecursiveHash_s"});
+        const auto parentStruct    = dataSource.getStruct(AnyString{"ParentHash_s"});
+
+        dia::StructuralHasher hasher{};
+        const auto recursiveStructHash = hasher.hash(recursiveStruct);
+        Assert::AreNotEqual(0uLL, recursiveStructHash);
+        Assert::AreEqual(recursiveStructHash, hasher.hash(recursiveStruct));
+        Assert::AreEqual(recursiveStructHash, dia::StructuralHasher{}.hash(recursiveStruct));
+        Assert::AreNotEqual(recursiveStructHash, hasher.hash(parentStruct));
+
+        const auto allHashes = hasher.hashTypes(dataSource);
+        Assert::AreEqual(recursiveStructHash, allHashes.at(dia::getSymIndexId(recursiveStruct)));
+
+        // Memoized hashes must not depend on the order the types are hashed in.
+        dia::StructuralHasher reverseOrderHasher{};
+        const auto parentStructHash = reverseOrderHasher.hash(parentStruct);
+        Assert::AreEqual(recursiveStructHash, reverseOrderHasher.hash(recursiveStruct));
+        Assert::AreEqual(parentStructHash, dia::StructuralHasher{}.hash(parentStruct));
+    }
+
+    TEST_METHOD(SeededStructuralHashesAreIndependent)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(COMPLEX_HASHABLES_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+        const auto recursiveStruct = dataSource.getStruct(AnyString{"RecursiveHash_s"});
+
+        const auto seededHash = dia::StructuralHasher{1}.hash(recursiveStruct);
+        Assert::AreEqual(seededHash, dia::StructuralHasher{1}.hash(recursiveStruct));
+        Assert::AreNotEqual(seededHash, dia::StructuralHasher{}.hash(recursiveStruct));
+        Assert::AreEqual(dia::StructuralHasher{0}.hash(recursiveStruct), dia::StructuralHasher{}.hash(recursiveStruct));
+    }
+
+    TEST_METHOD(DataSourceMemoizesUdtHashes)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(COMPLEX_HASHABLES_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+        const auto recursiveStruct = dataSource.getStruct(AnyString{"RecursiveHash_s"});
+
+        Assert::AreEqual(recursiveStruct.calcHash(), dataSource.calcHash(recursiveStruct));
+        Assert::AreEqual(dataSource.getStructuralHash(recursiveStruct), dia::StructuralHasher{}.hash(recursiveStruct));
+        Assert::AreEqual(recursiveStruct.calcHash(), dataSource.calcHash(recursiveStruct));
+    }
+};
+
+TEST_CLASS(StableHashing)
+{
+    TEST_METHOD(KnownAnswers)
+    {
+        // These must only change along with dia::STABLE_HASH_VERSION.
+        const auto hash = dia::StableHasher{}.add(std::wstring{L"RecursiveHash_s"}).add(42).digest128();
+        Assert::AreEqual(0x212d261cbb819447uLL, hash.low);
+        Assert::AreEqual(0xb86ac5e6e158483duLL, hash.high);
+
+        size_t combinedHash = 0;
+        hash_combine(combinedHash, std::wstring{L"IntHash_s"}, 4u, true);
+        Assert::AreEqual(static_cast<size_t>(0x39677290f1ec1810uLL), combinedHash);
+    }
+
+    TEST_METHOD(IndependentFromChunking)
+    {
+        std::vector<uint8_t> data(1000);
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            data[i] = static_cast<uint8_t>(i * 7 + 1);
+        }
+
+        dia::StableHasher wholeHasher{};
+        wholeHasher.update(data.data(), data.size());
+        for (const size_t chunkSize : {1, 3, 31, 32, 33, 100})
+        {
+            dia::StableHasher chunkedHasher{};
+            for (size_t offset = 0; offset < data.size(); offset += chunkSize)
+            {
+                chunkedHasher.update(data.data() + offset, (std::min)(chunkSize, data.size() - offset));
+            }
+            Assert::IsTrue(wholeHasher.digest128() == chunkedHasher.digest128());
+        }
+    }
+
+    TEST_METHOD(IntegersAreWidened)
+    {
+        size_t narrowHash = 0;
+        size_t wideHash   = 0;
+        hash_combine(narrowHash, static_cast<int16_t>(-1), static_cast<uint8_t>(7));
+        hash_combine(wideHash, static_cast<int64_t>(-1), static_cast<uint64_t>(7));
+        Assert::AreEqual(wideHash, narrowHash);
+    }
+};
+
+TEST_CLASS(HashAll)
+{
+    TEST_METHOD(ParallelHashesMatchSerialHashes)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(COMPLEX_HASHABLES_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+        const auto serialHashes   = dia::hashAll(dataSource, 1);
+        const auto parallelHashes = dia::hashAll(dataSource, 4);
+        Assert::IsFalse(serialHashes.empty());
+        Assert::IsTrue(serialHashes == parallelHashes);
+
+        const auto recursiveStruct = dataSource.getStruct(AnyString{"RecursiveHash_s"});
+        Assert::AreEqual(recursiveStruct.calcHash(), parallelHashes.at(dia::getSymIndexId(recursiveStruct)));
+    }
+
+    TEST_METHOD(ParallelHashesAreKeyedByTheCallersSession)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(COMPLEX_HASHABLES_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+        // Looking symbols up before enumerating gives them symIndexIds which the sessions of the workers assign to other symbols.
+        const auto parentStruct    = dataSource.getStruct(AnyString{"ParentHash_s"});
+        const auto recursiveStruct = dataSource.getStruct(AnyString{"RecursiveHash_s"});
+
+        const auto parallelHashes = dia::hashAll(dataSource, 4);
+        Assert::AreEqual(parentStruct.calcHash(), parallelHashes.at(dia::getSymIndexId(parentStruct)));
+        Assert::AreEqual(recursiveStruct.calcHash(), parallelHashes.at(dia::getSymIndexId(recursiveStruct)));
+        Assert::IsTrue(dia::hashAll(dataSource, 1) == parallelHashes);
+    }
+
+    TEST_METHOD(ParallelHashesOfNestedUdtsAndArraysMatchSerialHashes)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+        // Both have anonymous nested unions and structs, and array members. Looking them up first gives them (and their parents) symIndexIds
+        // which the sessions of the workers assign to other symbols.
+        const auto thread     = dataSource.getStruct(AnyString{"_KTHREAD"});
+        const auto tableEntry = dataSource.getStruct(AnyString{"_LDR_DATA_TABLE_ENTRY"});
+
+        const auto serialHashes   = dia::hashAll(dataSource, 1);
+        const auto parallelHashes = dia::hashAll(dataSource, 4);
+        Assert::IsTrue(serialHashes == parallelHashes);
+
+        size_t arrayCount = 0;
+        for (const auto& udt : {thread, tableEntry})
+        {
+            Assert::AreEqual(udt.calcHash(), parallelHashes.at(dia::getSymIndexId(udt)));
+            for (const auto& member : dia::enumerate<dia::Symbol>(udt, SymTagData))
+            {
+                const auto memberType = dia::getType(member);
+                if (SymTagArrayType == dia::getSymTag(memberType))
+                {
+                    Assert::AreEqual(memberType.calcHash(), dataSource.calcHash(memberType));
+                    ++arrayCount;
+                }
+            }
+        }
+        Assert::AreNotEqual(size_t{0}, arrayCount);
+    }
 };
 }  // namespace Hashing
@@ -0,0 +1,41 @@
+#include <stdint.h>
+
+struct Shape_s
+{
+    int32_t Width;
+    int32_t Height;
+    int32_t Depth;
+};
+
+struct Kind_s
+{
+    int32_t Value;
+};
+
+struct Inner_s
+{
+    int32_t First;
+};
+
+struct Outer_s
+{
+    Inner_s Inner;
+    int32_t Count;
+};
+
+class Widget
+{
+public:
+    int32_t resize(int32_t size) { return Size = size; }
+
+    int32_t Size;
+};
+
+int main()
+{
+    Shape_s shape{};
+    Kind_s kind{};
+    Outer_s outer{};
+    Widget widget{};
+    return shape.Width + kind.Value + outer.Count + widget.resize(2);
+}
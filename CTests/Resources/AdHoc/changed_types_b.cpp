@@ -0,0 +1,48 @@
+#include <stdint.h>
+
+struct Shape_s
+{
+    int64_t Width;
+    int32_t Color;
+    int32_t Depth;
+};
+
+enum Kind_s
+{
+    KindValue = 1,
+};
+
+struct Inner_s
+{
+    int32_t Renamed;
+};
+
+struct Outer_s
+{
+    Inner_s Inner;
+    int32_t Count;
+};
+
+class Widget
+{
+public:
+    struct Options_s
+    {
+        int32_t Flags;
+    };
+
+    int32_t resize(int32_t size) { return Size = size; }
+    int32_t area() const { return Size * Size; }
+
+    int32_t Size;
+};
+
+int main()
+{
+    Shape_s shape{};
+    Kind_s kind = KindValue;
+    Outer_s outer{};
+    Widget widget{};
+    Widget::Options_s options{};
+    return static_cast<int32_t>(shape.Width) + kind + options.Flags + outer.Count + widget.resize(2) + widget.area();
+}
@@ -0,0 +1,52 @@
+#include <stdint.h>
+
+struct Leaf_s
+{
+    int32_t Value;
+};
+
+struct Branch_s
+{
+    int32_t Value;
+};
+
+struct Holder_s
+{
+    struct
+    {
+        Leaf_s Leaf;
+    } Direct;
+    struct
+    {
+        Branch_s Branch;
+    }* Indirect;
+};
+
+template <typename T>
+struct Box_s
+{
+    T Value;
+};
+
+struct Grid_s
+{
+    struct
+    {
+        int16_t X;
+        int16_t Y;
+    } Cells[4][2];
+    enum
+    {
+        GridSmall,
+        GridLarge,
+    } Sizes[3];
+    Box_s<int64_t> Box;
+};
+
+int main()
+{
+    Branch_s branch{};
+    Holder_s holder{};
+    Grid_s grid{};
+    return holder.Direct.Leaf.Value + branch.Value + grid.Cells[1][1].X + grid.Sizes[2] + static_cast<int>(grid.Box.Value);
+}
@@ -4,7 +4,9 @@
 #include "CppUnitTest.h"
 
 #include <DiaDataSource.h>
+#include <DiaSymbolDump.h>
 #include <SymbolTypes/DiaPointer.h>
+#include <sstream>
 
 #define SIMPLE_HASHABLES_PDB_FILE_PATH CTESTS_ADHOC_RESOURCES_DIR L"simple_hashables.pdb"
 
@@ -49,6 +51,78 @@ public:
         Assert::IsTrue(dataSource.getSession().areSymbolsEquivalent(originalSymbol, foundSymbol));
     }
 
+    TEST_METHOD(CachedTypeNameResolution)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        const auto udt = dataSource.getStruct("_LDR_DATA_TABLE_ENTRY");
+        for (const auto& member : dia::enumerate<dia::Symbol>(udt, SymTagData))
+        {
+            const auto memberType = dia::getType(member);
+            const auto& typeName  = dataSource.resolveTypeName(memberType);
+            Assert::AreEqual(dia::resolveTypeName(memberType), typeName);
+            // The second resolution comes from the cache.
+            Assert::IsTrue(&typeName == &dataSource.resolveTypeName(memberType));
+        }
+    }
+
+    TEST_METHOD(InternedUtf8Names)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        const auto unicodeString = dataSource.getStruct("_UNICODE_STRING");
+        const auto ansiString    = dataSource.getStruct("_STRING");
+        const auto unicodeName = dataSource.getUtf8Name(unicodeString);
+        Assert::AreEqual(std::string("_UNICODE_STRING"), std::string(unicodeName.data, unicodeName.size));
+
+        // Both structs start with a `Length` member, whose name is stored once and has a single id.
+        const auto unicodeLength = *dia::enumerate<dia::Symbol>(unicodeString, SymTagData).begin();
+        const auto ansiLength    = *dia::enumerate<dia::Symbol>(ansiString, SymTagData).begin();
+        const auto lengthName    = dataSource.getUtf8Name(unicodeLength);
+        Assert::AreEqual(std::string("Length"), std::string(lengthName.data, lengthName.size));
+        Assert::IsTrue(lengthName.data == dataSource.getUtf8Name(ansiLength).data);
+        Assert::AreEqual(dataSource.getNameId(unicodeLength), dataSource.getNameId(ansiLength));
+        Assert::AreNotEqual(dataSource.getNameId(unicodeLength), dataSource.getNameId(unicodeString));
+    }
+
+    TEST_METHOD(StreamUdtAndMembers)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        const auto udt = dataSource.getStruct("_LIST_ENTRY");
+        std::wostringstream udtStream{};
+        udtStream << static_cast<const dia::Symbol&>(udt);
+        Assert::AreEqual(size_t{0}, udtStream.str().find(L"UDT struct `_LIST_ENTRY` length=0x"));
+
+        std::wostringstream membersStream{};
+        for (const auto& member : dia::enumerate<dia::Symbol>(udt, SymTagData))
+        {
+            membersStream << member << L'\n';
+        }
+        // Blink comes one pointer after Flink, whichever the architecture of the PDB.
+        const std::wstring blinkOffset = (8 == sizeof(void*)) ? L"0x8" : L"0x4";
+        Assert::AreEqual(L"Data member `Flink` type=_LIST_ENTRY* offset=0x0\nData member `Blink` type=_LIST_ENTRY* offset=" + blinkOffset + L"\n",
+                         membersStream.str());
+    }
+
+    TEST_METHOD(DumpStopsWhenTheSinkThrows)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        dia::SymbolDumpOptions options{};
+        options.includeTypes   = false;
+        options.includeGlobals = false;
+        options.includePublics = false;
+        options.workerCount    = 2;
+        Assert::ExpectException<std::runtime_error>(
+            [&dataSource, &options]()
+            { dia::dumpSymbols(dataSource, [](const char*, size_t) { throw std::runtime_error("The sink is full!"); }, options); });
+    }
+
     TEST_METHOD(FindByFQIDAndCheckEquiv)
     {
         const std::wstring pdbFilePath = std::filesystem::absolute(SIMPLE_HASHABLES_PDB_FILE_PATH);
@@ -4,8 +4,24 @@
 #include "CppUnitTest.h"
 
 #include "DiaDataSource.h"
+#include "DiaDecodePlan.h"
+#include "DiaFieldPath.h"
+#include "DiaLinkWalker.h"
+#include "DiaMinidump.h"
+#include "DiaStructLayout.h"
+#include "DiaStructuralHash.h"
+#include "DiaTypeDependencyGraph.h"
+#include "DiaTypeDiff.h"
+#include "DiaTypeEquivalence.h"
+#include "DiaTypeReferenceIndex.h"
+#include "DiaTypeStore.h"
 #include "DiaUserDefinedTypeWrapper.h"
+#include <DbgHelp.h>
+#include <algorithm>
+#include <fstream>
+#include <functional>
 #include <set>
+#include <tuple>
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
@@ -73,4 +89,561 @@ public:
         }
     }
 };
+
+TEST_CLASS(TypeDiff)
+{
+public:
+    TEST_METHOD(IdenticalDataSourcesHaveNoDiff)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"equal_structs_a.pdb");
+        dia::DataSource oldDataSource{pdbFilePath};
+        dia::DataSource newDataSource{pdbFilePath};
+        Assert::IsTrue(dia::diffTypes(oldDataSource, newDataSource).empty());
+    }
+
+    TEST_METHOD(EqualStructsAreNotReported)
+    {
+        dia::DataSource oldDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"equal_structs_a.pdb").wstring()};
+        dia::DataSource newDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"equal_structs_b.pdb").wstring()};
+        for (const auto& typeDiff : dia::diffTypes(oldDataSource, newDataSource))
+        {
+            Assert::AreNotEqual(std::wstring{L"FirstStruct_s"}, typeDiff.name);
+            Assert::AreNotEqual(std::wstring{L"SecondStruct_s"}, typeDiff.name);
+        }
+    }
+
+    TEST_METHOD(ChangedMembersAreReported)
+    {
+        dia::DataSource oldDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_a.pdb").wstring()};
+        dia::DataSource newDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_b.pdb").wstring()};
+        const auto typeDiffs = dia::diffTypes(oldDataSource, newDataSource);
+
+        const auto shapeDiff = findTypeDiff(typeDiffs, SymTagUDT, L"Shape_s");
+        Assert::IsNotNull(shapeDiff);
+        Assert::IsTrue(dia::DiffKind::Changed == shapeDiff->kind);
+
+        const auto widthDiff = findMemberDiff(*shapeDiff, L"Width");
+        Assert::IsNotNull(widthDiff);
+        Assert::IsTrue(dia::DiffKind::Changed == widthDiff->kind);
+        Assert::IsTrue(widthDiff->sizeChanged());
+        Assert::IsTrue(widthDiff->typeChanged());
+        Assert::IsFalse(widthDiff->offsetChanged());
+
+        const auto depthDiff = findMemberDiff(*shapeDiff, L"Depth");
+        Assert::IsNotNull(depthDiff);
+        Assert::IsTrue(dia::DiffKind::Changed == depthDiff->kind);
+        Assert::IsTrue(depthDiff->offsetChanged());
+        Assert::AreEqual(8L, depthDiff->oldOffset);
+        Assert::AreEqual(12L, depthDiff->newOffset);
+
+        const auto heightDiff = findMemberDiff(*shapeDiff, L"Height");
+        Assert::IsNotNull(heightDiff);
+        Assert::IsTrue(dia::DiffKind::Removed == heightDiff->kind);
+
+        const auto colorDiff = findMemberDiff(*shapeDiff, L"Color");
+        Assert::IsNotNull(colorDiff);
+        Assert::IsTrue(dia::DiffKind::Added == colorDiff->kind);
+        Assert::AreEqual(8L, colorDiff->newOffset);
+    }
+
+    TEST_METHOD(ChangedMethodsAndNestedTypesAreReported)
+    {
+        dia::DataSource oldDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_a.pdb").wstring()};
+        dia::DataSource newDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_b.pdb").wstring()};
+        const auto typeDiffs = dia::diffTypes(oldDataSource, newDataSource);
+
+        // Only the methods and nested types of Widget changed, which must still be reported as members.
+        const auto widgetDiff = findTypeDiff(typeDiffs, SymTagUDT, L"Widget");
+        Assert::IsNotNull(widgetDiff);
+        Assert::IsFalse(widgetDiff->members.empty());
+        const auto areaDiff = findMemberDiff(*widgetDiff, L"area");
+        Assert::IsNotNull(areaDiff);
+        Assert::IsTrue(dia::DiffKind::Added == areaDiff->kind);
+        Assert::IsTrue(SymTagFunction == areaDiff->symTag);
+        Assert::IsNull(findMemberDiff(*widgetDiff, L"resize"));
+        const auto isAddedNestedType = [](const dia::MemberDiff& memberDiff)
+        { return SymTagUDT == memberDiff.symTag && dia::DiffKind::Added == memberDiff.kind; };
+        Assert::IsTrue(std::any_of(widgetDiff->members.begin(), widgetDiff->members.end(), isAddedNestedType));
+    }
+
+    TEST_METHOD(TypesAreMatchedByTagAndName)
+    {
+        dia::DataSource oldDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_a.pdb").wstring()};
+        dia::DataSource newDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_b.pdb").wstring()};
+        const auto typeDiffs = dia::diffTypes(oldDataSource, newDataSource);
+
+        const auto removedStruct = findTypeDiff(typeDiffs, SymTagUDT, L"Kind_s");
+        Assert::IsNotNull(removedStruct);
+        Assert::IsTrue(dia::DiffKind::Removed == removedStruct->kind);
+        const auto addedEnum = findTypeDiff(typeDiffs, SymTagEnum, L"Kind_s");
+        Assert::IsNotNull(addedEnum);
+        Assert::IsTrue(dia::DiffKind::Added == addedEnum->kind);
+    }
+
+    TEST_METHOD(ChangedMemberTypeContentIsReported)
+    {
+        dia::DataSource oldDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_a.pdb").wstring()};
+        dia::DataSource newDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_b.pdb").wstring()};
+        const auto typeDiffs = dia::diffTypes(oldDataSource, newDataSource);
+
+        // Only a member of Inner_s was renamed, the members of Outer_s keep their names, offsets, sizes and type names.
+        const auto outerDiff = findTypeDiff(typeDiffs, SymTagUDT, L"Outer_s");
+        Assert::IsNotNull(outerDiff);
+        const auto innerDiff = findMemberDiff(*outerDiff, L"Inner");
+        Assert::IsNotNull(innerDiff);
+        Assert::IsTrue(dia::DiffKind::Changed == innerDiff->kind);
+        Assert::IsTrue(innerDiff->typeContentChanged);
+        Assert::IsFalse(innerDiff->typeChanged());
+        Assert::IsNull(findMemberDiff(*outerDiff, L"Count"));
+
+        for (const auto& typeDiff : typeDiffs)
+        {
+            if (dia::DiffKind::Changed == typeDiff.kind)
+            {
+                Assert::IsTrue(typeDiff.sizeChanged() || typeDiff.attributesChanged || !typeDiff.members.empty());
+            }
+        }
+    }
+
+    TEST_METHOD(TypeDiffsAreSortedByKindTagAndName)
+    {
+        dia::DataSource oldDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_a.pdb").wstring()};
+        dia::DataSource newDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_b.pdb").wstring()};
+        const auto typeDiffs = dia::diffTypes(oldDataSource, newDataSource);
+
+        const auto kindOrder = [](dia::DiffKind kind)
+        { return (dia::DiffKind::Removed == kind) ? 0 : ((dia::DiffKind::Changed == kind) ? 1 : 2); };
+        const auto isOrdered = [&kindOrder](const dia::TypeDiff& first, const dia::TypeDiff& second)
+        {
+            return std::make_tuple(kindOrder(first.kind), first.symTag, std::cref(first.name)) <
+                   std::make_tuple(kindOrder(second.kind), second.symTag, std::cref(second.name));
+        };
+        Assert::IsTrue(std::is_sorted(typeDiffs.begin(), typeDiffs.end(), isOrdered));
+
+        // A second diff from other sessions, where the types are looked up in another order, reports them in the same order.
+        dia::DataSource otherOldDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_a.pdb").wstring()};
+        dia::DataSource otherNewDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_b.pdb").wstring()};
+        otherNewDataSource.getStruct(AnyString{"Widget"});
+        const auto otherTypeDiffs = dia::diffTypes(otherOldDataSource, otherNewDataSource);
+        Assert::AreEqual(typeDiffs.size(), otherTypeDiffs.size());
+        for (size_t i = 0; i < typeDiffs.size(); ++i)
+        {
+            Assert::AreEqual(typeDiffs[i].name, otherTypeDiffs[i].name);
+        }
+    }
+
+private:
+    static const dia::TypeDiff* findTypeDiff(const std::vector<dia::TypeDiff>& typeDiffs, enum SymTagEnum symTag, const std::wstring& name)
+    {
+        const auto typeDiff = std::find_if(typeDiffs.begin(), typeDiffs.end(),
+                                           [symTag, &name](const dia::TypeDiff& diff) { return symTag == diff.symTag && name == diff.name; });
+        return (typeDiffs.end() == typeDiff) ? nullptr : &*typeDiff;
+    }
+
+    static const dia::MemberDiff* findMemberDiff(const dia::TypeDiff& typeDiff, const std::wstring& name)
+    {
+        const auto memberDiff = std::find_if(typeDiff.members.begin(), typeDiff.members.end(),
+                                             [&name](const dia::MemberDiff& diff) { return name == diff.name; });
+        return (typeDiff.members.end() == memberDiff) ? nullptr : &*memberDiff;
+    }
+};
+
+TEST_CLASS(TypeEquivalence)
+{
+public:
+    TEST_METHOD(EveryTypeBelongsToExactlyOneClass)
+    {
+        dia::DataSource dataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"equal_structs_a.pdb").wstring()};
+        const dia::TypeEquivalenceClasses equivalenceClasses{dataSource};
+
+        size_t typeCount = 0;
+        for (const auto symTag : {SymTagUDT, SymTagEnum, SymTagTypedef})
+        {
+            for (const auto& type : dataSource.getSymbols(symTag))
+            {
+                const auto& equivalenceClass = equivalenceClasses.getClassOf(type);
+                Assert::IsTrue(std::binary_search(equivalenceClass.symIndexIds.begin(), equivalenceClass.symIndexIds.end(), type.getSymIndexId()));
+                Assert::AreEqual(equivalenceClass.canonicalSymIndexId, equivalenceClasses.getCanonicalSymIndexId(type.getSymIndexId()));
+                ++typeCount;
+            }
+        }
+
+        size_t classSizesSum = 0;
+        for (const auto& equivalenceClass : equivalenceClasses.getClasses())
+        {
+            Assert::IsTrue(equivalenceClasses.contains(equivalenceClass.canonicalSymIndexId));
+            classSizesSum += equivalenceClass.size();
+        }
+        Assert::AreEqual(typeCount, classSizesSum);
+    }
+};
+
+TEST_CLASS(TypeStore)
+{
+public:
+    TEST_METHOD(UnchangedTypesAreStoredOnce)
+    {
+        const auto storeFilePath = std::filesystem::temp_directory_path() / L"CTests_TypeStore.bin";
+        std::filesystem::remove(storeFilePath);
+
+        dia::DataSource firstDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"equal_structs_a.pdb").wstring()};
+        dia::DataSource secondDataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"equal_structs_b.pdb").wstring()};
+        const auto firstStructHash = dia::StructuralHasher{}.hash(firstDataSource.getStruct(L"FirstStruct_s"));
+        {
+            dia::TypeStore typeStore{storeFilePath.wstring()};
+            const auto firstNewTypeCount  = typeStore.ingest(L"a", firstDataSource);
+            const auto secondNewTypeCount = typeStore.ingest(L"b", secondDataSource);
+            Assert::IsTrue(0 < firstNewTypeCount);
+            Assert::IsTrue(secondNewTypeCount < typeStore.getBuildTypes(L"b").size());
+            Assert::ExpectException<dia::InvalidUsageException>([&]() { typeStore.ingest(L"a", firstDataSource); });
+        }
+
+        // Everything is read back from the file.
+        const dia::TypeStore typeStore{storeFilePath.wstring()};
+        Assert::AreEqual(size_t{2}, typeStore.getBuilds().size());
+        Assert::IsTrue(std::vector<std::wstring>{L"a", L"b"} == typeStore.getBuildsContaining(firstStructHash));
+        Assert::AreEqual(std::wstring{L"FirstStruct_s"}, typeStore.getType(firstStructHash).name);
+    }
+
+    TEST_METHOD(EverythingTheHashCoversIsStored)
+    {
+        const auto storeFilePath = std::filesystem::temp_directory_path() / L"CTests_TypeStore_Members.bin";
+        std::filesystem::remove(storeFilePath);
+
+        dia::DataSource dataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"changed_types_b.pdb").wstring()};
+        const auto widget     = dataSource.getStruct(L"Widget");
+        const auto widgetHash = dia::StructuralHasher{}.hash(widget);
+        dia::TypeStore typeStore{storeFilePath.wstring()};
+        typeStore.ingest(L"b", dataSource);
+
+        const auto storedWidget       = typeStore.getType(widgetHash);
+        const uint64_t confirmingHash = dia::StructuralHasher{dia::CONFIRMING_STRUCTURAL_HASH_SEED}.hash(widget);
+        Assert::AreEqual(confirmingHash, storedWidget.confirmingHash);
+        const auto hasMember = [&storedWidget](enum SymTagEnum symTag, const std::wstring& name)
+        {
+            return std::any_of(storedWidget.members.begin(), storedWidget.members.end(), [symTag, &name](const dia::StoredMember& member)
+                               { return symTag == member.symTag && std::wstring::npos != member.name.find(name); });
+        };
+        Assert::IsTrue(hasMember(SymTagData, L"Size"));
+        Assert::IsTrue(hasMember(SymTagFunction, L"resize"));
+        Assert::IsTrue(hasMember(SymTagFunction, L"area"));
+        Assert::IsTrue(hasMember(SymTagUDT, L"Options_s"));
+    }
+};
+
+TEST_CLASS(TypeDependencyGraph)
+{
+public:
+    TEST_METHOD(TopologicalOrderRespectsByValueDependencies)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+        const dia::TypeDependencyGraph graph{dataSource};
+
+        const auto order = graph.getTopologicalOrder();
+        Assert::AreEqual(graph.getNodeCount(), order.size());
+        std::vector<size_t> positions(graph.getNodeCount());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            positions[order[i]] = i;
+        }
+        for (size_t node = 0; node < graph.getNodeCount(); ++node)
+        {
+            for (const auto& edge : graph.getDependencies(node))
+            {
+                Assert::IsTrue(dia::TypeEdgeKind::ByPointer == edge.kind || positions[edge.target] < positions[node]);
+            }
+        }
+
+        for (const auto& cycleBreak : graph.suggestCycleBreaks())
+        {
+            const auto dependencies = graph.getDependencies(cycleBreak.first);
+            const auto edge         = std::find_if(dependencies.begin(), dependencies.end(),
+                                                   [&cycleBreak](const dia::TypeEdge& dependency) { return dependency.target == cycleBreak.second; });
+            Assert::IsTrue(dependencies.end() != edge);
+            Assert::IsTrue(dia::TypeEdgeKind::ByPointer == edge->kind);
+        }
+        Assert::IsFalse(graph.getStronglyConnectedComponents().empty());
+        Assert::IsTrue(graph.getStronglyConnectedComponents(false).empty());
+    }
+
+    TEST_METHOD(UnnamedTypesBehindPointersAreDeclarationDependencies)
+    {
+        dia::DataSource dataSource{std::filesystem::absolute(CTESTS_ADHOC_RESOURCES_DIR L"unnamed_types.pdb").wstring()};
+        const dia::TypeDependencyGraph graph{dataSource};
+
+        // Holder_s contains an unnamed struct with a Leaf_s, and points to an unnamed struct with a Branch_s.
+        const auto holder       = graph.getNode(dataSource.getStruct("Holder_s").getSymIndexId());
+        const auto leaf         = graph.getNode(dataSource.getStruct("Leaf_s").getSymIndexId());
+        const auto branch       = graph.getNode(dataSource.getStruct("Branch_s").getSymIndexId());
+        const auto dependencies = graph.getDependencies(holder);
+        const auto findEdge     = [&dependencies](size_t target)
+        { return std::find_if(dependencies.begin(), dependencies.end(), [target](const dia::TypeEdge& edge) { return edge.target == target; }); };
+        Assert::IsTrue(dependencies.end() != findEdge(leaf));
+        Assert::IsTrue(dia::TypeEdgeKind::ByValue == findEdge(leaf)->kind);
+        Assert::IsTrue(dependencies.end() != findEdge(branch));
+        Assert::IsTrue(dia::TypeEdgeKind::ByPointer == findEdge(branch)->kind);
+    }
+};
+
+TEST_CLASS(TypeReferenceIndex)
+{
+public:
+    TEST_METHOD(FindsTheStructsPointingToAType)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+        const dia::TypeReferenceIndex index{dataSource};
+        const dia::TypeEquivalenceClasses equivalenceClasses{dataSource};
+
+        // _LDR_DATA_TABLE_ENTRY::DdagNode is a _LDR_DDAG_NODE*.
+        const auto ddagNode   = dataSource.getStruct("_LDR_DDAG_NODE");
+        const auto references = index.getReferencesTo(equivalenceClasses.getClassOf(ddagNode));
+        Assert::IsTrue(std::any_of(references.begin(), references.end(),
+                                   [&dataSource](const dia::TypeReference& reference)
+                                   {
+                                       return dia::TypeReferenceKind::ByPointer == reference.kind &&
+                                              std::wstring{L"_LDR_DATA_TABLE_ENTRY"} ==
+                                                  std::wstring{dataSource.getSymbolById(reference.referrerSymIndexId).getName()};
+                                   }));
+        // The references to the definition itself are a subset of the ones to its whole equivalence class.
+        for (const auto& reference : index.getReferencesTo(ddagNode))
+        {
+            Assert::IsTrue(std::any_of(references.begin(), references.end(),
+                                       [&reference](const dia::TypeReference& other)
+                                       { return reference.referrerSymIndexId == other.referrerSymIndexId && reference.kind == other.kind; }));
+        }
+    }
+};
+
+TEST_CLASS(StructLayout)
+{
+public:
+    TEST_METHOD(PointerAfterShortsLeavesAHole)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        // USHORT Length, USHORT MaximumLength, PWSTR Buffer: the buffer is pointer aligned, which leaves a hole before it on 64-bit.
+        const auto layout = dataSource.getStruct("_UNICODE_STRING").analyzeLayout();
+        Assert::AreEqual(size_t{3}, layout.fields.size());
+        Assert::IsTrue(sizeof(void*) == layout.alignment);
+        Assert::IsTrue(sizeof(void*) == layout.fields[2].offset);
+        Assert::IsTrue(((8 == sizeof(void*)) ? 4 : 0) == layout.getHoleSize());
+        Assert::IsTrue(0 == layout.tailPadding);
+        Assert::IsTrue(layout.size == layout.minimumSize);
+        Assert::AreEqual(size_t{0}, layout.getStraddlingFieldCount());
+    }
+
+    TEST_METHOD(FlattenedUnionMembersAreCountedOnce)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        // Both have anonymous unions (e.g. _LDR_DATA_TABLE_ENTRY::FlagGroup, Flags and the bitfields after them), whose members overlap.
+        for (const auto* name : {"_LDR_DATA_TABLE_ENTRY", "_KTHREAD"})
+        {
+            const auto layout = dataSource.getStruct(name).analyzeLayout();
+            Assert::IsTrue(std::adjacent_find(layout.fields.begin(), layout.fields.end(),
+                                              [](const dia::LayoutField& first, const dia::LayoutField& second)
+                                              { return first.offset + first.size > second.offset; }) != layout.fields.end());
+
+            // Every byte is either padding or taken by some field, and sorting the fields can at most remove the padding.
+            const auto usedSize     = layout.size - layout.getPaddingSize();
+            const auto expectedSize = (usedSize + layout.alignment - 1) / layout.alignment * layout.alignment;
+            Assert::IsTrue((std::min)(layout.size, expectedSize) == layout.minimumSize);
+        }
+    }
+
+    TEST_METHOD(ReportIsIdenticalAcrossWorkerCounts)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        const auto serialLayouts   = dia::analyzeStructLayouts(dataSource, dia::StructLayoutReportOptions{dia::DEFAULT_CACHE_LINE_SIZE, 1});
+        const auto parallelLayouts = dia::analyzeStructLayouts(dataSource, dia::StructLayoutReportOptions{dia::DEFAULT_CACHE_LINE_SIZE, 2});
+        Assert::IsFalse(serialLayouts.empty());
+        Assert::AreEqual(serialLayouts.size(), parallelLayouts.size());
+        for (size_t i = 0; i < serialLayouts.size(); ++i)
+        {
+            Assert::AreEqual(serialLayouts[i].name, parallelLayouts[i].name);
+            // Workers analyze the UDTs in their own sessions, but the layouts carry the symIndexIds of the given data source.
+            Assert::AreEqual(serialLayouts[i].symIndexId, parallelLayouts[i].symIndexId);
+            Assert::IsTrue(serialLayouts[i].getPaddingSize() == parallelLayouts[i].getPaddingSize());
+            Assert::IsTrue(serialLayouts[i].minimumSize <= serialLayouts[i].size);
+        }
+    }
+};
+
+TEST_CLASS(FieldPath)
+{
+public:
+    TEST_METHOD(ResolveMembersIndicesAndAnonymousUnions)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        const auto ldrEntry = dataSource.getStruct("_LDR_DATA_TABLE_ENTRY");
+        const auto blink    = dia::resolveFieldPath(ldrEntry, L"InLoadOrderLinks.Blink");
+        Assert::IsTrue(sizeof(void*) == blink.offset);
+        Assert::IsTrue(sizeof(void*) == blink.size);
+        Assert::IsFalse(blink.isBitfield);
+
+        // PackagedBinary is a bitfield of a struct within an anonymous union, which it shares with Flags.
+        const auto packagedBinary = dia::resolveFieldPath(ldrEntry, L"PackagedBinary");
+        Assert::IsTrue(packagedBinary.isBitfield);
+        Assert::IsTrue(1 == packagedBinary.bitLength);
+        Assert::IsTrue(dia::resolveFieldPath(ldrEntry, L"Flags").offset == packagedBinary.offset);
+
+        const auto sharedData        = dataSource.getStruct("_KUSER_SHARED_DATA");
+        const auto processorFeatures = dia::resolveFieldPath(sharedData, L"ProcessorFeatures");
+        Assert::IsTrue(processorFeatures.offset + 3 == dia::resolveFieldPath(sharedData, L"ProcessorFeatures[3]").offset);
+        Assert::ExpectException<dia::InvalidUsageException>([&]() { dia::resolveFieldPath(sharedData, L"ProcessorFeatures[0x1000]"); });
+        Assert::ExpectException<dia::SymbolNotFoundException>([&]() { dia::resolveFieldPath(sharedData, L"NoSuchMember"); });
+
+        // Resolving the same path again through the data source hits its cache.
+        const auto& cachedBlink = dataSource.resolveFieldPath(ldrEntry, L"InLoadOrderLinks.Blink");
+        Assert::IsTrue(&cachedBlink == &dataSource.resolveFieldPath(ldrEntry, L"InLoadOrderLinks.Blink"));
+        Assert::IsTrue(blink.offset == cachedBlink.offset);
+    }
+};
+
+TEST_CLASS(DecodePlan)
+{
+public:
+    TEST_METHOD(DecodeListEntry)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        const auto listEntry = dataSource.getStruct("_LIST_ENTRY");
+        const auto& plan     = dataSource.getDecodePlan(listEntry);
+        Assert::IsTrue(&plan == &dataSource.getDecodePlan(listEntry));
+        Assert::IsTrue(sizeof(LIST_ENTRY) == plan.size);
+        Assert::AreEqual(size_t{2}, plan.ops.size());
+
+        LIST_ENTRY entry{reinterpret_cast<LIST_ENTRY*>(0x1000), reinterpret_cast<LIST_ENTRY*>(0x2000)};
+        const auto entryBytes = reinterpret_cast<const uint8_t*>(&entry);
+        const auto blinkName  = dataSource.getInternedString(plan.ops[1].nameId);
+        Assert::AreEqual(std::string("Blink"), std::string(blinkName.data, blinkName.size));
+        Assert::IsTrue(dia::DecodeKind::Unsigned == plan.ops[1].kind);
+        Assert::IsTrue(0x2000 == dia::readUnsigned(plan.ops[1], entryBytes + plan.ops[1].offset));
+    }
+
+    TEST_METHOD(ExtractBitfieldsOfContiguousInstances)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        const auto peb           = dataSource.getStruct("_PEB");
+        const auto pebSize       = static_cast<size_t>(peb.getLength());
+        const auto& bitFieldPath = dataSource.resolveFieldPath(peb, L"BitField");
+        std::vector<uint8_t> instances(pebSize * 4);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            instances[i * pebSize + static_cast<size_t>(bitFieldPath.offset)] = static_cast<uint8_t>(i);
+        }
+
+        const auto op = dia::makeIntegerDecodeOp(dataSource.resolveFieldPath(peb, L"IsProtectedProcess"));
+        Assert::IsTrue(op.isBitfield());
+        std::vector<ULONGLONG> values(4);
+        dia::extractIntegers(op, instances.data(), values.size(), pebSize, values.data());
+        Assert::IsTrue(std::vector<ULONGLONG>{0, 0, 1, 1} == values);
+
+        dia::extractIntegers(dia::makeIntegerDecodeOp(bitFieldPath), instances.data(), values.size(), pebSize, values.data());
+        Assert::IsTrue(std::vector<ULONGLONG>{0, 1, 2, 3} == values);
+    }
+};
+
+TEST_CLASS(Minidump)
+{
+public:
+    TEST_METHOD(ViewAndFollowListEntries)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        // Two LIST_ENTRYs pointing at each other, in the single range of a memory64 list.
+        const ULONG64 memoryAddress = 0x10000;
+        const ULONG64 memory[]      = {0x10010, 0x10010, 0x10000, 0x10000};
+        MINIDUMP_HEADER header{MINIDUMP_SIGNATURE, MINIDUMP_VERSION, 1, sizeof(MINIDUMP_HEADER)};
+        MINIDUMP_DIRECTORY directory{Memory64ListStream, {sizeof(ULONG64) * 2 + sizeof(MINIDUMP_MEMORY_DESCRIPTOR64)}};
+        directory.Location.Rva = sizeof(header) + sizeof(directory);
+        const ULONG64 memory64List[] = {1, directory.Location.Rva + directory.Location.DataSize, memoryAddress, sizeof(memory)};
+
+        const auto dumpFilePath = std::filesystem::temp_directory_path() / L"DiaLibListEntries.dmp";
+        {
+            std::ofstream dumpFile{dumpFilePath, std::ios::binary};
+            dumpFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            dumpFile.write(reinterpret_cast<const char*>(&directory), sizeof(directory));
+            dumpFile.write(reinterpret_cast<const char*>(memory64List), sizeof(memory64List));
+            dumpFile.write(reinterpret_cast<const char*>(memory), sizeof(memory));
+        }
+
+        {
+            dia::MinidumpReader reader{dumpFilePath.wstring()};
+            Assert::AreEqual(size_t{1}, reader.getMemoryRanges().size());
+
+            const auto listEntry = dataSource.getStruct("_LIST_ENTRY");
+            const auto view      = reader.getView(listEntry, memoryAddress + 0x10);
+            Assert::IsFalse(view.empty());
+            Assert::AreEqual(0, memcmp(view.data, &memory[2], sizeof(LIST_ENTRY)));
+            Assert::IsTrue(reader.getView(memoryAddress + 0x18, 0x10).empty());
+
+            Assert::IsTrue(0x10010 == reader.followPointer(dataSource, listEntry, memoryAddress, L"Flink"));
+            Assert::IsTrue(0x10000 == reader.readPointer(memoryAddress + 0x18));
+            Assert::ExpectException<dia::MemoryNotInDumpException>([&]() { reader.readPointer(memoryAddress + 0x20); });
+            Assert::AreEqual(size_t{1}, reader.getCachedPageCount());
+        }
+        std::filesystem::remove(dumpFilePath);
+    }
+};
+
+TEST_CLASS(LinkWalker)
+{
+public:
+    TEST_METHOD(WalkListsWithCycleDetection)
+    {
+        const std::wstring pdbFilePath = std::filesystem::absolute(LOCAL_NTDLL_PDB_FILE_PATH);
+        dia::DataSource dataSource{pdbFilePath};
+
+        // A list head followed by two _LDR_DATA_TABLE_ENTRYs, linked by their InMemoryOrderLinks, in a buffer standing for the target memory.
+        const ULONGLONG base = 0x10000;
+        std::vector<uint8_t> memory(0x1000);
+        const auto readMemory = [&](ULONGLONG address, void* buffer, size_t size) -> size_t
+        {
+            if (address < base || address + size > base + memory.size())
+            {
+                return 0;
+            }
+            memcpy(buffer, memory.data() + (address - base), size);
+            return size;
+        };
+        const auto link = [&](ULONGLONG address, ULONGLONG flink) { memcpy(memory.data() + (address - base), &flink, sizeof(flink)); };
+
+        const auto ldrEntry = dataSource.getStruct("_LDR_DATA_TABLE_ENTRY");
+        dia::LinkWalker walker{dataSource, ldrEntry, L"InMemoryOrderLinks", readMemory};
+        const auto linkOffset = walker.getLinkOffset();
+        const ULONGLONG head = base, first = base + 0x100, second = base + 0x400;
+        link(head, first + linkOffset);
+        link(first + linkOffset, second + linkOffset);
+        link(second + linkOffset, head);
+
+        std::vector<ULONGLONG> containers{};
+        const auto collect = [&](const ULONGLONG* containerAddresses, size_t count)
+        {
+            containers.insert(containers.end(), containerAddresses, containerAddresses + count);
+            return true;
+        };
+        dia::LinkWalkOptions options{};
+        options.batchSize = 1;
+        Assert::IsTrue(dia::LinkWalkStatus::Completed == walker.walkList(head, options, collect));
+        Assert::IsTrue(std::vector<ULONGLONG>{first, second} == containers);
+
+        link(second + linkOffset, first + linkOffset);
+        containers.clear();
+        Assert::IsTrue(dia::LinkWalkStatus::CycleDetected == walker.walkList(head, options, collect));
+        Assert::IsTrue(std::vector<ULONGLONG>{first, second} == containers);
+    }
+};
 }  // namespace Udt
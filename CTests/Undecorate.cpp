@@ -0,0 +1,62 @@
+#include "pch.h"
+// pch.h MUST be before CppUnitTest.h
+#include "Common.h"
+#include "CppUnitTest.h"
+
+#include "DiaUndecorate.h"
+#include <string>
+#include <vector>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace Undecorate
+{
+TEST_CLASS(Undecorate)
+{
+public:
+    TEST_METHOD(UndecorateLikeUndname)
+    {
+        const std::string get = "?get@Foo@@QEBAHXZ";
+        Assert::AreEqual(std::string{"public: int __cdecl Foo::get(void)const __ptr64"}, dia::undecorateName(get));
+        Assert::AreEqual(std::string{"Foo::get"}, dia::undecorateName(get, dia::UNDECORATE_NAME_ONLY));
+        Assert::AreEqual(std::string{"public: int Foo::get(void)const"}, dia::undecorateName(get, dia::UNDECORATE_NO_MS_KEYWORDS));
+        Assert::AreEqual(std::string{"public: void __cdecl std::vector<int,class std::allocator<int> >::clear(void) __ptr64"},
+                         dia::undecorateName("?clear@?$vector@HV?$allocator@H@std@@@std@@QEAAXXZ"));
+        Assert::AreEqual(std::string{"void __cdecl f(int (__cdecl*)(int),class Foo,class Foo)"}, dia::undecorateName("?f@@YAXP6AHH@ZVFoo@@1@Z"));
+        Assert::AreEqual(std::string{"char const * __ptr64 const x"}, dia::undecorateName("?x@@3QEBDEB"));
+        Assert::AreEqual(std::string{"const Foo::`vftable'"}, dia::undecorateName("??_7Foo@@6B@"));
+        Assert::AreEqual(std::string{"class Foo"}, dia::undecorateName(".?AVFoo@@", dia::UNDECORATE_TYPE_ONLY));
+        Assert::AreEqual(std::wstring{L"int x"}, dia::undecorateName(std::wstring{L"?x@@3HA"}));
+
+        // Names which are not decorated, or not validly, are left as they are.
+        Assert::AreEqual(std::string{"RtlAllocateHeap"}, dia::undecorateName("RtlAllocateHeap"));
+        Assert::AreEqual(std::string{"?f@@YAX"}, dia::undecorateName("?f@@YAX"));
+
+        // Names nesting too deeply are left as they are too, instead of overflowing the stack.
+        std::string deepPointer  = "?a@@3";
+        std::string deepTemplate = "?a@@3V";
+        for (size_t i = 0; i < 5000; ++i)
+        {
+            deepPointer += "PEA";
+            deepTemplate += "?$A@V";
+        }
+        deepPointer += "HA";
+        deepTemplate += "B@@" + std::string(2 * 5000, '@') + "A";
+        Assert::AreEqual(deepPointer, dia::undecorateName(deepPointer));
+        Assert::AreEqual(deepTemplate, dia::undecorateName(deepTemplate));
+    }
+
+    TEST_METHOD(UndecorateManyInParallel)
+    {
+        std::vector<std::string> names{};
+        for (size_t i = 0; i < 0x3000; ++i)
+        {
+            names.push_back((0 == i % 2) ? "??0Foo@@QEAA@XZ" : "_memcpy");
+        }
+        const auto undecoratedNames = dia::undecorateNames(names, dia::UNDECORATE_COMPLETE, 4);
+        Assert::IsTrue(undecoratedNames == dia::undecorateNames(names, dia::UNDECORATE_COMPLETE, 1));
+        Assert::AreEqual(std::string{"public: __cdecl Foo::Foo(void) __ptr64"}, undecoratedNames[0x2000]);
+        Assert::AreEqual(std::string{"_memcpy"}, undecoratedNames[0x2001]);
+    }
+};
+}  // namespace Undecorate
@@ -1,6 +1,7 @@
 #include "pch.h"
 //
 #include "DiaHashing.h"
+#include "DiaStructuralHash.h"
 
 
 #define GET_ATTRIBUTE_OR_DEFAULT(_symbol, attribute)                                                                                                 \
@@ -18,7 +19,7 @@
         })(_symbol)
 
 #define GET_CLASS_PARENT_OR_EMPTY(_symbol) GET_ATTRIBUTE_OR_DEFAULT(_symbol, getClassParent)
-#define GET_CLASS_PARENT_ID_OR_ZERO(_symbol) GET_ATTRIBUTE_OR_DEFAULT(_symbol, getClassParentId)
+#define GET_LEXICAL_PARENT_OR_EMPTY(_symbol) GET_ATTRIBUTE_OR_DEFAULT(_symbol, getLexicalParent)
 #define GET_TOKEN_OR_ZERO(_symbol) GET_ATTRIBUTE_OR_DEFAULT(_symbol, getToken)
 #define GET_SLOT_OR_ZERO(_symbol) GET_ATTRIBUTE_OR_DEFAULT(_symbol, getSlot)
 #define GET_LENGTH_OR_ZERO(_symbol) GET_ATTRIBUTE_OR_DEFAULT(_symbol, getLength)
@@ -34,6 +35,240 @@
 #define GET_ACCESS_OR_NONE(_symbol) GET_ATTRIBUTE_OR_DEFAULT(_symbol, getAccess)
 #define GET_VALUE_OR_NONE(_symbol) GET_ATTRIBUTE_OR_DEFAULT(_symbol, getValue)
 
+// Most symbol types are only forward declared, so their properties are queried through the functions of DiaSymbolFuncs.h.
+#define AS_SYMBOL(_v) (*reinterpret_cast<const dia::Symbol*>(&(_v)))
+#define GET_OR_DEFAULT(_symbol, getter) dia::getOrDefault(dia::getter, _symbol)
+
+namespace
+{
+size_t hashDataBytes(const dia::DataBytes& dataBytes)
+{
+    dia::StableHasher hasher{};
+    hasher.add(dataBytes.size()).update(dataBytes.data(), dataBytes.size());
+    return static_cast<size_t>(hasher.digest64());
+}
+}  // namespace
+
+namespace dia
+{
+namespace
+{
+/// @brief Hash a symbol referenced by another one (e.g. its type or its parent) with the structural hasher of the session, so the hashes of the
+/// referenced types are memoized instead of recalculated for every symbol referring to them.
+/// Parents must be hashed this way rather than by their symIndexId, which each session assigns in the order symbols are looked up.
+size_t hashReferencedSymbol(const Symbol& symbol, StructuralHasher& structuralHasher) { return !symbol ? 0 : structuralHasher.hash(symbol); }
+
+}  // namespace
+
+size_t calcTypedSymbolHash(const Udt& v, StructuralHasher& structuralHasher) { return calcUdtHash(v, structuralHasher); }
+
+size_t calcTypedSymbolHash(const Enum& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getBaseType(),
+                 hashReferencedSymbol(GET_CLASS_PARENT_OR_EMPTY(v), structuralHasher), v.getConstructor(), v.getConstType(),
+                 v.getHasAssignmentOperator(), v.getHasCastOperator(), v.getHasNestedTypes(), v.getLength(), v.getName(), v.getNested(),
+                 v.getOverloadedOperator(), v.getPacked(), v.getScoped(), v.getUnalignedType(), v.getVolatileType());
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const Array& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), hashReferencedSymbol(v.getArrayIndexType(), structuralHasher),
+                 v.getConstType(), v.getCount(), v.getLength() /* Length should be well defined for arrays */,
+                 hashReferencedSymbol(GET_LEXICAL_PARENT_OR_EMPTY(v), structuralHasher), GET_RANK_OR_ZERO(v),
+                 hashReferencedSymbol(v.getType(), structuralHasher), v.getUnalignedType(), v.getVolatileType());
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const Pointer& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getConstType(), v.getLength(),
+                 hashReferencedSymbol(GET_LEXICAL_PARENT_OR_EMPTY(v), structuralHasher), v.getReference(),
+                 hashReferencedSymbol(v.getType(), structuralHasher), v.getUnalignedType(), v.getVolatileType());
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const BaseType& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getBaseType(), v.getConstType(), v.getLength(),
+                 hashReferencedSymbol(GET_LEXICAL_PARENT_OR_EMPTY(v), structuralHasher), v.getUnalignedType(), v.getVolatileType());
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const FunctionArgType& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), hashReferencedSymbol(v.getType(), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const Typedef& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getBaseType(), v.getConstructor(), v.getConstType(),
+                 v.getHasAssignmentOperator(), v.getHasCastOperator(), v.getHasNestedTypes(), v.getLength(),
+                 hashReferencedSymbol(GET_LEXICAL_PARENT_OR_EMPTY(v), structuralHasher), v.getName(), v.getNested(), v.getOverloadedOperator(),
+                 v.getPacked(), v.getReference(), v.getScoped(), hashReferencedSymbol(v.getType(), structuralHasher), v.getUdtKind(),
+                 v.getUnalignedType(), v.getVirtualTableShape(), v.getVolatileType());
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const Data& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), GET_ACCESS_OR_NONE(v), GET_BIT_POSITION_OR_ZERO(v),
+                 hashReferencedSymbol(GET_CLASS_PARENT_OR_EMPTY(v), structuralHasher), GET_COMPILER_GENERATED_OR_FALSE(v), v.getConstType(),
+                 v.getDataKind(), GET_AGGREGATED_OR_FALSE(v), GET_SPLITTED_OR_FALSE(v), GET_LENGTH_OR_ZERO(v), v.getLocationType(), v.getName(),
+                 GET_OFFSET_OR_ZERO(v), GET_SLOT_OR_ZERO(v), v.getSymTag(), GET_TOKEN_OR_ZERO(v), hashReferencedSymbol(v.getType(), structuralHasher),
+                 v.getUnalignedType(), v.getVolatileType(), GET_VALUE_OR_NONE(v));
+
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const Function& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getAccess(), v.getAddressSection(),
+                 hashReferencedSymbol(v.getClassParent(), structuralHasher), v.getConstType(), v.getCustomCallingConvention(), v.getFarReturn(),
+                 v.getHasAlloca(), v.getHasEH(), v.getHasEHa(), v.getHasInlAsm(), v.getHasLongJump(), v.getHasSecurityChecks(), v.getHasSEH(),
+                 v.getHasSetJump(), v.getInlSpec(), v.getInterruptReturn(), v.getIntro(), v.getIsNaked(), v.getIsStatic(), v.getLength(),
+                 v.getLocationType(), v.getName(), v.getNoInline(), v.getNoReturn(), v.getNoStackOrdering(), v.getNotReached(),
+                 v.getOptimizedCodeDebugInfo(), v.getPure(), GET_TOKEN_OR_ZERO(v), hashReferencedSymbol(v.getType(), structuralHasher),
+                 v.getUnalignedType(), v.getUndecoratedName(), v.getVirtual(), v.getVirtualAddress(), v.getVolatileType());
+
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const FunctionType& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getCallingConvention(), v.getConstType(), v.getCount(),
+                 hashReferencedSymbol(GET_OBJECT_POINTER_TYPE_OR_EMPTY(v), structuralHasher), GET_THIS_ADJUST_OR_ZERO(v), v.getUnalignedType(),
+                 v.getVolatileType());
+    for (const auto& param : v)
+    {
+        hash_combine(calculatedHash, calcTypedSymbolHash(param, structuralHasher));
+    }
+
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const BaseClass& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagBaseClass)), GET_OR_DEFAULT(symbol, getAccess),
+                 GET_OR_DEFAULT(symbol, getConstType), GET_OR_DEFAULT(symbol, getIndirectVirtualBaseClass), GET_OR_DEFAULT(symbol, getLength),
+                 GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getOffset), GET_OR_DEFAULT(symbol, getPacked),
+                 GET_OR_DEFAULT(symbol, getUdtKind), GET_OR_DEFAULT(symbol, getUnalignedType), GET_OR_DEFAULT(symbol, getVirtualBaseClass),
+                 GET_OR_DEFAULT(symbol, getVirtualBaseDispIndex), GET_OR_DEFAULT(symbol, getVirtualBasePointerOffset),
+                 GET_OR_DEFAULT(symbol, getVolatileType), hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const BaseInterface& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagBaseInterface)), GET_OR_DEFAULT(symbol, getAccess),
+                 GET_OR_DEFAULT(symbol, getLength), GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getOffset),
+                 GET_OR_DEFAULT(symbol, getUdtKind), GET_OR_DEFAULT(symbol, getVirtualBaseClass),
+                 hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const CallSite& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagCallSite)), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getRelativeVirtualAddress),
+                 hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const Friend& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagFriend)), GET_OR_DEFAULT(symbol, getName),
+                 hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const HeapAllocationSite& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagHeapAllocationSite)), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getLength), GET_OR_DEFAULT(symbol, getRelativeVirtualAddress),
+                 hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const HLSLType& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagHLSLType)), GET_OR_DEFAULT(symbol, getBuiltInKind),
+                 GET_OR_DEFAULT(symbol, getLength), GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getNumberOfColumns),
+                 GET_OR_DEFAULT(symbol, getNumberOfRows), hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const Inlinee& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagInlinee)), GET_OR_DEFAULT(symbol, getName),
+                 hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const InlineSite& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagInlineSite)), GET_OR_DEFAULT(symbol, getName),
+                 GET_OR_DEFAULT(symbol, getUndecoratedName), hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const MatrixType& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagMatrixType)), GET_OR_DEFAULT(symbol, getIsMatrixRowMajor),
+                 GET_OR_DEFAULT(symbol, getLength), GET_OR_DEFAULT(symbol, getNumberOfColumns), GET_OR_DEFAULT(symbol, getNumberOfRows),
+                 hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const TaggedUnionCase& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagTaggedUnionCase)), GET_OR_DEFAULT(symbol, getName),
+                 GET_OR_DEFAULT(symbol, getOffset), GET_OR_DEFAULT(symbol, getValue),
+                 hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+
+size_t calcTypedSymbolHash(const VectorType& v, StructuralHasher& structuralHasher)
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagVectorType)), GET_OR_DEFAULT(symbol, getConstType),
+                 GET_OR_DEFAULT(symbol, getCount), GET_OR_DEFAULT(symbol, getLength), GET_OR_DEFAULT(symbol, getUnalignedType),
+                 GET_OR_DEFAULT(symbol, getVolatileType), hashReferencedSymbol(GET_OR_DEFAULT(symbol, getType), structuralHasher));
+    return calculatedHash;
+}
+}  // namespace dia
+
 namespace std
 {
 
@@ -89,140 +324,169 @@ size_t hash<VARIANT>::operator()(const VARIANT& v) const
     return calculatedHash;
 }
 
-size_t hash<dia::Enum>::operator()(const dia::Enum& v) const
+
+size_t hash<dia::Annotation>::operator()(const dia::Annotation& v) const
 {
     size_t calculatedHash = 0;
-    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getBaseType(), GET_CLASS_PARENT_ID_OR_ZERO(v), v.getConstructor(),
-                 v.getConstType(), v.getHasAssignmentOperator(), v.getHasCastOperator(), v.getHasNestedTypes(), v.getLength(), v.getName(),
-                 v.getNested(), v.getOverloadedOperator(), v.getPacked(), v.getScoped(), v.getUnalignedType(), v.getVolatileType());
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getAddressOffset(), v.getAddressSection(), v.getDataKind(),
+                 v.getRelativeVirtualAddress(), v.getValue(), v.getVirtualAddress());
     return calculatedHash;
 }
 
-size_t hash<dia::Udt>::operator()(const dia::Udt& v) const
+size_t hash<dia::Callee>::operator()(const dia::Callee& v) const
 {
+    const auto& symbol    = AS_SYMBOL(v);
     size_t calculatedHash = 0;
-    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), GET_CLASS_PARENT_ID_OR_ZERO(v), v.getConstructor(), v.getConstType(),
-                 v.getHasAssignmentOperator(), v.getHasCastOperator(), v.getHasNestedTypes(), GET_LENGTH_OR_ZERO(v), v.getName(), v.getNested(),
-                 v.getOverloadedOperator(), v.getPacked(), v.getScoped(), v.getUdtKind(), v.getUnalignedType(), GET_VTABLE_SHARE_OR_EMPTY(v),
-                 v.getVolatileType());
-
-#if 0
-        // This causes infinite recursion
-        const dia::Symbol& s = *reinterpret_cast<const dia::Symbol*>(&v);
-        for (const auto& member : dia::enumerate<dia::Data>(s, SymTagData))
-        {
-            hash_combine(calculatedHash, member.calcHash());
-        }
-#endif
-
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagCallee)), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getRelativeVirtualAddress),
+                 GET_OR_DEFAULT(symbol, getUndecoratedName));
     return calculatedHash;
 }
 
-size_t hash<dia::Data>::operator()(const dia::Data& v) const
+size_t hash<dia::Caller>::operator()(const dia::Caller& v) const
 {
+    const auto& symbol    = AS_SYMBOL(v);
     size_t calculatedHash = 0;
-    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), GET_ACCESS_OR_NONE(v), GET_BIT_POSITION_OR_ZERO(v),
-                 GET_CLASS_PARENT_OR_EMPTY(v), GET_COMPILER_GENERATED_OR_FALSE(v), v.getConstType(), v.getDataKind(), GET_AGGREGATED_OR_FALSE(v),
-                 GET_SPLITTED_OR_FALSE(v), GET_LENGTH_OR_ZERO(v), v.getLocationType(), v.getName(), GET_OFFSET_OR_ZERO(v), GET_SLOT_OR_ZERO(v),
-                 v.getSymTag(), GET_TOKEN_OR_ZERO(v), v.getType(), v.getUnalignedType(), v.getVolatileType(), GET_VALUE_OR_NONE(v));
-
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagCaller)), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getRelativeVirtualAddress),
+                 GET_OR_DEFAULT(symbol, getUndecoratedName));
     return calculatedHash;
 }
 
-size_t hash<dia::Function>::operator()(const dia::Function& v) const
+size_t hash<dia::CoffGroup>::operator()(const dia::CoffGroup& v) const
 {
+    const auto& symbol    = AS_SYMBOL(v);
     size_t calculatedHash = 0;
-    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getAccess(), v.getAddressSection(), v.getClassParent(),
-                 v.getConstType(), v.getCustomCallingConvention(), v.getFarReturn(), v.getHasAlloca(), v.getHasEH(), v.getHasEHa(), v.getHasInlAsm(),
-                 v.getHasLongJump(), v.getHasSecurityChecks(), v.getHasSEH(), v.getHasSetJump(), v.getInlSpec(), v.getInterruptReturn(), v.getIntro(),
-                 v.getIsNaked(), v.getIsStatic(), v.getLength(), v.getLocationType(), v.getName(), v.getNoInline(), v.getNoReturn(),
-                 v.getNoStackOrdering(), v.getNotReached(), v.getOptimizedCodeDebugInfo(), v.getPure(), GET_TOKEN_OR_ZERO(v), v.getType(),
-                 v.getUnalignedType(), v.getUndecoratedName(), v.getVirtual(), v.getVirtualAddress(), v.getVolatileType());
-
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagCoffGroup)), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getCharacteristics), GET_OR_DEFAULT(symbol, getLength),
+                 GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getRelativeVirtualAddress));
     return calculatedHash;
 }
 
-size_t hash<dia::FunctionType>::operator()(const dia::FunctionType& v) const
+size_t hash<dia::CompilandDetails>::operator()(const dia::CompilandDetails& v) const
 {
+    const auto& symbol    = AS_SYMBOL(v);
     size_t calculatedHash = 0;
-    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getCallingConvention(), v.getConstType(), v.getCount(),
-                 GET_OBJECT_POINTER_TYPE_OR_EMPTY(v), GET_THIS_ADJUST_OR_ZERO(v), v.getUnalignedType(), v.getVolatileType());
-    for (const auto& param : v)
-    {
-        hash_combine(calculatedHash, hash<dia::FunctionArgType>()(param));
-    }
-
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagCompilandDetails)), GET_OR_DEFAULT(symbol, getBackEndBuild),
+                 GET_OR_DEFAULT(symbol, getBackEndMajor), GET_OR_DEFAULT(symbol, getBackEndMinor), GET_OR_DEFAULT(symbol, getBackEndQFE),
+                 GET_OR_DEFAULT(symbol, getCompilerName), GET_OR_DEFAULT(symbol, getEditAndContinueEnabled), GET_OR_DEFAULT(symbol, getFrontEndBuild),
+                 GET_OR_DEFAULT(symbol, getFrontEndMajor), GET_OR_DEFAULT(symbol, getFrontEndMinor), GET_OR_DEFAULT(symbol, getFrontEndQFE),
+                 GET_OR_DEFAULT(symbol, getHasDebugInfo), GET_OR_DEFAULT(symbol, getHasManagedCode), GET_OR_DEFAULT(symbol, getHasSecurityChecks),
+                 GET_OR_DEFAULT(symbol, getIsCVTCIL), GET_OR_DEFAULT(symbol, getIsDataAligned), GET_OR_DEFAULT(symbol, getIsHotpatchable),
+                 GET_OR_DEFAULT(symbol, getIsLTCG), GET_OR_DEFAULT(symbol, getIsMSILNetmodule), GET_OR_DEFAULT(symbol, getLanguage),
+                 GET_OR_DEFAULT(symbol, getPlatform));
     return calculatedHash;
 }
 
-size_t hash<dia::Array>::operator()(const dia::Array& v) const
+size_t hash<dia::CompilandEnv>::operator()(const dia::CompilandEnv& v) const
 {
+    const auto& symbol    = AS_SYMBOL(v);
     size_t calculatedHash = 0;
-    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getArrayIndexType(), v.getConstType(), v.getCount(),
-                 v.getLength() /* Length should be well defined for arrays */, v.getLexicalParentId(), GET_RANK_OR_ZERO(v), v.getUnalignedType(),
-                 v.getVolatileType());
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagCompilandEnv)), GET_OR_DEFAULT(symbol, getName),
+                 GET_OR_DEFAULT(symbol, getValue));
     return calculatedHash;
 }
 
-size_t hash<dia::Annotation>::operator()(const dia::Annotation& v) const
+size_t hash<dia::Custom>::operator()(const dia::Custom& v) const
 {
+    const auto& symbol    = AS_SYMBOL(v);
     size_t calculatedHash = 0;
-    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getAddressOffset(), v.getAddressSection(), v.getDataKind(),
-                 v.getRelativeVirtualAddress(), v.getValue(), v.getVirtualAddress());
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagCustom)), hashDataBytes(GET_OR_DEFAULT(symbol, getDataBytes)));
     return calculatedHash;
 }
 
-size_t hash<dia::BaseClass>::operator()(const dia::BaseClass& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::BaseInterface>::operator()(const dia::BaseInterface& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Callee>::operator()(const dia::Callee& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Caller>::operator()(const dia::Caller& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::CallSite>::operator()(const dia::CallSite& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::CoffGroup>::operator()(const dia::CoffGroup& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Compiland>::operator()(const dia::Compiland& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::CompilandDetails>::operator()(const dia::CompilandDetails& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::CompilandEnv>::operator()(const dia::CompilandEnv& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Custom>::operator()(const dia::Custom& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::CustomType>::operator()(const dia::CustomType& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Dimension>::operator()(const dia::Dimension& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Export>::operator()(const dia::Export& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Friend>::operator()(const dia::Friend& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::HeapAllocationSite>::operator()(const dia::HeapAllocationSite& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::HLSLType>::operator()(const dia::HLSLType& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Inlinee>::operator()(const dia::Inlinee& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::InlineSite>::operator()(const dia::InlineSite& v) const { throw std::runtime_error("Not implemented!"); }
-
-size_t hash<dia::Label>::operator()(const dia::Label& v) const { throw std::runtime_error("Not implemented!"); }
+size_t hash<dia::CustomType>::operator()(const dia::CustomType& v) const
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagCustomType)), GET_OR_DEFAULT(symbol, getLength),
+                 GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getOemId), GET_OR_DEFAULT(symbol, getOemSymbolId),
+                 hashDataBytes(GET_OR_DEFAULT(symbol, getDataBytes)));
+    return calculatedHash;
+}
 
-size_t hash<dia::ManagedType>::operator()(const dia::ManagedType& v) const { throw std::runtime_error("Not implemented!"); }
+size_t hash<dia::Dimension>::operator()(const dia::Dimension& v) const
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagDimension)), GET_OR_DEFAULT(symbol, getLowerBound),
+                 GET_OR_DEFAULT(symbol, getUpperBound));
+    return calculatedHash;
+}
 
-size_t hash<dia::MatrixType>::operator()(const dia::MatrixType& v) const { throw std::runtime_error("Not implemented!"); }
+size_t hash<dia::Export>::operator()(const dia::Export& v) const
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagExport)), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getConstantExport), GET_OR_DEFAULT(symbol, getDataExport),
+                 GET_OR_DEFAULT(symbol, getExportHasExplicitlyAssignedOrdinal), GET_OR_DEFAULT(symbol, getExportIsForwarder),
+                 GET_OR_DEFAULT(symbol, getFunction), GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getNoNameExport),
+                 GET_OR_DEFAULT(symbol, getOrdinal), GET_OR_DEFAULT(symbol, getPrivateExport), GET_OR_DEFAULT(symbol, getRelativeVirtualAddress),
+                 GET_OR_DEFAULT(symbol, getUndecoratedName));
+    return calculatedHash;
+}
 
-size_t hash<dia::PublicSymbol>::operator()(const dia::PublicSymbol& v) const { throw std::runtime_error("Not implemented!"); }
+size_t hash<dia::Label>::operator()(const dia::Label& v) const
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagLabel)), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getLocationType), GET_OR_DEFAULT(symbol, getName),
+                 GET_OR_DEFAULT(symbol, getRelativeVirtualAddress));
+    return calculatedHash;
+}
 
-size_t hash<dia::TaggedUnionCase>::operator()(const dia::TaggedUnionCase& v) const { throw std::runtime_error("Not implemented!"); }
+size_t hash<dia::ManagedType>::operator()(const dia::ManagedType& v) const
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagManagedType)), GET_OR_DEFAULT(symbol, getLength),
+                 GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getToken));
+    return calculatedHash;
+}
 
-size_t hash<dia::Thunk>::operator()(const dia::Thunk& v) const { throw std::runtime_error("Not implemented!"); }
+size_t hash<dia::Thunk>::operator()(const dia::Thunk& v) const
+{
+    const auto& symbol    = AS_SYMBOL(v);
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagThunk)), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getLength), GET_OR_DEFAULT(symbol, getLocationType),
+                 GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getRelativeVirtualAddress), GET_OR_DEFAULT(symbol, getTargetOffset),
+                 GET_OR_DEFAULT(symbol, getTargetRelativeVirtualAddress), GET_OR_DEFAULT(symbol, getTargetSection),
+                 GET_OR_DEFAULT(symbol, getThunkOrdinal));
+    return calculatedHash;
+}
 
-size_t hash<dia::Typedef>::operator()(const dia::Typedef& v) const { throw std::runtime_error("Not implemented!"); }
+// Outside of a session's DataSource, each hash gets a hasher of its own.
+#define __DEFINE_HASH_WITH_STRUCTURAL_HASHER(T)                                                                                                      \
+    size_t hash<dia::T>::operator()(const dia::T& v) const                                                                                           \
+    {                                                                                                                                                \
+        dia::StructuralHasher structuralHasher{};                                                                                                    \
+        return dia::calcTypedSymbolHash(v, structuralHasher);                                                                                        \
+    }
 
-size_t hash<dia::VectorType>::operator()(const dia::VectorType& v) const { throw std::runtime_error("Not implemented!"); }
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Enum)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Udt)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Array)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Pointer)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(BaseType)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Data)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Function)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(FunctionType)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(FunctionArgType)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Typedef)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(BaseClass)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(BaseInterface)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(CallSite)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Friend)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(HeapAllocationSite)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(HLSLType)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(Inlinee)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(InlineSite)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(MatrixType)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(TaggedUnionCase)
+__DEFINE_HASH_WITH_STRUCTURAL_HASHER(VectorType)
 
 }  // namespace std
 
@@ -231,4 +495,29 @@ namespace dia
 size_t Data::calcHash() const { return std::hash<dia::Data>()(*this); }
 
 size_t Udt::calcHash() const { return std::hash<dia::Udt>()(*this); }
+
+size_t calcUdtHash(const Udt& v, StructuralHasher& structuralHasher)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), hashReferencedSymbol(GET_CLASS_PARENT_OR_EMPTY(v), structuralHasher),
+                 v.getConstructor(), v.getConstType(), v.getHasAssignmentOperator(), v.getHasCastOperator(), v.getHasNestedTypes(),
+                 GET_LENGTH_OR_ZERO(v), v.getName(), v.getNested(), v.getOverloadedOperator(), v.getPacked(), v.getScoped(), v.getUdtKind(),
+                 v.getUnalignedType(), GET_VTABLE_SHARE_OR_EMPTY(v), v.getVolatileType());
+
+    // Members, base classes and nested types are covered by the structural hash, which (unlike hashing each member's calcHash) does not
+    // recurse infinitely on self-referencing types.
+    hash_combine(calculatedHash, structuralHasher.hash(v));
+
+    return calculatedHash;
+}
+
+size_t calcUntypedSymbolHash(const Symbol& symbol)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, std::wstring(dia::symTagToName(getSymTag(symbol))), GET_OR_DEFAULT(symbol, getAddressOffset),
+                 GET_OR_DEFAULT(symbol, getAddressSection), GET_OR_DEFAULT(symbol, getCount), GET_OR_DEFAULT(symbol, getLength),
+                 GET_OR_DEFAULT(symbol, getLocationType), GET_OR_DEFAULT(symbol, getName), GET_OR_DEFAULT(symbol, getOffset),
+                 GET_OR_DEFAULT(symbol, getRelativeVirtualAddress));
+    return calculatedHash;
+}
 }  // namespace dia
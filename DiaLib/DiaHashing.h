@@ -1,16 +1,91 @@
 #pragma once
+#include "DiaStructuralHash.h"
 #include "Exceptions.h"
 #include "HashUtils.h"
 #include "SymbolTypes/DiaAnnotation.h"
 #include "SymbolTypes/DiaArray.h"
+#include "SymbolTypes/DiaBaseType.h"
+#include "SymbolTypes/DiaCompiland.h"
 #include "SymbolTypes/DiaData.h"
 #include "SymbolTypes/DiaEnum.h"
 #include "SymbolTypes/DiaFunction.h"
 #include "SymbolTypes/DiaFunctionArgType.h"
 #include "SymbolTypes/DiaFunctionType.h"
+#include "SymbolTypes/DiaNull.h"
+#include "SymbolTypes/DiaPointer.h"
+#include "SymbolTypes/DiaPublicSymbol.h"
 #include "SymbolTypes/DiaSymbolTypes.h"
+#include "SymbolTypes/DiaTypedef.h"
 #include "SymbolTypes/DiaUDT.h"
 
+namespace dia
+{
+/// @brief Query a property which may legitimately be unavailable for some symbols of a given tag.
+/// @param getter The DiaSymbolFuncs.h function of the property.
+/// @param symbol The symbol to query.
+/// @return The property, or a value-initialized default if it is unavailable.
+template <typename GetterT>
+auto getOrDefault(GetterT getter, const Symbol& symbol) -> std::remove_const_t<decltype(getter(symbol))>
+{
+    try
+    {
+        return getter(symbol);
+    }
+    catch (const InvalidUsageException&)
+    {
+        return {};
+    }
+}
+
+/// @brief Hash a UDT, as std::hash<dia::Udt> does, but with the structural hashes memoized by `structuralHasher`.
+/// @param structuralHasher The hasher of the session the UDT comes from (see `DataSource::calcHash`).
+/// @return Hash value of the UDT's content.
+size_t calcUdtHash(const Udt& v, StructuralHasher& structuralHasher);
+
+/// @brief Hash a symbol of a given type, as std::hash does, but with the types (and other symbols) it references hashed by `structuralHasher`,
+/// so that the hashes of types shared by many symbols are only calculated once per session.
+/// Types which reference no other symbol are hashed by std::hash itself.
+/// @param structuralHasher The hasher of the session the symbol comes from (see `DataSource::calcHash`).
+/// @return Hash value of the symbol's content.
+template <typename T>
+size_t calcTypedSymbolHash(const T& v, StructuralHasher& /*structuralHasher*/)
+{
+    return std::hash<T>()(v);
+}
+
+size_t calcTypedSymbolHash(const Enum& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const Udt& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const Array& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const Pointer& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const BaseType& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const Data& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const Function& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const FunctionType& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const FunctionArgType& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const Typedef& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const BaseClass& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const BaseInterface& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const CallSite& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const Friend& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const HeapAllocationSite& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const HLSLType& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const Inlinee& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const InlineSite& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const MatrixType& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const TaggedUnionCase& v, StructuralHasher& structuralHasher);
+size_t calcTypedSymbolHash(const VectorType& v, StructuralHasher& structuralHasher);
+
+/// @brief Hash any symbol, as `Symbol::calcHash` does, but with the symbols it references hashed by `structuralHasher`.
+/// @param structuralHasher The hasher of the session the symbol comes from (see `DataSource::calcHash`).
+/// @return Hash value of the symbol's content, or 0 for an uninitialized symbol.
+size_t calcSymbolHash(const Symbol& symbol, StructuralHasher& structuralHasher);
+
+/// @brief Hash a symbol whose tag has no dedicated symbol type (SymTagBlock, SymTagVTable, ...).
+/// @param symbol The symbol to hash.
+/// @return Hash value of the symbol's content.
+size_t calcUntypedSymbolHash(const Symbol& symbol);
+}  // namespace dia
+
 namespace std
 {
 
@@ -98,12 +173,6 @@ struct hash<dia::CoffGroup>
     size_t operator()(const dia::CoffGroup& v) const;
 };
 
-template <>
-struct hash<dia::Compiland>
-{
-    size_t operator()(const dia::Compiland& v) const;
-};
-
 template <>
 struct hash<dia::CompilandDetails>
 {
@@ -188,12 +257,6 @@ struct hash<dia::MatrixType>
     size_t operator()(const dia::MatrixType& v) const;
 };
 
-template <>
-struct hash<dia::PublicSymbol>
-{
-    size_t operator()(const dia::PublicSymbol& v) const;
-};
-
 template <>
 struct hash<dia::TaggedUnionCase>
 {
@@ -206,12 +269,6 @@ struct hash<dia::Thunk>
     size_t operator()(const dia::Thunk& v) const;
 };
 
-template <>
-struct hash<dia::Typedef>
-{
-    size_t operator()(const dia::Typedef& v) const;
-};
-
 template <>
 struct hash<dia::VectorType>
 {
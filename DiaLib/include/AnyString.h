@@ -1,13 +1,25 @@
 #pragma once
+#include <Windows.h>
 #include <stdexcept>
 #include <string>
 
 template <typename CharT>
 class AnyStringT;
 
+/// @brief Decode a UTF-8 string.
 static inline const std::wstring convertToWstring(const std::string& str)
 {
-    std::wstring wstr(str.begin(), str.end());
+    if (str.empty())
+    {
+        return {};
+    }
+    const auto length = MultiByteToWideChar(CP_UTF8, 0, str.data(), static_cast<int>(str.size()), nullptr, 0);
+    if (0 == length)
+    {
+        throw std::runtime_error("Failed to decode a UTF-8 string!");
+    }
+    std::wstring wstr(length, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, str.data(), static_cast<int>(str.size()), &wstr[0], length);
     return wstr;
 }
 
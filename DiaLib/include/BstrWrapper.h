@@ -1,4 +1,5 @@
 #pragma once
+#include "HashUtils.h"
 #include <atlbase.h>
 #include <dia2.h>
 #include <iostream>
@@ -60,9 +61,9 @@ struct hash<BstrWrapper>
 {
     size_t operator()(const BstrWrapper& str) const
     {
-        // Hashing BSTR should be identical to std::wstring since BSTR is an
-        // implementation consideration.
-        return hash<std::wstring>()(str);
+        // Hash the characters with the stable hasher, like any other string passed to dia::StableHasher::add.
+        // SysStringLen is used since it also accepts the null BSTR of an empty string.
+        return static_cast<size_t>(dia::StableHasher{}.add(str.c_str(), SysStringLen(str.get())).digest64());
     }
 };
 }  // namespace std
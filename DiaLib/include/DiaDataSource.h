@@ -1,7 +1,13 @@
 #pragma once
 #include "AnyString.h"
+#include "DiaDecodePlan.h"
+#include "DiaFieldPath.h"
+#include "DiaNamePool.h"
+#include "DiaStructuralHash.h"
 #include "DiaSymbol.h"
 #include "DiaSymbolEnumerator.h"
+#include "DiaSymbolLocator.h"
+#include "DiaTypeResolution.h"
 #include "DiaUserDefinedTypeWrapper.h"
 #include "SymbolTypes/DiaEnum.h"
 #include "SymbolTypes/DiaFunction.h"
@@ -37,9 +43,48 @@ public:
 
     const std::wstring getLoadedPdbFile() const;
 
+    /// @brief Resolves a symbol of this data source to its full type name (see `dia::resolveTypeName`).
+    /// The names are cached for the lifetime of the session, so each distinct type is only resolved once.
+    const std::wstring& resolveTypeName(const Symbol& symbol) const { return m_typeNameResolver.resolve(symbol); }
+
+    /// @brief Get the name of a symbol of this data source, encoded in UTF-8 (see `Utf8NamePool`).
+    /// Each symbol's name is queried once for the lifetime of the session, and symbols with the same name share it.
+    /// @throws PropertyNotAvailableException if the symbol has no name.
+    InternedString getUtf8Name(const Symbol& symbol) const { return m_utf8Names.getName(symbol); }
+
+    /// @brief Get the id of the name of a symbol of this data source. Symbols have the same name exactly when they have the same name id, and
+    /// the ids are dense, so they can index per-name data such as the Python strings of pydia.
+    /// @throws PropertyNotAvailableException if the symbol has no name.
+    StringId getNameId(const Symbol& symbol) const { return m_utf8Names.getNameId(symbol); }
+
+    InternedString getInternedString(StringId id) const { return m_utf8Names.getString(id); }
+
+    /// @brief Resolve a field path within a UDT of this data source (see `dia::resolveFieldPath`).
+    /// Resolved paths are cached by UDT and path for the lifetime of the session, so resolving a path again is a lookup.
+    const FieldPath& resolveFieldPath(const Symbol& udt, const std::wstring& path) const { return m_fieldPathResolver.resolve(udt, path); }
+
+    /// @brief Get the decode plan of a UDT of this data source (see `DecodePlanCompiler`), compiled once for the lifetime of the session.
+    /// The names of the fields are ids of the name pool of the data source (see `getInternedString`).
+    const DecodePlan& getDecodePlan(const Symbol& udt) const { return m_decodePlans.compile(udt, m_utf8Names); }
+
+    /// @brief Get the deep structural hash of a type of this data source (see `StructuralHasher`).
+    /// The hashes are memoized for the lifetime of the session, so each distinct type is only hashed once.
+    size_t getStructuralHash(const Symbol& symbol) const { return m_structuralHasher.hash(symbol); }
+
+    /// @brief Same as `Symbol::calcHash`, except that the types referenced by the symbol (its type, class parent, members...) are hashed by
+    /// the structural hasher of this data source, which memoizes them for the whole session.
+    size_t calcHash(const Symbol& symbol) const;
+
     Session& getSession() { return m_session; }
 
     Symbol getSymbolByHash(size_t symbolHash) const;
+    Symbol getSymbolById(DWORD symIndexId) const;
+
+    /// @brief Get the path of a symbol of this data source, which identifies it in every session of the PDB (see `SymbolLocator`).
+    SymbolPath getSymbolPath(const Symbol& symbol) const { return m_symbolLocator.getPath(*this, symbol); }
+
+    /// @brief Get the symbol of this data source a path leads to, which may have been found in another session of the PDB.
+    Symbol getSymbolByPath(const SymbolPath& path) const { return m_symbolLocator.getSymbol(*this, path); }
 
     DiaSymbolEnumerator<Symbol> getExports() const;
 
@@ -86,6 +131,12 @@ private:
     CComPtr<IDiaDataSource> m_comPtr{nullptr};
     Session m_session{};
     std::vector<std::wstring> m_additionalSymstoreDirectories{};
+    mutable TypeNameResolver m_typeNameResolver{};
+    mutable Utf8NamePool m_utf8Names{};
+    mutable FieldPathResolver m_fieldPathResolver{};
+    mutable DecodePlanCompiler m_decodePlans{};
+    mutable StructuralHasher m_structuralHasher{};
+    mutable SymbolLocator m_symbolLocator{};
 };
 
 }  // namespace dia
@@ -0,0 +1,100 @@
+#pragma once
+#include "DiaFieldPath.h"
+#include "DiaNamePool.h"
+#include "DiaSymbol.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace dia
+{
+enum class DecodeKind
+{
+    Signed,
+    Unsigned,
+    Float,
+    Bool,
+    /// @brief Raw bytes, for character arrays and the types which have no natural scalar value.
+    Bytes,
+    /// @brief A UDT, decoded with its own plan.
+    Nested,
+};
+
+struct DecodePlan;
+
+/// @brief Decodes a single field of a UDT out of the bytes of an instance.
+struct DecodeOp
+{
+    /// @brief The name of the field, interned in the name pool of the session.
+    StringId nameId{0};
+    DecodeKind kind{DecodeKind::Bytes};
+    ULONGLONG offset{0};
+    /// @brief The number of bytes of a single element. For bitfields, the size of their storage unit. For bytes, the size of the whole field.
+    ULONGLONG width{0};
+    /// @brief For bitfields, the position and length of the bits to extract from the storage unit. The length is 0 for other fields.
+    DWORD bitPosition{0};
+    DWORD bitLength{0};
+    /// @brief The mask applied to the storage unit once shifted right by the bit position. All ones for other fields.
+    ULONGLONG bitMask{~0ull};
+    /// @brief For arrays, the number of elements and the distance between them. Arrays of arrays are flattened. The count is 0 for scalars.
+    ULONGLONG count{0};
+    ULONGLONG stride{0};
+    /// @brief The plan of nested UDTs, owned by the compiler.
+    const DecodePlan* nested{nullptr};
+
+    bool isBitfield() const { return 0 != bitLength; }
+    bool isArray() const { return 0 != count; }
+};
+
+/// @brief A flat list of the operations which decode every field of a UDT, in declaration order, base classes first.
+struct DecodePlan
+{
+    DWORD symIndexId{0};
+    /// @brief The size of an instance, which is also the distance between contiguous instances.
+    ULONGLONG size{0};
+    std::vector<DecodeOp> ops{};
+};
+
+/// @brief Read an integer field (or a single element of an integer array) out of the bytes of the element, extracting its bits for bitfields.
+/// Signed values are sign extended.
+ULONGLONG readUnsigned(const DecodeOp& op, const uint8_t* element);
+LONGLONG readSigned(const DecodeOp& op, const uint8_t* element);
+double readFloat(const DecodeOp& op, const uint8_t* element);
+
+/// @brief Build the operation reading an integer field (a bitfield, or an integer, enum, bool or pointer) out of where a field path leads to.
+/// @throws InvalidUsageException if the field is not an integer, or is larger than 64 bits.
+DecodeOp makeIntegerDecodeOp(const FieldPath& fieldPath);
+
+/// @brief Extract an integer field (see `makeIntegerDecodeOp`) out of `count` instances laid `stride` bytes apart, into `count` values.
+/// The storage units are gathered first, and the bits are then shifted, masked and sign extended in passes over the contiguous values, which
+/// the compiler vectorizes. Signed values are stored as their two's complement.
+/// @throws InvalidUsageException if the operation does not read an integer.
+void extractIntegers(const DecodeOp& op, const uint8_t* instances, size_t count, ULONGLONG stride, ULONGLONG* values);
+
+/// @brief Compiles the decode plans of UDTs, and caches them along with the plans of the UDTs they nest.
+/// Fields are decoded by the kind of their type: integers, pointers and enums are integers, floats are floats, character arrays and types with
+/// no scalar value are raw bytes, and UDTs are nested plans. Static members are left out, and the members of base classes are flattened into
+/// the plan of the derived UDT. An instance must only ever be used with symbols from a single session.
+class DecodePlanCompiler
+{
+public:
+    DecodePlanCompiler() = default;
+
+    /// @param names The name pool of the session, which the names of the fields are interned in.
+    /// @return A reference to the cached plan, which stays valid until `clear` is called or the compiler is destroyed.
+    /// @throws InvalidUsageException if the symbol is not a UDT.
+    const DecodePlan& compile(const Symbol& udt, Utf8NamePool& names);
+
+    size_t getCompiledPlanCount() const { return m_plans.size(); }
+
+    /// @brief Forget all the compiled plans.
+    void clear() { m_plans.clear(); }
+
+private:
+    void appendOps(const Symbol& udt, ULONGLONG baseOffset, Utf8NamePool& names, std::vector<DecodeOp>& ops);
+    void setValueKind(const Symbol& type, Utf8NamePool& names, DecodeOp& op);
+
+    std::unordered_map<DWORD, DecodePlan> m_plans{};
+};
+
+}  // namespace dia
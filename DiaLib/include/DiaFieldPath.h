@@ -0,0 +1,49 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <string>
+#include <unordered_map>
+
+namespace dia
+{
+/// @brief Where a field path (e.g. `Pcb.DirectoryTableBase` or `a.b[3].c`) leads to within a UDT.
+struct FieldPath
+{
+    /// @brief Offset of the field from the start of the UDT. For bitfields, the offset of their storage unit.
+    ULONGLONG offset{0};
+    /// @brief Length of the type of the field. For bitfields, the length of their storage unit.
+    ULONGLONG size{0};
+    bool isBitfield{false};
+    DWORD bitPosition{0};
+    ULONGLONG bitLength{0};
+    /// @brief The type of the field. The UDT itself for an empty path.
+    Symbol type{};
+};
+
+/// @brief Resolve a path of members and array indices within a UDT, like `a.b[3].c`.
+/// Members are looked up by name in the UDT, then within its anonymous unions and structs, then within its base classes, and indices may be
+/// decimal or hexadecimal. Pointers are not followed, as the offset of their pointee is not known.
+/// @throws InvalidUsageException if the path is malformed, if a member is looked up in something other than a UDT, or if something other than
+/// an array is indexed, or if an index is out of bounds.
+/// @throws SymbolNotFoundException if a member cannot be found.
+FieldPath resolveFieldPath(const Symbol& udt, const std::wstring& path);
+
+/// @brief Resolves field paths (see `resolveFieldPath`) and caches them by UDT and path, so resolving a path again is a lookup.
+/// An instance must only ever be used with symbols from a single session.
+class FieldPathResolver
+{
+public:
+    FieldPathResolver() = default;
+
+    /// @return A reference to the cached resolution, which stays valid until `clear` is called or the resolver is destroyed.
+    const FieldPath& resolve(const Symbol& udt, const std::wstring& path);
+
+    size_t getCompiledPathCount() const;
+
+    /// @brief Forget all the resolved paths.
+    void clear() { m_pathsBySymIndexId.clear(); }
+
+private:
+    std::unordered_map<DWORD, std::unordered_map<std::wstring, FieldPath>> m_pathsBySymIndexId{};
+};
+
+}  // namespace dia
@@ -0,0 +1,41 @@
+#pragma once
+#include <functional>
+#include <string>
+
+namespace dia
+{
+class DataSource;
+
+struct HeaderGeneratorOptions
+{
+    /// @brief The namespace enclosing the generated declarations. Empty to generate them in the global namespace.
+    std::wstring namespaceName{L"windows"};
+    /// @brief Whether to add `using X = struct _X;` and `using PX = struct _X*;` for types named `_X`, the way the Windows headers name them.
+    bool emitAliases{true};
+    /// @brief Number of threads rendering types. 0 uses one per hardware thread, 1 renders on the calling thread using the given data source.
+    size_t workerCount{0};
+};
+
+/// @brief Receives the generated header, UTF-8 encoded, in chunks.
+using HeaderSink = std::function<void(const char* data, size_t size)>;
+
+/// @brief Generate a C++ header declaring all the named UDTs and enums of a data source.
+/// Types are emitted in dependency order (see TypeDependencyGraph): a type comes after the types it contains by value, and a forward declaration
+/// is inserted before the first type which points to a type defined later, which breaks the pointer cycles. Unnamed types are defined inline
+/// where they are contained (arrays of them are declared the C way), while pointers to them become `void*`. Bitfields, packing and base classes
+/// are kept, while member functions are left out. Enums which are defined several times under the same name are merged into a single definition
+/// with all of their values. Types whose names are not plain identifiers (nested or template types) are declared under an identifier made from
+/// their name, e.g. `Outer__Inner_int_` for `Outer::Inner<int>`. The `HRESULT` and `BSTR` aliases are only declared when some type uses them.
+/// Types are rendered in parallel, each worker thread using its own session on the loaded PDB like `hashAll`, and the header is streamed to the
+/// sink through a buffer.
+/// @throws InvalidUsageException if types contain each other by value, or if merged enums give the same name different values.
+void writeHeader(const DataSource& dataSource, const HeaderSink& sink, const HeaderGeneratorOptions& options = {});
+
+/// @brief Generate the header (see `writeHeader`) into a file, replacing it if it exists.
+void writeHeaderFile(const DataSource& dataSource, const std::wstring& outputFilePath, const HeaderGeneratorOptions& options = {});
+
+/// @brief Generate the header (see `writeHeader`) into memory.
+/// @return The UTF-8 encoded header.
+std::string generateHeader(const DataSource& dataSource, const HeaderGeneratorOptions& options = {});
+
+}  // namespace dia
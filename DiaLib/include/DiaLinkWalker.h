@@ -0,0 +1,87 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+
+/// @brief Reads memory of a target (e.g. `MinidumpReader::read`).
+/// @return The number of bytes read, which is less than `size` if the memory is not (entirely) available.
+using MemoryReader = std::function<size_t(ULONGLONG address, void* buffer, size_t size)>;
+
+/// @brief Receives the addresses of the containers found by a walk, a batch at a time.
+/// @return Whether to go on walking.
+using LinkWalkBatchCallback = std::function<bool(const ULONGLONG* containerAddresses, size_t count)>;
+
+enum class LinkWalkStatus
+{
+    /// @brief The list went back to its head or reached a null link, or the whole tree was walked.
+    Completed,
+    /// @brief The batch callback asked to stop.
+    Stopped,
+    /// @brief A link led to a node which was already walked, which only happens in corrupt (or concurrently modified) structures.
+    CycleDetected,
+    /// @brief A link could not be read.
+    MemoryNotReadable,
+    /// @brief The walk found more nodes than `LinkWalkOptions::maxNodes`.
+    NodeLimitReached,
+};
+
+struct LinkWalkOptions
+{
+    /// @brief For lists, the member of the link field pointing to the link field of the next container ("Flink" for LIST_ENTRY, "Next" for
+    /// SINGLE_LIST_ENTRY).
+    std::wstring nextMember{L"Flink"};
+    /// @brief For trees, the members of the link field pointing to the link fields of the children (as in RTL_BALANCED_NODE).
+    std::wstring leftMember{L"Left"};
+    std::wstring rightMember{L"Right"};
+    size_t maxNodes{0x100000};
+    /// @brief The number of containers passed to the batch callback at a time (the last batch may be smaller).
+    size_t batchSize{0x400};
+};
+
+/// @brief Walks intrusive lists and trees of a container UDT in the memory of a target, without any work per node but reading its links.
+/// The links (e.g. LIST_ENTRY or RTL_BALANCED_NODE) are a field of the container, and point to the same field of the next container, so the
+/// address of a container is the address of its link minus the offset of the link field (CONTAINING_RECORD). Every walked link is remembered,
+/// so corrupt structures are detected instead of walked forever. The walker keeps a reference to the data source.
+class LinkWalker
+{
+public:
+    /// @param linkPath The field path of the link field within the container (see `DataSource::resolveFieldPath`), e.g. "ActiveProcessLinks".
+    /// @throws InvalidUsageException if the link field is not a UDT.
+    LinkWalker(const DataSource& dataSource, const Symbol& containerUdt, const std::wstring& linkPath, MemoryReader readMemory);
+
+    ULONGLONG getLinkOffset() const { return m_linkOffset; }
+
+    /// @brief Walk a list from its head, which is a link but not part of a container (e.g. PsActiveProcessHead), until it goes back to the head
+    /// or reaches a null link. The containers are reported in list order.
+    /// @throws InvalidUsageException if the next member of the link field is not a pointer.
+    LinkWalkStatus walkList(ULONGLONG headAddress, const LinkWalkOptions& options, const LinkWalkBatchCallback& onBatch);
+
+    /// @brief Walk a binary tree from the link of its root container. The containers are reported in order (left subtree, node, right subtree).
+    /// @throws InvalidUsageException if the left or right member of the link field is not a pointer.
+    LinkWalkStatus walkTree(ULONGLONG rootAddress, const LinkWalkOptions& options, const LinkWalkBatchCallback& onBatch);
+
+private:
+    /// @brief The offset and size of a pointer within the link field.
+    struct LinkPointer
+    {
+        ULONGLONG offset;
+        size_t size;
+    };
+
+    LinkPointer resolveLinkPointer(const std::wstring& member) const;
+    bool readLink(ULONGLONG linkAddress, const LinkPointer& pointer, ULONGLONG& nextLinkAddress) const;
+
+    const DataSource& m_dataSource;
+    MemoryReader m_readMemory;
+    ULONGLONG m_linkOffset{0};
+    Symbol m_linkType{};
+};
+
+std::wstring linkWalkStatusToName(LinkWalkStatus status);
+
+}  // namespace dia
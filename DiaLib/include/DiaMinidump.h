@@ -0,0 +1,136 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <atlbase.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+
+/// @brief The granularity at which addresses of the dumped memory are translated and cached.
+constexpr ULONGLONG MINIDUMP_PAGE_SIZE = 0x1000;
+
+/// @brief A module of the dumped process, as listed by the module list stream.
+struct MinidumpModule
+{
+    ULONGLONG baseAddress{0};
+    ULONG size{0};
+    ULONG timeDateStamp{0};
+    std::wstring path{};
+    /// @brief The signature and age of the PDB of the module, from its CodeView (RSDS) record. Only valid if `hasPdbSignature`.
+    bool hasPdbSignature{false};
+    GUID pdbGuid{};
+    DWORD pdbAge{0};
+};
+
+/// @brief A range of the dumped memory, and where its bytes are in the dump file.
+struct MinidumpMemoryRange
+{
+    ULONGLONG address{0};
+    ULONGLONG size{0};
+    ULONGLONG fileOffset{0};
+};
+
+/// @brief Bytes of the dumped memory, pointing straight into the mapped dump file. `data` is null when the memory is not in the dump.
+struct MemoryView
+{
+    ULONGLONG address{0};
+    const uint8_t* data{nullptr};
+    size_t size{0};
+
+    bool empty() const { return nullptr == data; }
+};
+
+/// @brief Reads the memory and the modules of a minidump (the memory list, memory64 list, module list and system info streams).
+/// The dump file is mapped rather than read, so nothing is read until it is touched, and views of the dumped memory are pointers into the
+/// mapping. Addresses are translated to the mapping a page at a time, and each translated page is cached, so following pointers through
+/// large structures costs a lookup per page rather than a search of the memory ranges. The reader is not thread safe.
+class MinidumpReader final
+{
+public:
+    /// @throws WinApiException if the file cannot be opened or mapped.
+    /// @throws InvalidFileFormatException if the file is not a minidump, or its streams are out of the bounds of the file.
+    explicit MinidumpReader(const std::wstring& dumpFilePath);
+    ~MinidumpReader() noexcept;
+
+    MinidumpReader(const MinidumpReader&)            = delete;
+    MinidumpReader& operator=(const MinidumpReader&) = delete;
+
+    const std::vector<MinidumpModule>& getModules() const { return m_modules; }
+
+    /// @brief The ranges of the dumped memory, sorted by address.
+    const std::vector<MinidumpMemoryRange>& getMemoryRanges() const { return m_memoryRanges; }
+
+    /// @brief The size of a pointer of the dumped process, by its processor architecture (8 if the dump has no system info stream).
+    size_t getPointerSize() const { return m_pointerSize; }
+
+    /// @brief The whole mapped dump file, e.g. to expose views of it without copying them.
+    const uint8_t* getFileData() const { return m_fileData; }
+    ULONGLONG getFileSize() const { return m_fileSize; }
+
+    /// @return The module containing the address, or nullptr.
+    const MinidumpModule* findModule(ULONGLONG address) const;
+
+    /// @return The module whose file name (case insensitive, without its directory) or full path is `name`, or nullptr.
+    const MinidumpModule* findModule(const std::wstring& name) const;
+
+    /// @return The module whose PDB signature (GUID) is the one of the PDB loaded by the data source, or nullptr.
+    const MinidumpModule* findModule(const DataSource& dataSource) const;
+
+    /// @brief Get a view of `size` bytes of the dumped memory, without copying them.
+    /// @return An empty view if any of the bytes is not in the dump, or if the bytes are not contiguous in the dump file.
+    MemoryView getView(ULONGLONG address, size_t size);
+
+    /// @brief Get a view of an instance of a UDT at an address of the dumped memory (see `getView`).
+    MemoryView getView(const Symbol& udt, ULONGLONG address) { return getView(address, static_cast<size_t>(getLength(udt))); }
+
+    /// @brief Copy bytes of the dumped memory, up to the first byte which is not in the dump.
+    /// @return The number of bytes copied.
+    size_t read(ULONGLONG address, void* buffer, size_t size);
+
+    /// @brief Read a pointer of the dumped process (see `getPointerSize`).
+    /// @throws MemoryNotInDumpException if the pointer is not in the dump.
+    ULONGLONG readPointer(ULONGLONG address);
+
+    /// @brief Follow the pointer a field path of a UDT leads to (see `DataSource::resolveFieldPath`), from an instance at `address`.
+    /// @return The address the pointer points to.
+    /// @throws InvalidUsageException if the field is not a pointer.
+    /// @throws MemoryNotInDumpException if the pointer is not in the dump.
+    ULONGLONG followPointer(const DataSource& dataSource, const Symbol& udt, ULONGLONG address, const std::wstring& path);
+
+    size_t getCachedPageCount() const { return m_pages.size(); }
+
+private:
+    /// @brief Where the bytes of a page are in the mapping. `available` is the number of bytes of its memory range from the start of the page,
+    /// and `data` is null for pages whose start is not in the dump.
+    struct TranslatedPage
+    {
+        const uint8_t* data;
+        ULONGLONG available;
+    };
+
+    void parseStreams();
+    void parseModuleList(const uint8_t* stream, ULONGLONG streamSize);
+    void parseMemoryList(const uint8_t* stream, ULONGLONG streamSize);
+    void parseMemory64List(const uint8_t* stream, ULONGLONG streamSize);
+    void parseSystemInfo(const uint8_t* stream, ULONGLONG streamSize);
+
+    /// @brief Get where the bytes at an address are in the mapping, and how many of them are contiguous.
+    /// @return Whether the address is in the dump.
+    bool translate(ULONGLONG address, const uint8_t*& data, ULONGLONG& available);
+    const MinidumpMemoryRange* findMemoryRange(ULONGLONG address) const;
+
+    ATL::CHandle m_file{};
+    ATL::CHandle m_mapping{};
+    const uint8_t* m_fileData{nullptr};
+    ULONGLONG m_fileSize{0};
+    size_t m_pointerSize{sizeof(ULONGLONG)};
+    std::vector<MinidumpModule> m_modules{};
+    std::vector<MinidumpMemoryRange> m_memoryRanges{};
+    std::unordered_map<ULONGLONG, TranslatedPage> m_pages{};
+};
+
+}  // namespace dia
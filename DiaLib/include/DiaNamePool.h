@@ -0,0 +1,47 @@
+#pragma once
+#include "DiaStringInterner.h"
+#include "DiaSymbol.h"
+#include <string>
+#include <unordered_map>
+
+namespace dia
+{
+/// @brief The UTF-8 names of the symbols of a session, each queried once and stored once.
+/// DIA hands out names as BSTRs, which are allocated on every query and take two bytes per character of the (nearly always ASCII) names of a
+/// PDB. The pool queries the name of each symbol once, converts it straight to UTF-8 and interns it (see `StringInterner`), so that all the
+/// symbols which share a name (e.g. the countless `Flags` and `Reserved` members) share a single copy and a single id. An instance must only
+/// ever be used with symbols from a single session.
+class Utf8NamePool
+{
+public:
+    Utf8NamePool() = default;
+
+    /// @brief Get the id of the name of a symbol. Symbols have the same name exactly when they have the same name id.
+    /// @throws PropertyNotAvailableException if the symbol has no name.
+    StringId getNameId(const Symbol& symbol);
+
+    /// @brief Get the name of a symbol, encoded in UTF-8.
+    /// @return A view of the interned name, which stays valid until `clear` is called or the pool is destroyed.
+    /// @throws PropertyNotAvailableException if the symbol has no name.
+    InternedString getName(const Symbol& symbol) { return m_interner.get(getNameId(symbol)); }
+
+    /// @brief Intern an arbitrary string.
+    /// @return The id of the UTF-8 encoded string.
+    StringId intern(const wchar_t* text, size_t length);
+
+    InternedString getString(StringId id) const { return m_interner.get(id); }
+
+    size_t getNamedSymbolCount() const { return m_nameIdBySymIndexId.size(); }
+    size_t getInternedNameCount() const { return m_interner.getCount(); }
+
+    /// @brief Forget all the names.
+    void clear();
+
+private:
+    StringInterner m_interner{};
+    std::unordered_map<DWORD, StringId> m_nameIdBySymIndexId{};
+    /// @brief Reused for every conversion, so that looking up a name which is already interned allocates nothing.
+    std::string m_conversionBuffer{};
+};
+
+}  // namespace dia
@@ -0,0 +1,19 @@
+#pragma once
+#include <dia2.h>
+#include <unordered_map>
+
+namespace dia
+{
+class DataSource;
+
+/// @brief Hash the whole symbol table of a data source (every child of the global scope, and the members of every UDT and enum) using
+/// DataSource::calcHash, spread across worker threads.
+/// DIA sessions are not shared between threads: each worker opens its own session on the loaded PDB. symIndexIds are assigned by each session,
+/// so the workers address symbols by their position in the enumeration of the global scope, and the given data source keys the results.
+/// @param dataSource The data source whose symbols to hash.
+/// @param workerCount Number of worker threads. 0 uses one per hardware thread, 1 hashes on the calling thread using the given data source.
+/// @return The hash of each symbol, keyed by its symIndexId in the session of `dataSource`. Symbols whose hash cannot be calculated are left out.
+/// @throws InvalidUsageException if the sessions of the workers do not enumerate the same symbols.
+std::unordered_map<DWORD, size_t> hashAll(const DataSource& dataSource, size_t workerCount = 0);
+
+}  // namespace dia
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dia
+{
+/// @brief Identifies a string of a StringInterner. Ids are dense and start from 0, so they can index arrays of per-string data.
+using StringId = uint32_t;
+
+/// @brief A view of an interned string. It is NUL terminated, and stays valid as long as the interner it comes from.
+struct InternedString
+{
+    const char* data;
+    size_t size;
+};
+
+/// @brief Deduplicates strings into an arena, and identifies each distinct string by a small integer.
+/// Strings are copied once into large blocks which are never moved nor freed until `clear`, so their views stay valid. A lookup hashes the
+/// string once and only compares it to the strings with the same hash, without allocating. Two strings of the same interner are equal exactly
+/// when their ids are, so comparing and hashing interned strings is comparing and hashing integers.
+class StringInterner
+{
+public:
+    StringInterner() = default;
+
+    StringInterner(const StringInterner&)            = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /// @return The id of the string, which is the id it was given the first time it was interned.
+    StringId intern(const char* data, size_t size);
+
+    InternedString get(StringId id) const { return InternedString{m_entries[id].data, m_entries[id].size}; }
+
+    size_t getCount() const { return m_entries.size(); }
+    /// @brief The number of bytes taken by the arena.
+    size_t getArenaSize() const { return m_arenaSize; }
+
+    /// @brief Forget all the strings, invalidating their ids and views.
+    void clear();
+
+private:
+    struct Entry
+    {
+        const char* data;
+        uint32_t size;
+        uint32_t hash;
+    };
+
+    const char* store(const char* data, size_t size);
+    void rehash(size_t slotCount);
+
+    std::vector<Entry> m_entries{};
+    /// @brief Open addressing table of the ids, plus one so that 0 marks an empty slot. Its size is a power of two.
+    std::vector<StringId> m_slots{};
+    std::vector<std::unique_ptr<char[]>> m_blocks{};
+    char* m_blockCursor{nullptr};
+    size_t m_blockRemaining{0};
+    size_t m_arenaSize{0};
+};
+
+}  // namespace dia
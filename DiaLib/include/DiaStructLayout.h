@@ -0,0 +1,129 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+
+constexpr ULONGLONG DEFAULT_CACHE_LINE_SIZE = 64;
+
+enum class LayoutFieldKind
+{
+    Member,
+    Bitfields,
+    BaseClass,
+    VTablePointer,
+};
+
+/// @brief A range of the bytes of a UDT taken by one of its fields. Bitfields which share a storage unit make up a single field.
+struct LayoutField
+{
+    LayoutFieldKind kind{LayoutFieldKind::Member};
+    /// @brief The name of the member or of the base class. For a storage unit, the names of its bitfields separated by commas.
+    std::wstring name{};
+    ULONGLONG offset{0};
+    /// @brief The number of bytes taken by the field. Empty base classes take none.
+    ULONGLONG size{0};
+    /// @brief The alignment the field was laid out with: its natural alignment, capped by the packing of the UDT.
+    ULONGLONG alignment{1};
+    /// @brief For a storage unit, the number of bits taken by its bitfields.
+    ULONGLONG usedBits{0};
+    /// @brief Whether the field spans more cache lines than its size requires, assuming the UDT starts on a cache line.
+    bool straddlesCacheLine{false};
+};
+
+/// @brief Padding between two fields.
+struct LayoutHole
+{
+    ULONGLONG offset{0};
+    ULONGLONG size{0};
+};
+
+/// @brief The memory layout of a UDT, along with the bytes and bits it wastes.
+struct StructLayout
+{
+    DWORD symIndexId{0};
+    std::wstring name{};
+    enum UdtKind udtKind { UdtStruct };
+    ULONGLONG size{0};
+    /// @brief The alignment of the UDT, which is the largest `#pragma pack` value its offsets are consistent with, up to its natural alignment.
+    ULONGLONG alignment{1};
+    /// @brief The largest natural alignment of the fields, which is larger than `alignment` for packed UDTs.
+    ULONGLONG naturalAlignment{1};
+    /// @brief The fields in ascending order of offset. Fields at the same offset (as in unions) keep their declaration order.
+    std::vector<LayoutField> fields{};
+    /// @brief The padding between the fields, in ascending order of offset. Always empty for unions.
+    std::vector<LayoutHole> holes{};
+    /// @brief The padding after the last field.
+    ULONGLONG tailPadding{0};
+    /// @brief The bits left unused in the storage units of the bitfields.
+    ULONGLONG unusedBitfieldBits{0};
+    /// @brief The size the UDT would have with its fields sorted by decreasing alignment, which leaves no padding between them. Overlapping
+    /// fields, such as the members of a flattened anonymous union, are moved together and only take the bytes they span once.
+    ULONGLONG minimumSize{0};
+
+    ULONGLONG getHoleSize() const;
+    ULONGLONG getPaddingSize() const { return getHoleSize() + tailPadding; }
+    /// @return The number of bytes reordering the fields would save.
+    ULONGLONG getReorderingSavings() const { return size - minimumSize; }
+    size_t getStraddlingFieldCount() const;
+};
+
+/// @brief Computes the layout of UDTs from the offsets, lengths and bit positions of their members.
+/// PDBs do not record alignments, so the natural alignment of each field is derived from its type (the size of scalars, the alignment of the
+/// element of arrays, the alignment of the fields of UDTs) and the packing of the UDT is the largest one its offsets are consistent with. Fields
+/// typed with a forward declared UDT take the size and alignment of the definition with the same name.
+/// Alignments forced with `__declspec(align)` beyond that are not recorded, and neither are the offsets of virtual base classes, whose bytes
+/// show up as holes. The alignments of the UDTs met along the way are cached, so an instance must only ever be used with symbols from a single
+/// session.
+class StructLayoutAnalyzer
+{
+public:
+    /// @throws InvalidUsageException if the cache line size is 0.
+    explicit StructLayoutAnalyzer(ULONGLONG cacheLineSize = DEFAULT_CACHE_LINE_SIZE);
+
+    /// @throws InvalidUsageException if the symbol is not a UDT.
+    StructLayout analyze(const Symbol& udt);
+
+    /// @return The alignment of a type, as it would be laid out as a field.
+    ULONGLONG getAlignment(const Symbol& type);
+
+private:
+    struct UdtAlignment
+    {
+        ULONGLONG alignment;
+        /// @brief Whether the UDT has no fields, which makes it take no bytes as a base class.
+        bool isEmpty;
+    };
+
+    const UdtAlignment& getUdtAlignment(const Symbol& udt);
+
+    ULONGLONG m_cacheLineSize;
+    std::unordered_map<DWORD, UdtAlignment> m_udtAlignmentBySymIndexId{};
+};
+
+struct StructLayoutReportOptions
+{
+    ULONGLONG cacheLineSize{DEFAULT_CACHE_LINE_SIZE};
+    /// @brief Number of threads analyzing UDTs. 0 uses one per hardware thread, 1 analyzes on the calling thread using the given data source.
+    size_t workerCount{0};
+};
+
+/// @brief Analyze the layout of every UDT defined in a data source (forward declarations are left out).
+/// UDTs are analyzed in parallel, each worker thread using its own session on the loaded PDB like `hashAll`. Layouts come in the order DIA
+/// enumerates the UDTs whatever the number of workers, so reports of two builds can be compared by name.
+/// @return The layouts of the UDTs.
+/// @throws DiaComException (or whatever else the analysis of a UDT throws) if the layout of any UDT cannot be queried, rather than leaving it out
+/// of the report silently.
+std::vector<StructLayout> analyzeStructLayouts(const DataSource& dataSource, const StructLayoutReportOptions& options = {});
+
+std::wstring layoutFieldKindToName(LayoutFieldKind kind);
+
+}  // namespace dia
+
+std::wostream& operator<<(std::wostream& os, const dia::LayoutField& field);
+std::wostream& operator<<(std::wostream& os, const dia::StructLayout& layout);
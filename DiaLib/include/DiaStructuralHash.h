@@ -0,0 +1,63 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <cstdint>
+#include <unordered_map>
+
+namespace dia
+{
+class DataSource;
+
+/// @brief Seed of a second structural hash, which together with the unseeded one makes a 128-bit hash to confirm matches of the 64-bit hashes.
+constexpr size_t CONFIRMING_STRUCTURAL_HASH_SEED = 0x9e3779b9;
+
+/// @brief Calculates deep (Merkle-style) structural hashes of types.
+/// The hash of a type covers its members, base classes, nested types, array element types and function signatures, so two types with the same
+/// name but a different layout hash differently. Types referenced through pointers (and through function signatures) are hashed by nominal
+/// reference (tag, kind and name), which both breaks the cycles in self-referencing types and keeps the hash of a type independent from the
+/// layout of everything it merely points to.
+/// Hashes are memoized by symIndexId, so an instance must only ever be used with symbols from a single session.
+/// A type which (through unnamed types) contains itself is hashed with a nominal placeholder where it recurses. Hashes which depend on such a
+/// placeholder of an enclosing type are not memoized, so the hash of every type is the same whatever order the types are hashed in.
+class StructuralHasher
+{
+public:
+    /// @param seed Seed of every hash. Hashers with different seeds calculate independent hashes, so together they make a wider hash.
+    explicit StructuralHasher(size_t seed = 0)
+        : m_seed(seed)
+    {
+    }
+
+    /// @brief Calculate the deep structural hash of a symbol.
+    /// @param symbol The symbol (usually a type) to hash.
+    /// @return The structural hash. Identical types in different PDBs have identical hashes.
+    size_t hash(const Symbol& symbol);
+
+    /// @brief Hash every UDT, enum and typedef of the data source. Each distinct type is hashed exactly once.
+    /// @param dataSource The data source whose types to hash. Must be the data source this hasher is used with.
+    /// @return The structural hash of each type, keyed by symIndexId.
+    std::unordered_map<DWORD, size_t> hashTypes(const DataSource& dataSource);
+
+    /// @brief Forget all memoized hashes.
+    void clear();
+
+private:
+    size_t hashType(const Symbol& symbol);
+    size_t hashReference(const Symbol& symbol);
+    size_t hashNominal(const Symbol& symbol) const;
+
+    size_t hashUserDefinedType(const Symbol& udt);
+    size_t hashEnum(const Symbol& enumSymbol);
+    size_t hashFunctionType(const Symbol& functionType);
+    size_t hashDataMember(const Symbol& dataMember);
+
+    size_t m_seed{0};
+    // Hashes which do not depend on the types being hashed around them, so they are valid everywhere.
+    std::unordered_map<DWORD, size_t> m_hashBySymIndexId{};
+    // Hashes of the types which contain themselves, only valid when they are not nested in the hash of another type.
+    std::unordered_map<DWORD, size_t> m_rootHashBySymIndexId{};
+    // The depth of each type being hashed, and the lowest depth whose placeholder the innermost hash used.
+    std::unordered_map<DWORD, size_t> m_depthBySymbolInProgress{};
+    size_t m_lowestPlaceholderDepth{SIZE_MAX};
+};
+
+}  // namespace dia
@@ -578,6 +578,7 @@ private:
     enumerate<DataMember>(const Symbol& parentSymbol, enum SymTagEnum symTag, LPCOLESTR name, DWORD compareFlags);
     friend ::std::wstring resolveTypeName(const Symbol& symbol);
     friend ::std::wstring resolveBaseTypeName(const Symbol& symbol);
+    friend class TypeNameResolver;
     friend class DataSource;
 
     template <typename T>
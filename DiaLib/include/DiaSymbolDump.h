@@ -0,0 +1,95 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <functional>
+#include <string>
+
+namespace dia
+{
+class DataSource;
+class TypeNameResolver;
+
+/// @brief Formats symbols as the text of a dump, one line per symbol, in the spirit of llvm-pdbutil.
+/// A line is the tag of the symbol followed by its name and the fields which matter for that tag (type, location, length, value, ...).
+/// Every field is appended straight into the output: numbers are formatted on the stack, names are copied out of the BSTR returned by DIA and
+/// type names are references into the cache of a TypeNameResolver, so that no intermediate string is built per field. Properties which are
+/// not available for a symbol are left out of its line.
+class SymbolDumpFormatter
+{
+public:
+    /// @param typeNameResolver The resolver of the type names, which must only be used with symbols of the session of the formatted symbols.
+    /// @param out The string the text is appended to.
+    /// @param withSymIndexIds Whether to add the symIndexId of each symbol, which is not stable across builds of the same binary.
+    SymbolDumpFormatter(TypeNameResolver& typeNameResolver, std::wstring& out, bool withSymIndexIds = false);
+
+    /// @brief Append the description of a single symbol, without indentation or line break.
+    void formatSymbol(const Symbol& symbol);
+
+    /// @brief Append the line of a single symbol. A symbol whose properties cannot be queried gets a line saying so rather than an exception.
+    void formatSymbolLine(const Symbol& symbol, size_t depth = 0);
+
+    /// @brief Append the line of a symbol followed by the lines of its children, each level indented by two more spaces.
+    /// Compilands, functions and blocks are dumped with their whole lexical content. UDTs and enums are dumped with their members, but the
+    /// nested types and the bodies of member functions are left to their own entries.
+    void formatSymbolTree(const Symbol& symbol, size_t depth = 0);
+
+private:
+    void append(const wchar_t* text);
+    void append(const wchar_t* text, size_t length);
+    void appendUnsigned(ULONGLONG value);
+    void appendSigned(LONGLONG value);
+    void appendHex(ULONGLONG value);
+    void appendName(const Symbol& symbol);
+    void appendStringField(const wchar_t* label, const BstrWrapper& text);
+    void appendUnsignedField(const wchar_t* label, ULONGLONG value);
+    void appendHexField(const wchar_t* label, ULONGLONG value);
+    void appendOffsetField(LONGLONG offset);
+    void appendFlag(const wchar_t* label, bool isSet);
+    void appendTypeName(const Symbol& type);
+    void appendTypeField(const Symbol& symbol);
+    void appendAddressFields(const Symbol& symbol);
+    void appendLocationFields(const Symbol& symbol);
+    void appendValueField(const Symbol& symbol);
+
+    TypeNameResolver& m_typeNameResolver;
+    std::wstring& m_out;
+    bool m_withSymIndexIds;
+};
+
+struct SymbolDumpOptions
+{
+    /// @brief Dump the UDTs, enums and typedefs of the global scope, with their members.
+    bool includeTypes{true};
+    /// @brief Dump the global variables and constants.
+    bool includeGlobals{true};
+    /// @brief Dump the public symbols.
+    bool includePublics{true};
+    /// @brief Dump every compiland with its functions, blocks, locals and labels.
+    bool includeCompilands{true};
+    /// @brief Add the symIndexId of each symbol. Off by default, as they change from one build to the next and would clutter diffs of dumps.
+    /// symIndexIds are assigned by each session, so the compilands are then dumped on the calling thread, whatever `workerCount` is.
+    bool includeSymIndexIds{false};
+    /// @brief Number of threads rendering the compilands. 0 uses one per hardware thread, 1 dumps on the calling thread using the given data
+    /// source.
+    size_t workerCount{0};
+};
+
+/// @brief Receives the dump, UTF-8 encoded, in chunks.
+using SymbolDumpSink = std::function<void(const char* data, size_t size)>;
+
+/// @brief Format a single symbol (see `SymbolDumpFormatter::formatSymbol`).
+std::wstring formatSymbol(const Symbol& symbol);
+
+/// @brief Dump the symbols of a data source as text, section by section: the global scope, the types, the globals, the publics and the
+/// compilands. Symbols come in the order DIA enumerates them, so dumps of the same PDB are identical whatever the number of workers.
+/// The compilands are rendered in parallel, each worker thread using its own session on the loaded PDB like `hashAll`, and are handed to the
+/// sink in order as soon as they are ready. The dump is streamed to the sink through a buffer.
+void dumpSymbols(const DataSource& dataSource, const SymbolDumpSink& sink, const SymbolDumpOptions& options = {});
+
+/// @brief Dump the symbols (see `dumpSymbols`) into a file, replacing it if it exists.
+void dumpSymbolsToFile(const DataSource& dataSource, const std::wstring& outputFilePath, const SymbolDumpOptions& options = {});
+
+/// @brief Dump the symbols (see `dumpSymbols`) into memory.
+/// @return The UTF-8 encoded dump.
+std::string dumpSymbolsToString(const DataSource& dataSource, const SymbolDumpOptions& options = {});
+
+}  // namespace dia
@@ -0,0 +1,54 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <unordered_map>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+
+/// @brief A step of a `SymbolPath`: the tag of a symbol, and its position among the children of its parent with that tag.
+struct SymbolPathStep
+{
+    enum SymTagEnum symTag{SymTagNull};
+    size_t position{0};
+};
+
+/// @brief The enumeration positions leading from the global scope to a symbol.
+/// symIndexIds are assigned by each session in the order symbols are looked up, but enumerations are the same in every session of the PDB,
+/// so a path found in one session leads to the same symbol in any other.
+using SymbolPath = std::vector<SymbolPathStep>;
+
+/// @brief Finds the paths of symbols and the symbols of paths, caching the children enumerated along the way.
+/// An instance must only ever be used with symbols from a single session.
+class SymbolLocator
+{
+public:
+    SymbolLocator() = default;
+
+    /// @brief Get the path of a symbol. Each step goes up from a symbol to its class parent, its lexical parent or the global scope, whichever
+    /// is the first to enumerate it.
+    /// @throws InvalidUsageException if none of them enumerates a symbol of the path.
+    SymbolPath getPath(const DataSource& dataSource, const Symbol& symbol);
+
+    /// @brief Get the symbol a path (see `getPath`) leads to.
+    /// @throws InvalidUsageException if a position of the path is out of range.
+    Symbol getSymbol(const DataSource& dataSource, const SymbolPath& path);
+
+    /// @brief Forget all the enumerated children.
+    void clear() { m_childrenByParent.clear(); }
+
+private:
+    struct Children
+    {
+        std::vector<DWORD> symIndexIds{};
+        std::unordered_map<DWORD, size_t> positionBySymIndexId{};
+    };
+
+    const Children& getChildren(const Symbol& parent, enum SymTagEnum symTag);
+
+    // Keyed by the symIndexId of the parent in the high half and the tag of the children in the low half.
+    std::unordered_map<ULONGLONG, Children> m_childrenByParent{};
+};
+
+}  // namespace dia
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <dia2.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+
+enum class TypeEdgeKind : uint8_t
+{
+    /// @brief The complete definition of the dependency is needed (members, base classes, array elements, ...).
+    ByValue,
+    /// @brief A declaration of the dependency is enough (pointers, references, static members, function signatures).
+    ByPointer,
+};
+
+struct TypeEdge
+{
+    uint32_t target;
+    TypeEdgeKind kind;
+};
+
+/// @brief The dependency graph of all the named UDTs, enums and typedefs of a data source, in compressed sparse row form.
+/// Each type is a node, identified by a dense index. An edge from a type to another means the first one needs the second one to be declared
+/// (TypeEdgeKind::ByPointer) or defined (TypeEdgeKind::ByValue). Unnamed types are not nodes, their own dependencies are attributed to the
+/// named type which uses them: by value when it contains the unnamed type by value, by pointer when it only points to it. A type which depends
+/// on a dependency both ways only gets the by-value edge.
+class TypeDependencyGraph
+{
+public:
+    /// @brief The dependencies of a single node.
+    class EdgeRange
+    {
+    public:
+        EdgeRange(const TypeEdge* first, const TypeEdge* last)
+            : m_first{first}
+            , m_last{last}
+        {
+        }
+
+        const TypeEdge* begin() const { return m_first; }
+        const TypeEdge* end() const { return m_last; }
+        size_t size() const { return m_last - m_first; }
+
+    private:
+        const TypeEdge* m_first;
+        const TypeEdge* m_last;
+    };
+
+    /// @brief Build the graph in a single pass over the types of the data source.
+    explicit TypeDependencyGraph(const DataSource& dataSource);
+
+    size_t getNodeCount() const { return m_symIndexIds.size(); }
+    size_t getEdgeCount() const { return m_edges.size(); }
+
+    DWORD getSymIndexId(size_t node) const { return m_symIndexIds.at(node); }
+    bool contains(DWORD symIndexId) const;
+    /// @throws SymbolNotFoundException if the symbol is not a node of the graph.
+    size_t getNode(DWORD symIndexId) const;
+
+    /// @return The types the node depends on, ordered by node index.
+    EdgeRange getDependencies(size_t node) const;
+
+    /// @brief Order the nodes so that every type comes after the types it needs the definition of. Only by-value edges are considered, since
+    /// by-pointer dependencies can always be satisfied with a forward declaration.
+    /// @throws InvalidUsageException if the by-value edges form a cycle, which no valid program can contain.
+    std::vector<size_t> getTopologicalOrder() const;
+
+    /// @brief Find the strongly connected components (Tarjan's algorithm), i.e. the groups of types which (indirectly) depend on each other.
+    /// @param includePointerEdges Whether to follow by-pointer edges as well as by-value ones.
+    /// @return Every component of more than one node, each sorted by node index, in reverse topological order.
+    std::vector<std::vector<size_t>> getStronglyConnectedComponents(bool includePointerEdges = true) const;
+
+    /// @brief Suggest the edges to break in order to emit the types in the order of getTopologicalOrder().
+    /// These are the by-pointer edges inside a cycle which point to a type emitted later. Forward declaring their targets is enough to break all
+    /// the cycles of the graph.
+    /// @return The (dependent, dependency) node pairs of the edges to break.
+    std::vector<std::pair<size_t, size_t>> suggestCycleBreaks() const;
+
+private:
+    std::vector<DWORD> m_symIndexIds{};
+    std::unordered_map<DWORD, uint32_t> m_nodeBySymIndexId{};
+    /// @brief The dependencies of node i are m_edges[m_offsets[i]] to m_edges[m_offsets[i + 1]].
+    std::vector<uint32_t> m_offsets{};
+    std::vector<TypeEdge> m_edges{};
+};
+
+}  // namespace dia
@@ -0,0 +1,84 @@
+#pragma once
+#include <dia2.h>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+
+enum class DiffKind
+{
+    Added,
+    Removed,
+    Changed,
+};
+
+/// @brief A difference in a single member of a type which exists in both data sources.
+/// Members are data members, base classes, member functions (matched by name and signature) and nested types.
+/// For enums, the offset, size and type name are left empty and a changed member means the value of the enumerator changed.
+struct MemberDiff
+{
+    DiffKind kind{DiffKind::Changed};
+    /// @brief SymTagData for data members and enumerators, SymTagBaseClass, SymTagFunction, or the tag of a nested type.
+    enum SymTagEnum symTag { SymTagData };
+    std::wstring name{};
+
+    // The old values are only meaningful for removed and changed members, the new ones for added and changed members.
+    LONG oldOffset{0};
+    LONG newOffset{0};
+    ULONGLONG oldSize{0};
+    ULONGLONG newSize{0};
+    DWORD oldBitPosition{0};
+    DWORD newBitPosition{0};
+    std::wstring oldTypeName{};
+    std::wstring newTypeName{};
+    /// @brief Whether the type kept its name but its content changed, e.g. a data member of a struct type to which a member was added.
+    bool typeContentChanged{false};
+    /// @brief Whether anything besides the offset, size and type changed: the value of an enumerator, the access, static or virtual
+    /// qualifiers of a member, or the content of a nested type.
+    bool attributesChanged{false};
+
+    bool offsetChanged() const { return oldOffset != newOffset || oldBitPosition != newBitPosition; }
+    bool sizeChanged() const { return oldSize != newSize; }
+    bool typeChanged() const { return oldTypeName != newTypeName; }
+};
+
+/// @brief A UDT or enum which was added, removed or changed between two data sources.
+struct TypeDiff
+{
+    DiffKind kind{DiffKind::Changed};
+    enum SymTagEnum symTag { SymTagNull };
+    std::wstring name{};
+    ULONGLONG oldSize{0};
+    ULONGLONG newSize{0};
+    /// @brief Only set for changed types: whether the kind, packing, scoping or modifiers of the type (or the base type of an enum) changed.
+    bool attributesChanged{false};
+    /// @brief Only filled for changed types, in the declaration order of the new type followed by the removed members.
+    std::vector<MemberDiff> members{};
+
+    bool sizeChanged() const { return oldSize != newSize; }
+};
+
+/// @brief Compare the UDTs and enums of two data sources.
+/// Types are matched by tag and name, so a struct is never matched with an enum of the same name. A matched pair whose structural hashes are
+/// equal is skipped without looking at its members, which keeps the diff linear in the number of types. Unnamed types are not compared, as they
+/// cannot be matched between data sources. A changed type is only reported along with what changed: its size, its attributes or its members.
+/// @param oldDataSource The data source to diff from.
+/// @param newDataSource The data source to diff to.
+/// @param onDiff Called with each difference as soon as it is found: first the removed types, then the changed types and last the added types,
+/// each sorted by tag (UDTs before enums) and name.
+void diffTypes(const DataSource& oldDataSource, const DataSource& newDataSource, const std::function<void(const TypeDiff&)>& onDiff);
+
+/// @brief Compare the UDTs and enums of two data sources.
+/// @return All the differences, see the streaming overload.
+std::vector<TypeDiff> diffTypes(const DataSource& oldDataSource, const DataSource& newDataSource);
+
+std::wstring diffKindToName(DiffKind kind);
+
+}  // namespace dia
+
+std::wostream& operator<<(std::wostream& os, const dia::MemberDiff& memberDiff);
+std::wostream& operator<<(std::wostream& os, const dia::TypeDiff& typeDiff);
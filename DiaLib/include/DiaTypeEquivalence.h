@@ -0,0 +1,53 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <unordered_map>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+
+/// @brief A group of UDTs, enums or typedefs of a single data source which all describe the same type.
+struct TypeEquivalenceClass
+{
+    /// @brief The member which represents the whole class. A definition is preferred over a forward declaration, then the lowest symIndexId.
+    DWORD canonicalSymIndexId{0};
+    /// @brief The structural hash of the canonical representative.
+    size_t structuralHash{0};
+    /// @brief symIndexIds of all the members of the class (including the canonical representative), in ascending order.
+    std::vector<DWORD> symIndexIds{};
+
+    size_t size() const { return symIndexIds.size(); }
+};
+
+/// @brief Groups all the UDTs, enums and typedefs of a data source into equivalence classes.
+/// The same type is usually emitted by many compilands under distinct symIndexIds. Types are merged when their 128-bit structural hashes (two
+/// independently seeded StructuralHasher hashes: the first one memoized by the data source, the second one only calculated for the types whose
+/// first one is not unique) are equal, and forward declarations are merged into the definition with the same name when that definition is
+/// unambiguous.
+/// Building the classes is a single pass over the types, unlike comparing every pair with Session::areSymbolsEquivalent.
+class TypeEquivalenceClasses
+{
+public:
+    explicit TypeEquivalenceClasses(const DataSource& dataSource);
+
+    /// @return All the equivalence classes, in ascending order of their canonical symIndexId.
+    const std::vector<TypeEquivalenceClass>& getClasses() const { return m_classes; }
+
+    bool contains(DWORD symIndexId) const;
+    bool contains(const Symbol& type) const;
+
+    /// @brief Get the equivalence class a type belongs to.
+    /// @throws SymbolNotFoundException if the symbol is not a UDT, enum or typedef of the data source.
+    const TypeEquivalenceClass& getClassOf(DWORD symIndexId) const;
+    const TypeEquivalenceClass& getClassOf(const Symbol& type) const;
+
+    DWORD getCanonicalSymIndexId(DWORD symIndexId) const { return getClassOf(symIndexId).canonicalSymIndexId; }
+    size_t getClassSize(DWORD symIndexId) const { return getClassOf(symIndexId).size(); }
+
+private:
+    std::vector<TypeEquivalenceClass> m_classes{};
+    std::unordered_map<DWORD, size_t> m_classIndexBySymIndexId{};
+};
+
+}  // namespace dia
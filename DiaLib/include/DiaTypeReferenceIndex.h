@@ -0,0 +1,80 @@
+#pragma once
+#include "DiaSymbol.h"
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+struct TypeEquivalenceClass;
+
+enum class TypeReferenceKind : uint8_t
+{
+    /// @brief A data member, base class, global or typedef of the type itself.
+    ByValue,
+    /// @brief Through a pointer or a reference, including pointers to arrays and the signatures of function pointers.
+    ByPointer,
+    /// @brief An array of the type itself.
+    ArrayElement,
+    /// @brief An argument of a function.
+    Argument,
+    /// @brief The return type of a function.
+    Return,
+};
+
+struct TypeReference
+{
+    /// @brief The UDT, typedef, function or global which refers to the type.
+    DWORD referrerSymIndexId;
+    TypeReferenceKind kind;
+};
+
+/// @brief The inverted index of type references of a data source, i.e. for each type, the symbols which embed or point to it.
+/// It is built in a single pass over the data members and base classes of every UDT, the typedefs, the signatures of the functions and the
+/// global variables, after which finding the users of a type is a lookup. Referenced types are recorded once their pointer, array and modifier
+/// layers are stripped. Unnamed UDTs are referrers like any other UDT, so looking them up in turn gives the types which contain them.
+class TypeReferenceIndex
+{
+public:
+    /// @brief The references to a single type.
+    class ReferenceRange
+    {
+    public:
+        ReferenceRange(const TypeReference* first, const TypeReference* last)
+            : m_first{first}
+            , m_last{last}
+        {
+        }
+
+        const TypeReference* begin() const { return m_first; }
+        const TypeReference* end() const { return m_last; }
+        size_t size() const { return m_last - m_first; }
+        bool empty() const { return m_first == m_last; }
+
+    private:
+        const TypeReference* m_first;
+        const TypeReference* m_last;
+    };
+
+    explicit TypeReferenceIndex(const DataSource& dataSource);
+
+    size_t getReferencedTypeCount() const { return m_rangeBySymIndexId.size(); }
+    size_t getReferenceCount() const { return m_references.size(); }
+
+    /// @return The references to exactly this symbol, ordered by referrer, or an empty range if nothing refers to it.
+    ReferenceRange getReferencesTo(DWORD symIndexId) const;
+    ReferenceRange getReferencesTo(const Symbol& type) const;
+
+    /// @brief Get the references to any member of an equivalence class, e.g. both to a forward declaration and to its definition.
+    /// @return The references ordered by referrer, without duplicates.
+    std::vector<TypeReference> getReferencesTo(const TypeEquivalenceClass& equivalenceClass) const;
+
+private:
+    std::vector<TypeReference> m_references{};
+    /// @brief The references to a type are m_references[first] to m_references[second].
+    std::unordered_map<DWORD, std::pair<uint32_t, uint32_t>> m_rangeBySymIndexId{};
+};
+
+}  // namespace dia
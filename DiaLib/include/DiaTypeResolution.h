@@ -1,9 +1,13 @@
 #pragma once
 #include "DiaSymbol.h"
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace dia
 {
+class FunctionType;
+
 /// @brief Resolves a symbol to its full type name
 /// @param symbol The symbol to resolve
 /// @return A string which represents the closest match to the original "C type"
@@ -11,8 +15,43 @@ namespace dia
 std::wstring resolveTypeName(const Symbol& symbol);
 std::wstring resolveBaseTypeName(const Symbol& symbol);
 
+/// @brief Resolves type names like `resolveTypeName`, remembering every name it resolves.
+/// Names are cached by symIndexId, including the names of the pointer, array, typedef and function types they are made of, so every distinct
+/// type is resolved exactly once. Identical names are interned, and each name is assembled in a single buffer rather than by concatenating the
+/// names of its parts. An instance must only ever be used with symbols from a single session.
+class TypeNameResolver
+{
+public:
+    TypeNameResolver() = default;
+
+    /// @brief Resolves a symbol to its full type name.
+    /// @return A reference to the interned name, which stays valid until `clear` is called or the resolver is destroyed.
+    const std::wstring& resolve(const Symbol& symbol);
+
+    size_t getResolvedTypeCount() const { return m_nameBySymIndexId.size(); }
+    size_t getInternedNameCount() const { return m_internedNames.size(); }
+
+    /// @brief Forget all cached names.
+    void clear();
+
+private:
+    void appendTypeName(const Symbol& symbol, std::wstring& name);
+    void appendUncachedTypeName(const Symbol& symbol, std::wstring& name);
+    void appendFunctionTypeName(const FunctionType& funcTypeSymbol, bool withCallingConvention, std::wstring& name);
+    const std::wstring& intern(std::wstring&& name);
+
+    // Elements of an unordered_set are never moved, so the cache can point into it.
+    std::unordered_set<std::wstring> m_internedNames{};
+    std::unordered_map<DWORD, const std::wstring*> m_nameBySymIndexId{};
+};
+
 std::wstring symTagToName(const enum SymTagEnum v);
 std::wstring locationTypeToName(const enum LocationType v);
+/// @brief Like `symTagToName` and `locationTypeToName`, without copying the name out of its static storage.
+const wchar_t* symTagToStaticName(const enum SymTagEnum v);
+const wchar_t* locationTypeToStaticName(const enum LocationType v);
+/// @brief Returns the name of the kind of a UDT: "struct", "class", "union", "interface" or "tagged-union".
+const wchar_t* udtKindToStaticName(const enum UdtKind v);
 /// @brief Returns the string name of the CvCall value
 /// @param v A calling convention value from the enum.
 /// @return A string version of the name from the enum.
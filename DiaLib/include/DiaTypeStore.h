@@ -0,0 +1,116 @@
+#pragma once
+#include <atlbase.h>
+#include <cstdint>
+#include <dia2.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dia
+{
+class DataSource;
+
+/// @brief A member of a stored type: a data member, a base class, a member function or a nested type.
+/// For enums, only the name and the value are meaningful.
+struct StoredMember
+{
+    /// @brief SymTagData for data members and enumerators, SymTagBaseClass, SymTagFunction, or the tag of a nested type.
+    enum SymTagEnum symTag { SymTagData };
+    std::wstring name{};
+    /// @brief The type of a data member or base class, the signature of a member function, the aliased type of a nested typedef.
+    std::wstring typeName{};
+    LONG offset{0};
+    ULONGLONG size{0};
+    DWORD bitPosition{0};
+    LONGLONG value{0};
+    /// @brief The CV_access_e of the member, 0 for the members which have none.
+    DWORD access{0};
+    bool isStatic{false};
+    /// @brief For base classes, whether the base is virtual. For member functions, whether the function is.
+    bool isVirtual{false};
+};
+
+/// @brief A UDT, enum or typedef as kept in a TypeStore: its layout, without anything tying it to a particular PDB.
+struct StoredType
+{
+    uint64_t structuralHash{0};
+    /// @brief The structural hash seeded with CONFIRMING_STRUCTURAL_HASH_SEED, which widens the key of the type to 128 bits.
+    uint64_t confirmingHash{0};
+    enum SymTagEnum symTag { SymTagNull };
+    std::wstring name{};
+    ULONGLONG length{0};
+    /// @brief For typedefs, the name of the aliased type.
+    std::wstring typeName{};
+    /// @brief Everything the structural hash of the type is made of, in declaration order. The qualifiers of member functions other than
+    /// static and virtual (pure, introducing), and the indirection of virtual base classes, are only covered by the hashes.
+    std::vector<StoredMember> members{};
+};
+
+/// @brief A content-addressed, single-file store of the types of many builds.
+/// Each type definition is keyed by its structural hash (see StructuralHasher) and written exactly once, no matter how many builds contain it. A
+/// build only records the hashes of its types, so ingesting a build whose types are mostly unchanged writes little more than that list.
+/// A type is only considered stored already when its confirming hash matches as well, so a collision of the 64-bit keys is never mistaken for
+/// the same type.
+/// The file is append-only: records which were only partially written (e.g. because the process died mid-write) are discarded when the store is
+/// opened. Only the index is kept in memory, type definitions are read from the file on demand.
+class TypeStore final
+{
+public:
+    /// @brief Open a store, creating it if it does not exist yet.
+    /// @throws InvalidFileFormatException if the file is not a type store, or was written with another STABLE_HASH_VERSION.
+    explicit TypeStore(const std::wstring& storeFilePath);
+
+    TypeStore(const TypeStore&)            = delete;
+    TypeStore& operator=(const TypeStore&) = delete;
+
+    /// @brief Add all the types of a build to the store.
+    /// Structurally identical types of the build are stored once (see TypeEquivalenceClasses).
+    /// @param buildName A unique name for the build, e.g. the path or the signature of its PDB.
+    /// @param dataSource The data source of the build.
+    /// @return The number of type definitions which were new to the store.
+    /// @throws InvalidUsageException if a build with the same name was already ingested.
+    /// @throws HashCollisionException if a type of the build has the structural hash of a different stored type. The types written before
+    /// the collision stay in the store, but the build is not recorded.
+    size_t ingest(const std::wstring& buildName, const DataSource& dataSource);
+
+    bool containsType(uint64_t structuralHash) const;
+
+    /// @brief Read a type definition back from the store.
+    /// @throws SymbolNotFoundException if no type with the given hash is stored.
+    StoredType getType(uint64_t structuralHash) const;
+
+    bool containsBuild(const std::wstring& buildName) const;
+
+    /// @return The names of all the ingested builds, in ingestion order.
+    const std::vector<std::wstring>& getBuilds() const { return m_buildNames; }
+
+    /// @return The structural hashes of the types of a build.
+    /// @throws SymbolNotFoundException if no build with the given name was ingested.
+    const std::vector<uint64_t>& getBuildTypes(const std::wstring& buildName) const;
+
+    /// @return The names of the builds which contain the exact type with the given hash, in ingestion order.
+    std::vector<std::wstring> getBuildsContaining(uint64_t structuralHash) const;
+
+private:
+    struct TypeLocation
+    {
+        LONGLONG fileOffset;
+        uint32_t recordSize;
+        uint64_t confirmingHash;
+    };
+
+    void load();
+    void appendRecord(uint32_t recordKind, const std::vector<uint8_t>& payload);
+    void addBuild(const std::wstring& buildName, std::vector<uint64_t>&& typeHashes);
+
+    ATL::CHandle m_file{};
+    LONGLONG m_endOfFile{0};
+
+    std::unordered_map<uint64_t, TypeLocation> m_typeLocations{};
+    std::vector<std::wstring> m_buildNames{};
+    std::vector<std::vector<uint64_t>> m_buildTypes{};
+    std::unordered_map<std::wstring, size_t> m_buildIndexByName{};
+    std::unordered_map<uint64_t, std::vector<size_t>> m_buildIndicesByType{};
+};
+
+}  // namespace dia
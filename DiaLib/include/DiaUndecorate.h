@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dia
+{
+/// @brief Options of `undecorateName`. They have the values of the UNDNAME_* flags of `getUndecoratedNameEx` (and UnDecorateSymbolName),
+/// so either can be passed. The flags about the allocation model, UDT return models, 32-bit decoding, template parameters and identifier
+/// characters are accepted but change nothing, as they only matter to 16-bit names or to names which are not MSVC decorated names.
+constexpr uint32_t UNDECORATE_COMPLETE               = 0x00000;
+constexpr uint32_t UNDECORATE_NO_LEADING_UNDERSCORES = 0x00001;
+constexpr uint32_t UNDECORATE_NO_MS_KEYWORDS         = 0x00002;
+constexpr uint32_t UNDECORATE_NO_FUNCTION_RETURNS    = 0x00004;
+constexpr uint32_t UNDECORATE_NO_ALLOCATION_LANGUAGE = 0x00010;
+constexpr uint32_t UNDECORATE_NO_THISTYPE            = 0x00060;
+constexpr uint32_t UNDECORATE_NO_ACCESS_SPECIFIERS   = 0x00080;
+constexpr uint32_t UNDECORATE_NO_THROW_SIGNATURES    = 0x00100;
+constexpr uint32_t UNDECORATE_NO_MEMBER_TYPE         = 0x00200;
+constexpr uint32_t UNDECORATE_NAME_ONLY              = 0x01000;
+constexpr uint32_t UNDECORATE_TYPE_ONLY              = 0x02000;
+constexpr uint32_t UNDECORATE_NO_ECSU                = 0x08000;
+constexpr uint32_t UNDECORATE_NO_PTR64               = 0x20000;
+
+/// @brief Undecorate an MSVC decorated (mangled) name, e.g. "?get@Foo@@QEBAHXZ" to "public: int __cdecl Foo::get(void)const __ptr64".
+/// This is the same undecoration as `getUndecoratedNameEx`, but it is done natively: it needs neither a DIA session nor DbgHelp, and it is
+/// thread safe. With `UNDECORATE_TYPE_ONLY`, the name is a type encoding instead, like the raw names of type_info (".?AVFoo@@").
+/// @param flags A combination of the UNDECORATE_* flags.
+/// @return The undecorated name, or the name itself if it is not decorated (e.g. the name of a C function) or cannot be undecorated (e.g. if
+/// it nests types or templates too deeply).
+std::string undecorateName(const std::string& decoratedName, uint32_t flags = UNDECORATE_COMPLETE);
+
+/// @brief Undecorate an MSVC decorated name given as UTF-16 (see the UTF-8 overload).
+std::wstring undecorateName(const std::wstring& decoratedName, uint32_t flags = UNDECORATE_COMPLETE);
+
+/// @brief Undecorate many names (e.g. every public symbol of a PDB), spread across worker threads.
+/// @param workerCount Number of worker threads. 0 uses one per hardware thread, 1 undecorates on the calling thread.
+/// @return The undecorated names, in the order of `decoratedNames`.
+std::vector<std::string> undecorateNames(const std::vector<std::string>& decoratedNames, uint32_t flags = UNDECORATE_COMPLETE,
+                                         size_t workerCount = 0);
+
+}  // namespace dia
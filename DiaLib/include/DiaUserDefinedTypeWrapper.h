@@ -1,5 +1,6 @@
 #pragma once
 #include "AnyString.h"
+#include "DiaStructLayout.h"
 #include "SymbolTypes/DiaUDT.h"
 #include <set>
 
@@ -24,6 +25,9 @@ public:
 
     Data getMember(const AnyString& memberName) const;
 
+    /// @brief Compute the layout of the UDT, with its padding and the fields which straddle cache lines (see `StructLayoutAnalyzer`).
+    StructLayout analyzeLayout(ULONGLONG cacheLineSize = DEFAULT_CACHE_LINE_SIZE) const;
+
     // Iterator-related methods
     auto begin() const { return enumerateMembers().begin(); }
 
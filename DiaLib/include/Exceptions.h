@@ -115,6 +115,8 @@ DEFINE_TRIVIAL_EXCEPTION(TooManyMatchesForFindException);
 DEFINE_TRIVIAL_EXCEPTION(DataMemberDataKindMismatchException);
 DEFINE_TRIVIAL_EXCEPTION(InvalidFileFormatException);
 DEFINE_TRIVIAL_EXCEPTION(UnimplementedException);
+DEFINE_TRIVIAL_EXCEPTION(MemoryNotInDumpException);
+DEFINE_TRIVIAL_EXCEPTION(HashCollisionException);
 
 class InvalidUsageException : public std::logic_error
 {
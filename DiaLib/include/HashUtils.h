@@ -1,14 +1,222 @@
 #pragma once
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
 #include <type_traits>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace dia
+{
+/// @brief Version of the StableHasher algorithm. Every change to the hashes it produces (including the way hash_combine feeds values into
+/// it) must bump this, since persisted hashes from different versions are not comparable.
+constexpr uint32_t STABLE_HASH_VERSION = 1;
+
+/// @brief A 128-bit hash value.
+struct Hash128
+{
+    uint64_t low{0};
+    uint64_t high{0};
+
+    bool operator==(const Hash128& other) const { return low == other.low && high == other.high; }
+    bool operator!=(const Hash128& other) const { return !(*this == other); }
+};
+
+/// @brief Streaming 64/128-bit hasher in the spirit of wyhash.
+/// Unlike std::hash, the result depends only on the bytes fed into it: integers are widened to 64 bits, strings are hashed as their UTF-16
+/// code units, and everything is read in little-endian order. Hashes are therefore identical across toolchains, bitnesses and machines, and
+/// only change when STABLE_HASH_VERSION does.
+class StableHasher
+{
+public:
+    explicit StableHasher(uint64_t seed = 0) noexcept
+        : m_lanes{multiplyFold(seed ^ SECRET0, SECRET1 ^ STABLE_HASH_VERSION), multiplyFold(seed ^ SECRET2, SECRET3 ^ STABLE_HASH_VERSION)}
+    {
+    }
+
+    /// @brief Feed raw bytes into the hash.
+    StableHasher& update(const void* data, size_t size) noexcept
+    {
+        if (0 == size)
+        {
+            return *this;
+        }
+
+        auto bytes = static_cast<const uint8_t*>(data);
+        m_totalSize += size;
+        if (0 != m_bufferSize)
+        {
+            const auto copiedSize = (std::min)(size, BLOCK_SIZE - m_bufferSize);
+            memcpy(m_buffer + m_bufferSize, bytes, copiedSize);
+            m_bufferSize += copiedSize;
+            bytes += copiedSize;
+            size -= copiedSize;
+            if (BLOCK_SIZE != m_bufferSize)
+            {
+                return *this;
+            }
+            consumeBlock(m_lanes, m_buffer);
+            m_bufferSize = 0;
+        }
+
+        // Long inputs (names, mostly) are consumed straight from the source, without going through the buffer.
+        for (; size >= BLOCK_SIZE; bytes += BLOCK_SIZE, size -= BLOCK_SIZE)
+        {
+            consumeBlock(m_lanes, bytes);
+        }
+        memcpy(m_buffer, bytes, size);
+        m_bufferSize = size;
+        return *this;
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value, StableHasher&> add(T value) noexcept
+    {
+        const uint64_t word = widen(value);
+        return update(&word, sizeof(word));
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_floating_point<T>::value, StableHasher&> add(T value) noexcept
+    {
+        // Widen to double and fold -0.0 into 0.0, so that values which compare equal hash equally.
+        const double widenedValue = (0 == value) ? 0.0 : static_cast<double>(value);
+        uint64_t word             = 0;
+        memcpy(&word, &widenedValue, sizeof(word));
+        return update(&word, sizeof(word));
+    }
+
+    StableHasher& add(const wchar_t* string, size_t length) noexcept
+    {
+        static_assert(2 == sizeof(wchar_t), "Strings are hashed as UTF-16 code units");
+        add(static_cast<uint64_t>(length));
+        return update(string, length * sizeof(wchar_t));
+    }
+
+    StableHasher& add(const std::wstring& string) noexcept { return add(string.data(), string.length()); }
+
+    /// @return The 64-bit hash of everything fed so far. The hasher may keep being fed afterwards.
+    uint64_t digest64() const noexcept { return digest128().low; }
+
+    /// @return The 128-bit hash of everything fed so far. The hasher may keep being fed afterwards.
+    Hash128 digest128() const noexcept
+    {
+        uint8_t lastBlock[BLOCK_SIZE] = {};
+        memcpy(lastBlock, m_buffer, m_bufferSize);
+        uint64_t lanes[2] = {m_lanes[0], m_lanes[1]};
+        consumeBlock(lanes, lastBlock);
+
+        const uint64_t low  = multiplyFold(lanes[0] ^ SECRET0 ^ m_totalSize, lanes[1] ^ SECRET1);
+        const uint64_t high = multiplyFold(lanes[1] ^ SECRET2 ^ m_totalSize, lanes[0] ^ SECRET3);
+        return {multiplyFold(low ^ SECRET3, high ^ SECRET0), multiplyFold(high ^ SECRET1, low ^ SECRET2)};
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 32;
+
+    static constexpr uint64_t SECRET0  = 0xa0761d6478bd642full;
+    static constexpr uint64_t SECRET1  = 0xe7037ed1a0b428dbull;
+    static constexpr uint64_t SECRET2  = 0x8ebc6af09c88c6e3ull;
+    static constexpr uint64_t SECRET3  = 0x589965cc75374cc3ull;
+
+    /// @brief Multiply into 128 bits and fold the halves together.
+    static uint64_t multiplyFold(uint64_t a, uint64_t b) noexcept
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+        uint64_t high      = 0;
+        const uint64_t low = _umul128(a, b, &high);
+        return low ^ high;
+#elif defined(__SIZEOF_INT128__)
+        const auto product = static_cast<unsigned __int128>(a) * b;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+        const uint64_t lowLow   = (a & 0xffffffff) * (b & 0xffffffff);
+        const uint64_t lowHigh  = (a & 0xffffffff) * (b >> 32);
+        const uint64_t highLow  = (a >> 32) * (b & 0xffffffff);
+        const uint64_t highHigh = (a >> 32) * (b >> 32);
+        const uint64_t cross    = (lowLow >> 32) + (lowHigh & 0xffffffff) + highLow;
+        const uint64_t high     = highHigh + (lowHigh >> 32) + (cross >> 32);
+        const uint64_t low      = (cross << 32) | (lowLow & 0xffffffff);
+        return low ^ high;
+#endif
+    }
+
+    /// @brief Windows only runs on little-endian machines, so a plain load reads the little-endian word.
+    static uint64_t read64(const uint8_t* bytes) noexcept
+    {
+        uint64_t word = 0;
+        memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+
+    static void consumeBlock(uint64_t (&lanes)[2], const uint8_t* block) noexcept
+    {
+        lanes[0] = multiplyFold(read64(block) ^ SECRET1, read64(block + 8) ^ lanes[0]);
+        lanes[1] = multiplyFold(read64(block + 16) ^ SECRET2, read64(block + 24) ^ lanes[1]);
+    }
+
+    template <typename T>
+    static std::enable_if_t<std::is_enum<T>::value, uint64_t> widen(T value) noexcept
+    {
+        return widen(static_cast<std::underlying_type_t<T>>(value));
+    }
+
+    template <typename T>
+    static std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, uint64_t> widen(T value) noexcept
+    {
+        return static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+
+    template <typename T>
+    static std::enable_if_t<std::is_integral<T>::value && !std::is_signed<T>::value, uint64_t> widen(T value) noexcept
+    {
+        return static_cast<uint64_t>(value);
+    }
+
+    uint64_t m_lanes[2];
+    uint8_t m_buffer[BLOCK_SIZE] = {};
+    size_t m_bufferSize{0};
+    uint64_t m_totalSize{0};
+};
+
+namespace detail
+{
+// Values the hasher knows how to serialize are fed to it directly, everything else (symbols, VARIANTs, ...) is fed its std::hash, which
+// for every type of this library is itself built on StableHasher.
+template <typename T>
+inline auto appendStableHash(StableHasher& hasher, const T& value, int) -> decltype(hasher.add(value), void())
+{
+    hasher.add(value);
+}
+
+template <typename T>
+inline void appendStableHash(StableHasher& hasher, const T& value, long)
+{
+    hasher.add(static_cast<uint64_t>(std::hash<T>{}(value)));
+}
+}  // namespace detail
+}  // namespace dia
+
+inline void hash_append(dia::StableHasher& hasher) {}
+
+/// @brief Feed values into a StableHasher, e.g. to calculate a 128-bit hash with digest128().
+template <typename T, typename... Rest>
+inline void hash_append(dia::StableHasher& hasher, const T& v, const Rest&... rest)
+{
+    dia::detail::appendStableHash(hasher, v, 0);
+    hash_append(hasher, rest...);
+}
 
 inline void hash_combine(std::size_t& seed) {}
 
 template <typename T, typename... Rest>
-inline void hash_combine(std::size_t& seed, const T& v, Rest... rest)
+inline void hash_combine(std::size_t& seed, const T& v, const Rest&... rest)
 {
-    std::hash<T> hasher;
-    seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-    hash_combine(seed, rest...);
+    dia::StableHasher hasher{seed};
+    hash_append(hasher, v, rest...);
+    seed = static_cast<std::size_t>(hasher.digest64());
 }
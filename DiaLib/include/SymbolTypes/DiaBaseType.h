@@ -30,13 +30,7 @@ namespace std
 template <>
 struct hash<dia::BaseType>
 {
-    size_t operator()(const dia::BaseType& v) const
-    {
-        size_t calculatedHash = 0;
-        hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getBaseType(), v.getConstType(), v.getLength(),
-                     v.getLexicalParentId(), v.getUnalignedType(), v.getVolatileType());
-        return calculatedHash;
-    }
+    size_t operator()(const dia::BaseType& v) const;
 };
 }  // namespace std
 
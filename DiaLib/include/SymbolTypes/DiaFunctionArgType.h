@@ -32,12 +32,6 @@ namespace std
 template <>
 struct hash<dia::FunctionArgType>
 {
-    size_t operator()(const dia::FunctionArgType& v) const
-    {
-        size_t calculatedHash = 0;
-        hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getType());
-
-        return calculatedHash;
-    }
+    size_t operator()(const dia::FunctionArgType& v) const;
 };
 }  // namespace std
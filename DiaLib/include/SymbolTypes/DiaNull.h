@@ -1,6 +1,7 @@
 #pragma once
 #include "DiaSymbol.h"
 #include "DiaSymbolTypes.h"
+#include "DiaTypeResolution.h"
 
 namespace dia
 {
@@ -18,7 +19,13 @@ namespace std
 template <>
 struct hash<dia::Null>
 {
-    size_t operator()(const dia::Null& diaNull) const { throw std::runtime_error("Hashing for type dia::Null has not yet been implemented!"); }
+    size_t operator()(const dia::Null& diaNull) const
+    {
+        // Symbols without a tag carry no content, so all of them hash identically.
+        size_t calculatedHash = 0;
+        hash_combine(calculatedHash, std::wstring(dia::symTagToName(SymTagNull)));
+        return calculatedHash;
+    }
 };
 }  // namespace std
 
@@ -0,0 +1,41 @@
+#pragma once
+#include "DiaSymbol.h"
+#include "DiaSymbolTypes.h"
+
+/// @brief The symbol types which have no properties of their own here. Their properties are read through the functions of DiaSymbolFuncs.h.
+#define XFOR_TRIVIAL_DIA_SYMBOL_TYPE(opperation)                                                                                                     \
+    opperation(BaseClass);                                                                                                                           \
+    opperation(BaseInterface);                                                                                                                       \
+    opperation(Callee);                                                                                                                              \
+    opperation(Caller);                                                                                                                              \
+    opperation(CallSite);                                                                                                                            \
+    opperation(CoffGroup);                                                                                                                           \
+    opperation(CompilandDetails);                                                                                                                    \
+    opperation(CompilandEnv);                                                                                                                        \
+    opperation(Custom);                                                                                                                              \
+    opperation(CustomType);                                                                                                                          \
+    opperation(Dimension);                                                                                                                           \
+    opperation(Export);                                                                                                                              \
+    opperation(Friend);                                                                                                                              \
+    opperation(HeapAllocationSite);                                                                                                                  \
+    opperation(HLSLType);                                                                                                                            \
+    opperation(Inlinee);                                                                                                                             \
+    opperation(InlineSite);                                                                                                                          \
+    opperation(Label);                                                                                                                               \
+    opperation(ManagedType);                                                                                                                         \
+    opperation(MatrixType);                                                                                                                          \
+    opperation(TaggedUnionCase);                                                                                                                     \
+    opperation(Thunk);                                                                                                                               \
+    opperation(VectorType);
+
+namespace dia
+{
+#define __DEFINE_TRIVIAL_DIA_SYMBOL_TYPE_CLASS(className)                                                                                            \
+    class className : public Symbol                                                                                                                  \
+    {                                                                                                                                                \
+    public:                                                                                                                                          \
+        using Symbol::Symbol;                                                                                                                        \
+        USING_BASE_OPERATORS(Symbol);                                                                                                                \
+    };
+XFOR_TRIVIAL_DIA_SYMBOL_TYPE(__DEFINE_TRIVIAL_DIA_SYMBOL_TYPE_CLASS);
+}  // namespace dia
@@ -47,15 +47,7 @@ namespace std
 template <>
 struct hash<dia::Typedef>
 {
-    size_t operator()(const dia::Typedef& v) const
-    {
-        size_t calculatedHash = 0;
-        hash_combine(calculatedHash, std::wstring(dia::symTagToName(v.getSymTag())), v.getBaseType(), v.getConstructor(), v.getConstType(),
-                     v.getHasAssignmentOperator(), v.getHasCastOperator(), v.getHasNestedTypes(), v.getLength(), v.getLexicalParentId(), v.getName(),
-                     v.getNested(), v.getOverloadedOperator(), v.getPacked(), v.getReference(), v.getScoped(), v.getType(), v.getUdtKind(),
-                     v.getUnalignedType(), v.getVirtualTableShape(), v.getVolatileType());
-        return calculatedHash;
-    }
+    size_t operator()(const dia::Typedef& v) const;
 };
 }  // namespace std
 
@@ -0,0 +1,9 @@
+#pragma once
+#include <atlbase.h>
+
+namespace dia
+{
+/// @brief Convert the value of a constant (e.g. an enum value) to an integer.
+/// @return The value, or 0 if the VARIANT does not hold an integer.
+LONGLONG variantToInteger(const VARIANT& variantValue);
+}  // namespace dia
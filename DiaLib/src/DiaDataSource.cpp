@@ -2,6 +2,7 @@
 //
 #include "BstrWrapper.h"
 #include "DiaDataSource.h"
+#include "DiaHashing.h"
 #include "DiaSymbolEnumerator.h"
 #include "DiaUserDefinedTypeWrapper.h"
 #include "Exceptions.h"
@@ -72,12 +73,17 @@ void DataSource::loadDataForExe(const AnyString& exePath)
 
 const std::wstring DataSource::getLoadedPdbFile() const { return getGlobalScope().getSymbolsFileName(); }
 
+size_t DataSource::calcHash(const Symbol& symbol) const
+{
+    return calcSymbolHash(symbol, m_structuralHasher);
+}
+
 Symbol DataSource::getSymbolByHash(size_t symbolHash) const
 {
     auto allSymbols = getSymbols(SymTagNull);
     for (const auto& symbol : allSymbols)
     {
-        if (symbol.calcHash() == symbolHash)
+        if (calcHash(symbol) == symbolHash)
         {
             return symbol;
         }
@@ -85,6 +91,8 @@ Symbol DataSource::getSymbolByHash(size_t symbolHash) const
     throw dia::SymbolNotFoundException("No symbol was found matching the given hash!");
 }
 
+Symbol DataSource::getSymbolById(DWORD symIndexId) const { return m_session.getSymbolById(symIndexId); }
+
 DiaSymbolEnumerator<Symbol> DataSource::getExports() const { return m_session.getExports(); }
 
 template <typename T>
@@ -229,6 +237,12 @@ void DataSource::openSession()
 {
     const auto result = m_comPtr->openSession(&m_session.makeFromRaw());
     CHECK_DIACOM_EXCEPTION("Failed to open IDiaSession!", result);
+    // The caches are keyed by symIndexIds, which only mean something within the session they come from.
+    m_typeNameResolver.clear();
+    m_utf8Names.clear();
+    m_fieldPathResolver.clear();
+    m_decodePlans.clear();
+    m_structuralHasher.clear();
 }
 
 void DataSource::loadDataFromArbitraryFile(const std::wstring& filePath)
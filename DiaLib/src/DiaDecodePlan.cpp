@@ -0,0 +1,300 @@
+#include "pch.h"
+//
+#include "DiaDecodePlan.h"
+#include "DiaHashing.h"
+#include "DiaSymbolEnumerator.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <cstring>
+
+namespace dia
+{
+namespace
+{
+const wchar_t VTABLE_POINTER_NAME[] = L"__vfptr";
+
+Symbol stripTypedefs(Symbol type)
+{
+    while (SymTagTypedef == getSymTag(type))
+    {
+        type = getType(type);
+    }
+    return type;
+}
+
+DecodeKind baseTypeToDecodeKind(enum BasicType baseType)
+{
+    switch (baseType)
+    {
+    case btChar:
+    case btInt:
+    case btLong:
+    case btHresult:
+        return DecodeKind::Signed;
+    case btUInt:
+    case btULong:
+    case btWChar:
+    case btChar8:
+    case btChar16:
+    case btChar32:
+        return DecodeKind::Unsigned;
+    case btBool:
+        return DecodeKind::Bool;
+    case btFloat:
+        return DecodeKind::Float;
+    default:
+        return DecodeKind::Bytes;
+    }
+}
+
+DecodeKind getScalarDecodeKind(const Symbol& type)
+{
+    switch (getSymTag(type))
+    {
+    case SymTagBaseType:
+        return baseTypeToDecodeKind(getBaseType(type));
+    case SymTagPointerType:
+        return DecodeKind::Unsigned;
+    case SymTagEnum:
+        return (DecodeKind::Signed == baseTypeToDecodeKind(getBaseType(getType(type)))) ? DecodeKind::Signed : DecodeKind::Unsigned;
+    default:
+        return DecodeKind::Bytes;
+    }
+}
+
+bool isCharacterType(const Symbol& type)
+{
+    if (SymTagBaseType != getSymTag(type))
+    {
+        return false;
+    }
+    const auto baseType = getBaseType(type);
+    return btChar == baseType || btChar8 == baseType;
+}
+template <typename Storage>
+void gatherStorageUnits(const uint8_t* fields, size_t count, ULONGLONG stride, ULONGLONG* values)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        Storage storage;
+        memcpy(&storage, fields + i * stride, sizeof(storage));
+        values[i] = storage;
+    }
+}
+}  // namespace
+
+ULONGLONG readUnsigned(const DecodeOp& op, const uint8_t* element)
+{
+    ULONGLONG value = 0;
+    memcpy(&value, element, static_cast<size_t>((std::min)(op.width, ULONGLONG{sizeof(value)})));
+    if (op.isBitfield())
+    {
+        value = (value >> op.bitPosition) & op.bitMask;
+    }
+    return value;
+}
+
+LONGLONG readSigned(const DecodeOp& op, const uint8_t* element)
+{
+    const auto value    = readUnsigned(op, element);
+    const auto bitCount = op.isBitfield() ? ULONGLONG{op.bitLength} : 8 * op.width;
+    if (0 == bitCount || 64 <= bitCount)
+    {
+        return static_cast<LONGLONG>(value);
+    }
+    const auto signBit = 1ull << (bitCount - 1);
+    return static_cast<LONGLONG>((value ^ signBit) - signBit);
+}
+
+double readFloat(const DecodeOp& op, const uint8_t* element)
+{
+    if (sizeof(float) == op.width)
+    {
+        float value = 0;
+        memcpy(&value, element, sizeof(value));
+        return value;
+    }
+    double value = 0;
+    memcpy(&value, element, sizeof(value));
+    return value;
+}
+
+DecodeOp makeIntegerDecodeOp(const FieldPath& fieldPath)
+{
+    DecodeOp op{};
+    op.offset = fieldPath.offset;
+    op.width  = fieldPath.size;
+    op.kind   = getScalarDecodeKind(stripTypedefs(fieldPath.type));
+    if (DecodeKind::Bool == op.kind)
+    {
+        op.kind = DecodeKind::Unsigned;
+    }
+    if ((DecodeKind::Signed != op.kind && DecodeKind::Unsigned != op.kind) || 0 == op.width || sizeof(ULONGLONG) < op.width)
+    {
+        throw InvalidUsageException("Only integer fields of up to 64 bits can be extracted!");
+    }
+    if (fieldPath.isBitfield)
+    {
+        op.bitPosition = fieldPath.bitPosition;
+        op.bitLength   = static_cast<DWORD>(fieldPath.bitLength);
+        op.bitMask     = (64 <= op.bitLength) ? ~0ull : (1ull << op.bitLength) - 1;
+    }
+    return op;
+}
+
+void extractIntegers(const DecodeOp& op, const uint8_t* instances, size_t count, ULONGLONG stride, ULONGLONG* values)
+{
+    if ((DecodeKind::Signed != op.kind && DecodeKind::Unsigned != op.kind) || 0 == op.width || sizeof(ULONGLONG) < op.width || op.isArray())
+    {
+        throw InvalidUsageException("Only integer fields of up to 64 bits can be extracted!");
+    }
+
+    const auto fields = instances + op.offset;
+    switch (op.width)
+    {
+    case sizeof(uint8_t):
+        gatherStorageUnits<uint8_t>(fields, count, stride, values);
+        break;
+    case sizeof(uint16_t):
+        gatherStorageUnits<uint16_t>(fields, count, stride, values);
+        break;
+    case sizeof(uint32_t):
+        gatherStorageUnits<uint32_t>(fields, count, stride, values);
+        break;
+    case sizeof(uint64_t):
+        gatherStorageUnits<uint64_t>(fields, count, stride, values);
+        break;
+    default:
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = 0;
+            memcpy(&values[i], fields + i * stride, static_cast<size_t>(op.width));
+        }
+        break;
+    }
+
+    // The shift, mask and sign extension are the same for every value, so these loops are free of branches.
+    if (op.isBitfield())
+    {
+        const auto shift = op.bitPosition;
+        const auto mask  = op.bitMask;
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (values[i] >> shift) & mask;
+        }
+    }
+    const auto bitCount = op.isBitfield() ? ULONGLONG{op.bitLength} : 8 * op.width;
+    if (DecodeKind::Signed == op.kind && 0 != bitCount && 64 > bitCount)
+    {
+        const auto signBit = 1ull << (bitCount - 1);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = (values[i] ^ signBit) - signBit;
+        }
+    }
+}
+
+const DecodePlan& DecodePlanCompiler::compile(const Symbol& udt, Utf8NamePool& names)
+{
+    if (SymTagUDT != getSymTag(udt))
+    {
+        throw InvalidUsageException("Only UDTs can be decoded!");
+    }
+    const auto symIndexId = getSymIndexId(udt);
+    const auto cachedPlan = m_plans.find(symIndexId);
+    if (m_plans.end() != cachedPlan)
+    {
+        return cachedPlan->second;
+    }
+
+    // Nested plans are compiled (and cached) on the way, which never invalidates references into the cache.
+    DecodePlan plan{symIndexId, getLength(udt)};
+    appendOps(udt, 0, names, plan.ops);
+    return m_plans.emplace(symIndexId, std::move(plan)).first->second;
+}
+
+void DecodePlanCompiler::appendOps(const Symbol& udt, ULONGLONG baseOffset, Utf8NamePool& names, std::vector<DecodeOp>& ops)
+{
+    for (const auto& baseClass : enumerate<Symbol>(udt, SymTagBaseClass))
+    {
+        // The offsets of virtual base classes are only known at runtime.
+        if (!getOrDefault(getVirtualBaseClass, baseClass))
+        {
+            appendOps(getType(baseClass), baseOffset + static_cast<ULONGLONG>(getOffset(baseClass)), names, ops);
+        }
+    }
+    for (const auto& vtable : enumerate<Symbol>(udt, SymTagVTable))
+    {
+        DecodeOp op{names.intern(VTABLE_POINTER_NAME, _countof(VTABLE_POINTER_NAME) - 1), DecodeKind::Unsigned};
+        op.offset = baseOffset + static_cast<ULONGLONG>(getOffset(vtable));
+        op.width  = getLength(getType(vtable));
+        ops.push_back(op);
+    }
+
+    for (const auto& member : enumerate<Symbol>(udt, SymTagData))
+    {
+        if (DataIsMember != getOrDefault(getDataKind, member))
+        {
+            continue;
+        }
+        DecodeOp op{names.getNameId(member)};
+        op.offset = baseOffset + static_cast<ULONGLONG>(getOffset(member));
+
+        auto type = stripTypedefs(getType(member));
+        if (SymTagArrayType != getSymTag(type))
+        {
+            setValueKind(type, names, op);
+            if (LocIsBitField == getLocationType(member))
+            {
+                op.bitPosition = getBitPosition(member);
+                op.bitLength   = static_cast<DWORD>(getLength(member));
+                op.bitMask     = (64 <= op.bitLength) ? ~0ull : (1ull << op.bitLength) - 1;
+            }
+            ops.push_back(op);
+            continue;
+        }
+
+        const auto arrayLength = getLength(type);
+        ULONGLONG count        = 1;
+        while (SymTagArrayType == getSymTag(type))
+        {
+            count *= getOrDefault(getCount, type);
+            type = stripTypedefs(getType(type));
+        }
+        setValueKind(type, names, op);
+        // Character arrays are strings, and arrays of raw bytes are raw bytes themselves.
+        if (0 == count || DecodeKind::Bytes == op.kind || isCharacterType(type))
+        {
+            op.kind   = DecodeKind::Bytes;
+            op.width  = arrayLength;
+            op.nested = nullptr;
+        }
+        else
+        {
+            op.count  = count;
+            op.stride = op.width;
+        }
+        ops.push_back(op);
+    }
+}
+
+void DecodePlanCompiler::setValueKind(const Symbol& type, Utf8NamePool& names, DecodeOp& op)
+{
+    op.width = getOrDefault(getLength, type);
+    if (SymTagUDT == getSymTag(type))
+    {
+        op.kind   = DecodeKind::Nested;
+        op.nested = &compile(type, names);
+        return;
+    }
+    op.kind = getScalarDecodeKind(type);
+
+    // Scalars which do not fit a register (or have no size) are left as bytes.
+    const bool isFloatWidth = (sizeof(float) == op.width || sizeof(double) == op.width);
+    if (0 == op.width || sizeof(ULONGLONG) < op.width || (DecodeKind::Float == op.kind && !isFloatWidth))
+    {
+        op.kind = DecodeKind::Bytes;
+    }
+}
+
+}  // namespace dia
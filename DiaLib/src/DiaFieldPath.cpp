@@ -0,0 +1,194 @@
+#include "pch.h"
+//
+#include "DiaFieldPath.h"
+#include "DiaHashing.h"
+#include "DiaSymbolEnumerator.h"
+#include "Exceptions.h"
+#include <vector>
+
+namespace dia
+{
+namespace
+{
+struct PathComponent
+{
+    /// @brief The name of the member, or empty for an index.
+    std::wstring memberName;
+    ULONGLONG index;
+};
+
+std::vector<PathComponent> parseFieldPath(const std::wstring& path)
+{
+    std::vector<PathComponent> components{};
+    size_t position = 0;
+    while (position < path.size())
+    {
+        if (L'[' == path[position])
+        {
+            const auto indexBegin = path.c_str() + position + 1;
+            wchar_t* indexEnd     = nullptr;
+            const auto index      = wcstoull(indexBegin, &indexEnd, 0);
+            if (indexEnd == indexBegin || L']' != *indexEnd || L'-' == *indexBegin)
+            {
+                throw InvalidUsageException("Malformed array index in the field path!");
+            }
+            components.push_back(PathComponent{std::wstring{}, index});
+            position = static_cast<size_t>(indexEnd - path.c_str()) + 1;
+            continue;
+        }
+
+        // A member follows the start of the path, a dot or an index.
+        if (L'.' == path[position])
+        {
+            if (components.empty())
+            {
+                throw InvalidUsageException("A field path cannot start with a dot!");
+            }
+            ++position;
+        }
+        else if (!components.empty())
+        {
+            throw InvalidUsageException("Members of a field path must be separated by dots!");
+        }
+        const auto nameEnd = path.find_first_of(L".[", position);
+        const auto name    = path.substr(position, (std::wstring::npos == nameEnd) ? std::wstring::npos : nameEnd - position);
+        if (name.empty())
+        {
+            throw InvalidUsageException("Empty member name in the field path!");
+        }
+        components.push_back(PathComponent{name, 0});
+        position += name.size();
+    }
+    return components;
+}
+
+Symbol stripTypedefs(Symbol type)
+{
+    while (SymTagTypedef == getSymTag(type))
+    {
+        type = getType(type);
+    }
+    return type;
+}
+
+/// @brief Whether a member is an anonymous union or struct, whose own members are accessed as if they were members of the enclosing UDT.
+bool isAnonymousMemberName(const BstrWrapper& name)
+{
+    const std::wstring memberName(name);
+    return memberName.empty() || L'<' == memberName.front() || 0 == memberName.compare(0, 9, L"__unnamed");
+}
+
+bool isDataMember(const Symbol& member) { return DataIsMember == getOrDefault(getDataKind, member); }
+
+/// @brief Look a member up in a UDT, its anonymous unions and structs, and its base classes.
+/// @param baseOffset The offset of the UDT within the UDT the path starts from.
+/// @return Whether the member was found, in which case `member` and `memberOffset` are set.
+bool findMember(const Symbol& udt, const std::wstring& name, ULONGLONG baseOffset, Symbol& member, ULONGLONG& memberOffset)
+{
+    for (const auto& candidate : enumerate<Symbol>(udt, SymTagData, name.c_str()))
+    {
+        if (isDataMember(candidate))
+        {
+            memberOffset = baseOffset + static_cast<ULONGLONG>(getOffset(candidate));
+            member       = candidate;
+            return true;
+        }
+    }
+
+    for (const auto& candidate : enumerate<Symbol>(udt, SymTagData))
+    {
+        if (!isDataMember(candidate) || !isAnonymousMemberName(getName(candidate)))
+        {
+            continue;
+        }
+        const auto candidateType = stripTypedefs(getType(candidate));
+        if (SymTagUDT == getSymTag(candidateType) &&
+            findMember(candidateType, name, baseOffset + static_cast<ULONGLONG>(getOffset(candidate)), member, memberOffset))
+        {
+            return true;
+        }
+    }
+
+    for (const auto& baseClass : enumerate<Symbol>(udt, SymTagBaseClass))
+    {
+        // The offsets of virtual base classes are only known at runtime.
+        if (!getOrDefault(getVirtualBaseClass, baseClass) &&
+            findMember(getType(baseClass), name, baseOffset + static_cast<ULONGLONG>(getOffset(baseClass)), member, memberOffset))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+FieldPath resolveFieldPath(const Symbol& udt, const std::wstring& path)
+{
+    FieldPath fieldPath{};
+    fieldPath.type = udt;
+    for (const auto& component : parseFieldPath(path))
+    {
+        const auto type = stripTypedefs(fieldPath.type);
+        if (!component.memberName.empty())
+        {
+            if (SymTagUDT != getSymTag(type))
+            {
+                throw InvalidUsageException("Only the members of a UDT can be accessed by a field path!");
+            }
+            Symbol member{};
+            ULONGLONG memberOffset = 0;
+            if (!findMember(type, component.memberName, fieldPath.offset, member, memberOffset))
+            {
+                throw SymbolNotFoundException("A member of the field path cannot be found!");
+            }
+            fieldPath.offset     = memberOffset;
+            fieldPath.type       = getType(member);
+            fieldPath.isBitfield = (LocIsBitField == getLocationType(member));
+            if (fieldPath.isBitfield)
+            {
+                fieldPath.bitPosition = getBitPosition(member);
+                fieldPath.bitLength   = getLength(member);
+            }
+            continue;
+        }
+
+        if (SymTagArrayType != getSymTag(type))
+        {
+            throw InvalidUsageException("Only arrays can be indexed by a field path!");
+        }
+        // Arrays of a single element usually stand for variable sized trailing arrays (ANYSIZE_ARRAY), so they are not bounds checked.
+        const auto elementCount = getOrDefault(getCount, type);
+        if (1 < elementCount && component.index >= elementCount)
+        {
+            throw InvalidUsageException("An index of the field path is out of the bounds of its array!");
+        }
+        const auto elementType = getType(type);
+        fieldPath.offset += component.index * getLength(elementType);
+        fieldPath.type = elementType;
+    }
+    fieldPath.size = getOrDefault(getLength, fieldPath.type);
+    return fieldPath;
+}
+
+const FieldPath& FieldPathResolver::resolve(const Symbol& udt, const std::wstring& path)
+{
+    auto& paths             = m_pathsBySymIndexId[getSymIndexId(udt)];
+    const auto compiledPath = paths.find(path);
+    if (paths.end() != compiledPath)
+    {
+        return compiledPath->second;
+    }
+    return paths.emplace(path, resolveFieldPath(udt, path)).first->second;
+}
+
+size_t FieldPathResolver::getCompiledPathCount() const
+{
+    size_t count = 0;
+    for (const auto& paths : m_pathsBySymIndexId)
+    {
+        count += paths.second.size();
+    }
+    return count;
+}
+
+}  // namespace dia
@@ -0,0 +1,832 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaHashing.h"
+#include "DiaHeaderGenerator.h"
+#include "DiaSymbolEnumerator.h"
+#include "DiaTypeDependencyGraph.h"
+#include "Exceptions.h"
+#include "VariantUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <cwctype>
+#include <future>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace dia
+{
+namespace
+{
+/// @brief Number of types a worker claims at once.
+constexpr size_t HEADER_RENDER_BATCH_SIZE = 64;
+/// @brief The header is handed to the sink in chunks of at least this size.
+constexpr size_t HEADER_WRITER_BUFFER_SIZE = 64 * 1024;
+
+constexpr size_t NOT_DECLARED = SIZE_MAX;
+
+const wchar_t INDENT[] = L"    ";
+
+/// @brief A named UDT or enum of the header. All the symbols of the data source with the same name make up a single declaration.
+/// symIndexIds are assigned by each session, so the symbols to render are addressed by their position in `enumerateTypes` instead, which is the
+/// same in every session of the PDB.
+struct TypeDeclaration
+{
+    /// @brief The name of the type in the PDB.
+    std::wstring name;
+    /// @brief The name of the type in the header: the name itself if it is a plain identifier, otherwise an identifier derived from it.
+    std::wstring identifier;
+    enum SymTagEnum symTag;
+    /// @brief The symbol to render: the definition of a UDT (or one of its forward declarations if it is never defined), the first enum.
+    DWORD symIndexId;
+    /// @brief The position of the symbol to render.
+    size_t typePosition;
+    bool isDefined;
+    /// @brief For enums, the positions of all the enums with this name, whose values are merged.
+    std::vector<size_t> mergedTypePositions;
+    /// @brief The declarations this one depends on, with their strongest edge kind.
+    std::vector<std::pair<size_t, TypeEdgeKind>> dependencies;
+};
+
+/// @brief The names of the declarations in the header.
+struct DeclaredNames
+{
+    /// @brief The identifier of every declaration, by the name of its type in the PDB.
+    std::unordered_map<std::wstring, std::wstring> identifiersByName;
+    /// @brief All the identifiers, which the aliases must not collide with.
+    std::unordered_set<std::wstring> identifiers;
+};
+
+/// @brief The basic types which are only aliased at the top of the header when some declaration uses them.
+struct AliasedBasicTypeUses
+{
+    bool usesHresult{false};
+    bool usesBstr{false};
+};
+
+struct RenderedType
+{
+    std::string forwardDeclaration;
+    std::string definition;
+    AliasedBasicTypeUses aliasedBasicTypeUses;
+};
+
+std::string toUtf8(const std::wstring& text)
+{
+    if (text.empty())
+    {
+        return {};
+    }
+    const auto size = WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    if (0 == size)
+    {
+        throw WinApiException("Failed to convert the header to UTF-8!");
+    }
+    std::string utf8Text(size, '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), &utf8Text[0], size, nullptr, nullptr);
+    return utf8Text;
+}
+
+/// @brief All the UDTs and enums of a session, in the same order in every session of the PDB.
+std::vector<Symbol> enumerateTypes(const DataSource& dataSource)
+{
+    std::vector<Symbol> types{};
+    for (const auto symTag : {SymTagUDT, SymTagEnum})
+    {
+        for (const auto& type : dataSource.getSymbols(symTag))
+        {
+            types.push_back(type);
+        }
+    }
+    return types;
+}
+
+bool isPlainIdentifier(const std::wstring& name)
+{
+    if (name.empty() || iswdigit(name.front()))
+    {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](wchar_t character) { return L'_' == character || iswalnum(character); });
+}
+
+/// @brief Make a plain identifier out of the name of a nested or template type, e.g. `Outer::Inner<int>` becomes `Outer__Inner_int_`.
+std::wstring toIdentifier(const std::wstring& name)
+{
+    std::wstring identifier = (name.empty() || iswdigit(name.front())) ? L"_" + name : name;
+    std::replace_if(identifier.begin(), identifier.end(), [](wchar_t character) { return L'_' != character && !iswalnum(character); }, L'_');
+    return identifier;
+}
+
+/// @brief Whether the type is unnamed, possibly behind typedefs or as the element type of an array. Unnamed types can only be defined inline.
+bool isUnnamedType(const Symbol& type)
+{
+    switch (getSymTag(type))
+    {
+    case SymTagTypedef:
+    case SymTagArrayType:
+        return isUnnamedType(getType(type));
+    case SymTagUDT:
+    case SymTagEnum:
+        return isSymbolUnnamed(type);
+    default:
+        return false;
+    }
+}
+
+/// @brief Note the uses of the basic types aliased at the top of the header by a type which is rendered by its resolved name.
+void noteAliasedBasicTypeUses(const Symbol& type, AliasedBasicTypeUses& uses)
+{
+    switch (getSymTag(type))
+    {
+    case SymTagBaseType:
+        uses.usesHresult = uses.usesHresult || btHresult == getBaseType(type);
+        uses.usesBstr    = uses.usesBstr || btBSTR == getBaseType(type);
+        break;
+    case SymTagTypedef:
+    case SymTagPointerType:
+    case SymTagArrayType:
+        noteAliasedBasicTypeUses(getType(type), uses);
+        break;
+    case SymTagFunctionType:
+        noteAliasedBasicTypeUses(getType(type), uses);
+        for (const auto& argument : enumerate<Symbol>(type, SymTagFunctionArgType))
+        {
+            noteAliasedBasicTypeUses(getType(argument), uses);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/// @brief The C++ keyword declaring a UDT. Unlike `udtKindToStaticName`, interfaces and tagged unions are declared as structs and unions.
+const wchar_t* udtKindToCppKeyword(enum UdtKind udtKind)
+{
+    switch (udtKind)
+    {
+    case UdtClass:
+        return L"class";
+    case UdtUnion:
+    case UdtTaggedUnion:
+        return L"union";
+    default:
+        return L"struct";
+    }
+}
+
+/// @brief Format an enum value as a literal of the underlying type of the enum.
+std::wstring formatEnumValue(LONGLONG value, const Symbol& underlyingType)
+{
+    const auto length = getOrDefault(getLength, underlyingType);
+    switch (getOrDefault(getBaseType, underlyingType))
+    {
+    case btUInt:
+    case btULong:
+    case btBool:
+    case btWChar:
+        // Values of unsigned enums may still be stored sign extended.
+        return std::to_wstring((0 < length && length < sizeof(ULONGLONG)) ? static_cast<ULONGLONG>(value) & ((1ull << (8 * length)) - 1)
+                                                                          : static_cast<ULONGLONG>(value));
+    default:
+        return std::to_wstring(value);
+    }
+}
+
+/// @brief Hands the header to the sink in large chunks, however small the pieces it is written in.
+class BufferedHeaderWriter
+{
+public:
+    explicit BufferedHeaderWriter(const HeaderSink& sink)
+        : m_sink{sink}
+    {
+        m_buffer.reserve(HEADER_WRITER_BUFFER_SIZE);
+    }
+
+    BufferedHeaderWriter& operator<<(const std::string& text)
+    {
+        m_buffer += text;
+        flushIfFull();
+        return *this;
+    }
+
+    BufferedHeaderWriter& operator<<(const char* text)
+    {
+        m_buffer += text;
+        flushIfFull();
+        return *this;
+    }
+
+    void flush()
+    {
+        if (!m_buffer.empty())
+        {
+            m_sink(m_buffer.data(), m_buffer.size());
+            m_buffer.clear();
+        }
+    }
+
+private:
+    void flushIfFull()
+    {
+        if (m_buffer.size() >= HEADER_WRITER_BUFFER_SIZE)
+        {
+            flush();
+        }
+    }
+
+    const HeaderSink& m_sink;
+    std::string m_buffer{};
+};
+
+/// @brief Renders the declarations, with the symbols of a single session.
+class TypeRenderer
+{
+public:
+    TypeRenderer(const DataSource& dataSource, const std::vector<Symbol>& types, const std::vector<TypeDeclaration>& declarations,
+                 const DeclaredNames& declaredNames, const HeaderGeneratorOptions& options)
+        : m_dataSource{dataSource}
+        , m_types{types}
+        , m_declarations{declarations}
+        , m_declaredNames{declaredNames}
+        , m_options{options}
+    {
+    }
+
+    RenderedType render(size_t declarationIndex) const
+    {
+        const auto& declaration = m_declarations[declarationIndex];
+        const auto& symbol      = m_types[declaration.typePosition];
+
+        std::wstring forwardDeclaration{};
+        std::wstring definition{};
+        AliasedBasicTypeUses uses{};
+        if (SymTagEnum == declaration.symTag)
+        {
+            forwardDeclaration = L"enum " + declaration.identifier + L" : " + m_dataSource.resolveTypeName(getType(symbol)) + L";\n";
+            renderEnum(declaration, definition);
+        }
+        else
+        {
+            forwardDeclaration = std::wstring(udtKindToCppKeyword(getUdtKind(symbol))) + L" " + declaration.identifier + L";\n";
+            if (declaration.isDefined)
+            {
+                renderUdt(declaration.identifier, symbol, definition, uses);
+            }
+        }
+        return RenderedType{toUtf8(forwardDeclaration), toUtf8(definition), uses};
+    }
+
+private:
+    void renderEnum(const TypeDeclaration& declaration, std::wstring& out) const
+    {
+        std::vector<Symbol> mergedEnums{};
+        for (const auto typePosition : declaration.mergedTypePositions)
+        {
+            mergedEnums.push_back(m_types[typePosition]);
+        }
+        const auto underlyingType = getType(mergedEnums.front());
+        out += L"enum " + declaration.identifier + L" : " + m_dataSource.resolveTypeName(underlyingType) + L"\n{\n";
+        renderEnumValues(mergedEnums, underlyingType, INDENT, out);
+        out += L"};\n";
+    }
+
+    void renderEnumValues(const std::vector<Symbol>& enums, const Symbol& underlyingType, const std::wstring& indent, std::wstring& out) const
+    {
+        // Keep the order of the first definition, then append the values only the other definitions have.
+        std::unordered_map<std::wstring, LONGLONG> valuesByName{};
+        for (const auto& enumSymbol : enums)
+        {
+            for (const auto& enumValue : enumerate<Symbol>(enumSymbol, SymTagData))
+            {
+                const std::wstring valueName = std::wstring(getName(enumValue));
+                const auto value             = variantToInteger(getValue(enumValue));
+                const auto mergedValue       = valuesByName.emplace(valueName, value);
+                if (!mergedValue.second)
+                {
+                    if (mergedValue.first->second != value)
+                    {
+                        throw InvalidUsageException("Conflicting values for the same enum value name!");
+                    }
+                    continue;
+                }
+                out += indent + valueName + L" = " + formatEnumValue(value, underlyingType) + L",\n";
+            }
+        }
+    }
+
+    void renderUdt(const std::wstring& name, const Symbol& udt, std::wstring& out, AliasedBasicTypeUses& uses) const
+    {
+        const bool isPacked = getOrDefault(getPacked, udt);
+        const auto keyword  = udtKindToCppKeyword(getUdtKind(udt));
+        if (isPacked)
+        {
+            out += L"#pragma pack(push, 1)\n";
+        }
+        out += std::wstring(keyword) + L" " + name;
+        bool isFirstBaseClass = true;
+        for (const auto& baseClass : enumerate<Symbol>(udt, SymTagBaseClass))
+        {
+            out += isFirstBaseClass ? L" : " : L", ";
+            out += renderIdentifier(getType(baseClass));
+            isFirstBaseClass = false;
+        }
+        out += L"\n{\n";
+        renderMembers(udt, INDENT, out, uses);
+        out += L"};\n";
+        if (isPacked)
+        {
+            out += L"#pragma pack(pop)\n";
+        }
+
+        if (m_options.emitAliases && 1 < name.size() && L'_' == name.front())
+        {
+            const auto aliasName        = name.substr(1);
+            const auto pointerAliasName = L"P" + aliasName;
+            if (0 == m_declaredNames.identifiers.count(aliasName))
+            {
+                out += L"using " + aliasName + L" = " + keyword + L" " + name + L";\n";
+            }
+            if (0 == m_declaredNames.identifiers.count(pointerAliasName))
+            {
+                out += L"using " + pointerAliasName + L" = " + keyword + L" " + name + L"*;\n";
+            }
+        }
+    }
+
+    void renderMembers(const Symbol& udt, const std::wstring& indent, std::wstring& out, AliasedBasicTypeUses& uses) const
+    {
+        for (const auto& member : enumerate<Symbol>(udt, SymTagData))
+        {
+            const auto memberType         = getType(member);
+            const std::wstring memberName = std::wstring(getName(member));
+            if (DataIsStaticMember == getDataKind(member))
+            {
+                out += indent + L"static " + renderDeclaration(memberType, memberName, indent, uses) + L";\n";
+                continue;
+            }
+
+            wchar_t offsetComment[32] = {};
+            if (LocIsBitField == getLocationType(member))
+            {
+                swprintf_s(offsetComment, L"/* 0x%04lx:%lu */ ", getOffset(member), getBitPosition(member));
+                out += indent + offsetComment + renderDeclaration(memberType, memberName, indent, uses) + L" : " +
+                       std::to_wstring(getLength(member)) + L";\n";
+            }
+            else
+            {
+                swprintf_s(offsetComment, L"/* 0x%04lx */ ", getOffset(member));
+                out += indent + offsetComment + renderDeclaration(memberType, memberName, indent, uses) + L";\n";
+            }
+        }
+    }
+
+    /// @brief Render the declaration of a member. Arrays of unnamed types are declared the C way, since a type can't be defined inside the
+    /// template arguments of a `std::array`.
+    std::wstring renderDeclaration(const Symbol& type, const std::wstring& declarator, const std::wstring& indent, AliasedBasicTypeUses& uses) const
+    {
+        switch (getSymTag(type))
+        {
+        case SymTagTypedef:
+            return renderDeclaration(getType(type), declarator, indent, uses);
+        case SymTagArrayType:
+            if (isUnnamedType(type))
+            {
+                return renderDeclaration(getType(type), declarator + L"[" + std::to_wstring(getCount(type)) + L"]", indent, uses);
+            }
+            break;
+        default:
+            break;
+        }
+        return renderTypeName(type, indent, uses) + L" " + declarator;
+    }
+
+    /// @brief Like DataSource::resolveTypeName, but defines unnamed types inline, which are otherwise named "<unnamed-tag>", and names the
+    /// declared types by their identifiers.
+    std::wstring renderTypeName(const Symbol& type, const std::wstring& indent, AliasedBasicTypeUses& uses) const
+    {
+        switch (getSymTag(type))
+        {
+        case SymTagTypedef:
+            return renderTypeName(getType(type), indent, uses);
+        case SymTagPointerType:
+        {
+            const auto pointeeType = getType(type);
+            if (SymTagFunctionType == getSymTag(pointeeType))
+            {
+                break;
+            }
+            if (isUnnamedType(pointeeType))
+            {
+                // The dependencies of a type only pointed to are not defined beforehand (see TypeDependencyGraph), so it can't be defined inline.
+                return L"void*";
+            }
+            return renderTypeName(pointeeType, indent, uses) + L"*";
+        }
+        case SymTagArrayType:
+            // Arrays of unnamed types are only ever rendered by renderDeclaration.
+            return L"std::array<" + renderTypeName(getType(type), indent, uses) + L", " + std::to_wstring(getCount(type)) + L">";
+        case SymTagUDT:
+        {
+            if (!isSymbolUnnamed(type))
+            {
+                return renderIdentifier(type);
+            }
+            std::wstring inlineDefinition = std::wstring(udtKindToCppKeyword(getUdtKind(type))) + L"\n" + indent + L"{\n";
+            renderMembers(type, indent + INDENT, inlineDefinition, uses);
+            return inlineDefinition + indent + L"}";
+        }
+        case SymTagEnum:
+        {
+            if (!isSymbolUnnamed(type))
+            {
+                return renderIdentifier(type);
+            }
+            const auto underlyingType     = getType(type);
+            std::wstring inlineDefinition = L"enum : " + m_dataSource.resolveTypeName(underlyingType) + L"\n" + indent + L"{\n";
+            renderEnumValues({type}, underlyingType, indent + INDENT, inlineDefinition);
+            return inlineDefinition + indent + L"}";
+        }
+        default:
+            break;
+        }
+        noteAliasedBasicTypeUses(type, uses);
+        return m_dataSource.resolveTypeName(type);
+    }
+
+    /// @brief The identifier a named UDT or enum is declared with.
+    std::wstring renderIdentifier(const Symbol& type) const
+    {
+        const auto identifier = m_declaredNames.identifiersByName.find(std::wstring(getName(type)));
+        return (m_declaredNames.identifiersByName.end() != identifier) ? identifier->second : m_dataSource.resolveTypeName(type);
+    }
+
+    const DataSource& m_dataSource;
+    const std::vector<Symbol>& m_types;
+    const std::vector<TypeDeclaration>& m_declarations;
+    const DeclaredNames& m_declaredNames;
+    const HeaderGeneratorOptions& m_options;
+};
+
+/// @brief Group the nodes of the graph by name into declarations, and collect their dependencies.
+std::vector<TypeDeclaration> collectDeclarations(const DataSource& dataSource, const TypeDependencyGraph& graph, const std::vector<Symbol>& types)
+{
+    std::unordered_map<DWORD, size_t> typePositionBySymIndexId{};
+    typePositionBySymIndexId.reserve(types.size());
+    for (size_t typePosition = 0; typePosition < types.size(); ++typePosition)
+    {
+        typePositionBySymIndexId.emplace(getSymIndexId(types[typePosition]), typePosition);
+    }
+
+    std::vector<TypeDeclaration> declarations{};
+    std::unordered_map<std::wstring, size_t> declarationsByName{};
+    std::vector<size_t> declarationOfNode(graph.getNodeCount(), NOT_DECLARED);
+    std::vector<bool> isTypedefNode(graph.getNodeCount(), false);
+    for (size_t node = 0; node < graph.getNodeCount(); ++node)
+    {
+        const auto type   = dataSource.getSymbolById(graph.getSymIndexId(node));
+        const auto symTag = getSymTag(type);
+        if (SymTagTypedef == symTag)
+        {
+            isTypedefNode[node] = true;
+            continue;
+        }
+
+        const std::wstring name = std::wstring(getName(type));
+        const auto symIndexId   = getSymIndexId(type);
+        const auto typePosition = typePositionBySymIndexId.at(symIndexId);
+        const auto inserted     = declarationsByName.emplace(name, declarations.size());
+        if (inserted.second)
+        {
+            declarations.push_back(TypeDeclaration{name, {}, symTag, symIndexId, typePosition, false, {}, {}});
+        }
+        auto& declaration = declarations[inserted.first->second];
+        if (declaration.symTag != symTag)
+        {
+            // A UDT and an enum with the same name, only the first one is declared.
+            continue;
+        }
+        declarationOfNode[node] = inserted.first->second;
+
+        if (SymTagEnum == symTag)
+        {
+            declaration.isDefined = true;
+            declaration.mergedTypePositions.push_back(typePosition);
+        }
+        else if (!declaration.isDefined && 0 != getOrDefault(getLength, type))
+        {
+            // The same UDT is usually defined once per compiland, the first definition stands for all of them.
+            declaration.symIndexId   = symIndexId;
+            declaration.typePosition = typePosition;
+            declaration.isDefined    = true;
+        }
+    }
+
+    // Names which are plain identifiers are kept, the other ones (nested and template types) are turned into identifiers, which must not collide
+    // with any of the kept names.
+    std::unordered_set<std::wstring> identifiers{};
+    for (auto& declaration : declarations)
+    {
+        if (isPlainIdentifier(declaration.name))
+        {
+            declaration.identifier = declaration.name;
+            identifiers.insert(declaration.name);
+        }
+    }
+    for (auto& declaration : declarations)
+    {
+        if (!declaration.identifier.empty())
+        {
+            continue;
+        }
+        const auto baseIdentifier = toIdentifier(declaration.name);
+        auto identifier           = baseIdentifier;
+        for (size_t suffix = 2; !identifiers.insert(identifier).second; ++suffix)
+        {
+            identifier = baseIdentifier + L"_" + std::to_wstring(suffix);
+        }
+        declaration.identifier = identifier;
+    }
+
+    // Typedefs never make it to the header, since resolveTypeName resolves them to the aliased types. Whatever a typedef depends on is
+    // attributed to the types which use it instead.
+    for (size_t declarationIndex = 0; declarationIndex < declarations.size(); ++declarationIndex)
+    {
+        auto& declaration = declarations[declarationIndex];
+        if (SymTagUDT != declaration.symTag || !declaration.isDefined)
+        {
+            continue;
+        }
+
+        std::unordered_set<size_t> visitedTypedefs{};
+        std::vector<std::pair<size_t, TypeEdgeKind>> pendingNodes{{graph.getNode(declaration.symIndexId), TypeEdgeKind::ByValue}};
+        while (!pendingNodes.empty())
+        {
+            const auto pendingNode = pendingNodes.back();
+            pendingNodes.pop_back();
+            for (const auto& edge : graph.getDependencies(pendingNode.first))
+            {
+                const auto kind = (TypeEdgeKind::ByPointer == pendingNode.second) ? TypeEdgeKind::ByPointer : edge.kind;
+                if (isTypedefNode[edge.target])
+                {
+                    if (visitedTypedefs.insert(edge.target).second)
+                    {
+                        pendingNodes.emplace_back(edge.target, kind);
+                    }
+                }
+                else if (NOT_DECLARED != declarationOfNode[edge.target] && declarationIndex != declarationOfNode[edge.target])
+                {
+                    declaration.dependencies.emplace_back(declarationOfNode[edge.target], kind);
+                }
+            }
+        }
+
+        // Keep a single dependency per declaration, the by-value one when there are both (ByValue sorts first).
+        auto& dependencies = declaration.dependencies;
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(std::unique(dependencies.begin(), dependencies.end(),
+                                       [](const std::pair<size_t, TypeEdgeKind>& first, const std::pair<size_t, TypeEdgeKind>& second)
+                                       { return first.first == second.first; }),
+                           dependencies.end());
+    }
+    return declarations;
+}
+
+/// @brief Order the declarations so that each one comes after the ones it contains by value, alphabetically among the ready ones.
+std::vector<size_t> orderDeclarations(const std::vector<TypeDeclaration>& declarations)
+{
+    std::vector<size_t> pendingDependencies(declarations.size(), 0);
+    std::vector<std::vector<size_t>> dependents(declarations.size());
+    for (size_t declarationIndex = 0; declarationIndex < declarations.size(); ++declarationIndex)
+    {
+        for (const auto& dependency : declarations[declarationIndex].dependencies)
+        {
+            if (TypeEdgeKind::ByValue == dependency.second)
+            {
+                dependents[dependency.first].push_back(declarationIndex);
+                ++pendingDependencies[declarationIndex];
+            }
+        }
+    }
+
+    const auto isAfter = [&declarations](size_t first, size_t second) { return declarations[first].name > declarations[second].name; };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(isAfter)> readyDeclarations{isAfter};
+    for (size_t declarationIndex = 0; declarationIndex < declarations.size(); ++declarationIndex)
+    {
+        if (0 == pendingDependencies[declarationIndex])
+        {
+            readyDeclarations.push(declarationIndex);
+        }
+    }
+
+    std::vector<size_t> order{};
+    order.reserve(declarations.size());
+    while (!readyDeclarations.empty())
+    {
+        const auto declarationIndex = readyDeclarations.top();
+        readyDeclarations.pop();
+        order.push_back(declarationIndex);
+        for (const auto dependent : dependents[declarationIndex])
+        {
+            if (0 == --pendingDependencies[dependent])
+            {
+                readyDeclarations.push(dependent);
+            }
+        }
+    }
+
+    if (order.size() != declarations.size())
+    {
+        throw InvalidUsageException("The types contain each other by value!");
+    }
+    return order;
+}
+
+void renderInOwnSession(const std::wstring& pdbFilePath, size_t typeCount, const std::vector<TypeDeclaration>& declarations,
+                        const DeclaredNames& declaredNames, const HeaderGeneratorOptions& options,
+                        std::vector<RenderedType>& renderedTypes, std::atomic<size_t>& nextIndex)
+{
+    const auto comInitResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    if (FAILED(comInitResult) && RPC_E_CHANGED_MODE != comInitResult)
+    {
+        throw DiaComException("Failed to initialize COM on a header rendering worker!", comInitResult);
+    }
+
+    try
+    {
+        const DataSource workerDataSource{pdbFilePath};
+        const auto workerTypes = enumerateTypes(workerDataSource);
+        if (workerTypes.size() != typeCount)
+        {
+            throw InvalidUsageException("The sessions of the PDB enumerate different symbols!");
+        }
+        const TypeRenderer renderer{workerDataSource, workerTypes, declarations, declaredNames, options};
+        for (auto batchBegin = nextIndex.fetch_add(HEADER_RENDER_BATCH_SIZE); batchBegin < declarations.size();
+             batchBegin      = nextIndex.fetch_add(HEADER_RENDER_BATCH_SIZE))
+        {
+            const auto batchEnd = (std::min)(batchBegin + HEADER_RENDER_BATCH_SIZE, declarations.size());
+            for (auto i = batchBegin; i < batchEnd; ++i)
+            {
+                // Each worker only ever writes the slots of the batches it claimed.
+                renderedTypes[i] = renderer.render(i);
+            }
+        }
+    }
+    catch (...)
+    {
+        if (SUCCEEDED(comInitResult))
+        {
+            CoUninitialize();
+        }
+        throw;
+    }
+
+    if (SUCCEEDED(comInitResult))
+    {
+        CoUninitialize();
+    }
+}
+
+std::vector<RenderedType> renderDeclarations(const DataSource& dataSource, const std::vector<Symbol>& types,
+                                             const std::vector<TypeDeclaration>& declarations,
+                                             const DeclaredNames& declaredNames, const HeaderGeneratorOptions& options)
+{
+    auto workerCount = options.workerCount;
+    if (0 == workerCount)
+    {
+        workerCount = (std::max)(1u, std::thread::hardware_concurrency());
+    }
+
+    std::vector<RenderedType> renderedTypes(declarations.size());
+    if (1 == workerCount)
+    {
+        const TypeRenderer renderer{dataSource, types, declarations, declaredNames, options};
+        for (size_t i = 0; i < declarations.size(); ++i)
+        {
+            renderedTypes[i] = renderer.render(i);
+        }
+        return renderedTypes;
+    }
+
+    const auto pdbFilePath = dataSource.getLoadedPdbFile();
+    std::atomic<size_t> nextIndex{0};
+    std::vector<std::future<void>> workers{};
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.push_back(std::async(std::launch::async, renderInOwnSession, std::cref(pdbFilePath), types.size(), std::cref(declarations),
+                                     std::cref(declaredNames), std::cref(options), std::ref(renderedTypes), std::ref(nextIndex)));
+    }
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+    return renderedTypes;
+}
+}  // namespace
+
+void writeHeader(const DataSource& dataSource, const HeaderSink& sink, const HeaderGeneratorOptions& options)
+{
+    const TypeDependencyGraph graph{dataSource};
+    const auto types        = enumerateTypes(dataSource);
+    const auto declarations = collectDeclarations(dataSource, graph, types);
+    const auto order        = orderDeclarations(declarations);
+
+    DeclaredNames declaredNames{};
+    for (const auto& declaration : declarations)
+    {
+        declaredNames.identifiersByName.emplace(declaration.name, declaration.identifier);
+        declaredNames.identifiers.insert(declaration.identifier);
+    }
+    const auto renderedTypes = renderDeclarations(dataSource, types, declarations, declaredNames, options);
+    AliasedBasicTypeUses uses{};
+    for (const auto& renderedType : renderedTypes)
+    {
+        uses.usesHresult = uses.usesHresult || renderedType.aliasedBasicTypeUses.usesHresult;
+        uses.usesBstr    = uses.usesBstr || renderedType.aliasedBasicTypeUses.usesBstr;
+    }
+
+    BufferedHeaderWriter writer{sink};
+    writer << "#pragma once\n#include <array>\n#include <cstdint>\n#include <functional>\n\n";
+    const auto namespaceName = toUtf8(options.namespaceName);
+    if (!namespaceName.empty())
+    {
+        writer << "namespace " << namespaceName << "\n{\n";
+    }
+    if (uses.usesHresult)
+    {
+        writer << "using HRESULT = int32_t;\n";
+    }
+    if (uses.usesBstr)
+    {
+        writer << "using BSTR = wchar_t*;\n";
+    }
+
+    // By-value dependencies are always emitted first, so only the by-pointer ones may need a forward declaration.
+    std::vector<bool> isDeclared(declarations.size(), false);
+    for (const auto declarationIndex : order)
+    {
+        bool hasForwardDeclarations = false;
+        for (const auto& dependency : declarations[declarationIndex].dependencies)
+        {
+            if (!isDeclared[dependency.first])
+            {
+                writer << (hasForwardDeclarations ? "" : "\n") << renderedTypes[dependency.first].forwardDeclaration;
+                isDeclared[dependency.first] = true;
+                hasForwardDeclarations       = true;
+            }
+        }
+
+        if (!declarations[declarationIndex].isDefined)
+        {
+            if (!isDeclared[declarationIndex])
+            {
+                writer << "\n" << renderedTypes[declarationIndex].forwardDeclaration;
+            }
+        }
+        else
+        {
+            writer << "\n" << renderedTypes[declarationIndex].definition;
+        }
+        isDeclared[declarationIndex] = true;
+    }
+
+    if (!namespaceName.empty())
+    {
+        writer << "\n}  // namespace " << namespaceName << "\n";
+    }
+    writer.flush();
+}
+
+void writeHeaderFile(const DataSource& dataSource, const std::wstring& outputFilePath, const HeaderGeneratorOptions& options)
+{
+    const HANDLE file = CreateFileW(outputFilePath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        throw WinApiException("Failed to create the header file!");
+    }
+    ATL::CHandle fileHandle{file};
+
+    writeHeader(
+        dataSource,
+        [&fileHandle](const char* data, size_t size)
+        {
+            DWORD bytesWritten = 0;
+            if (!WriteFile(fileHandle, data, static_cast<DWORD>(size), &bytesWritten, nullptr) || size != bytesWritten)
+            {
+                throw WinApiException("Failed to write the header file!");
+            }
+        },
+        options);
+}
+
+std::string generateHeader(const DataSource& dataSource, const HeaderGeneratorOptions& options)
+{
+    std::string header{};
+    writeHeader(
+        dataSource, [&header](const char* data, size_t size) { header.append(data, size); }, options);
+    return header;
+}
+
+}  // namespace dia
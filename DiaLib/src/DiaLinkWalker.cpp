@@ -0,0 +1,189 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaLinkWalker.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace dia
+{
+namespace
+{
+Symbol stripTypedefs(Symbol type)
+{
+    while (SymTagTypedef == getSymTag(type))
+    {
+        type = getType(type);
+    }
+    return type;
+}
+
+/// @brief Gathers the containers of a walk into batches, and remembers the walked links.
+class WalkState
+{
+public:
+    WalkState(ULONGLONG linkOffset, const LinkWalkOptions& options, const LinkWalkBatchCallback& onBatch)
+        : m_linkOffset{linkOffset}
+        , m_options{options}
+        , m_onBatch{onBatch}
+        , m_batchSize{(std::max)(options.batchSize, size_t{1})}
+    {
+        m_batch.reserve(m_batchSize);
+    }
+
+    /// @return Whether the link was not walked yet.
+    bool visit(ULONGLONG linkAddress) { return m_visitedLinks.insert(linkAddress).second; }
+
+    /// @return The status which ends the walk, or Completed to go on walking.
+    LinkWalkStatus report(ULONGLONG linkAddress)
+    {
+        if (m_nodeCount == m_options.maxNodes)
+        {
+            return LinkWalkStatus::NodeLimitReached;
+        }
+        ++m_nodeCount;
+        m_batch.push_back(linkAddress - m_linkOffset);
+        return (m_batch.size() < m_batchSize || flush()) ? LinkWalkStatus::Completed : LinkWalkStatus::Stopped;
+    }
+
+    /// @brief Report the containers of the last batch, unless the callback already asked to stop.
+    LinkWalkStatus finish(LinkWalkStatus status) { return (LinkWalkStatus::Stopped == status || flush()) ? status : LinkWalkStatus::Stopped; }
+
+private:
+    bool flush()
+    {
+        const bool goOn = m_batch.empty() || m_onBatch(m_batch.data(), m_batch.size());
+        m_batch.clear();
+        return goOn;
+    }
+
+    const ULONGLONG m_linkOffset;
+    const LinkWalkOptions& m_options;
+    const LinkWalkBatchCallback& m_onBatch;
+    const size_t m_batchSize;
+    size_t m_nodeCount{0};
+    std::vector<ULONGLONG> m_batch{};
+    std::unordered_set<ULONGLONG> m_visitedLinks{};
+};
+}  // namespace
+
+LinkWalker::LinkWalker(const DataSource& dataSource, const Symbol& containerUdt, const std::wstring& linkPath, MemoryReader readMemory)
+    : m_dataSource{dataSource}
+    , m_readMemory{std::move(readMemory)}
+{
+    const auto& linkField = dataSource.resolveFieldPath(containerUdt, linkPath);
+    m_linkOffset          = linkField.offset;
+    m_linkType            = stripTypedefs(linkField.type);
+    if (linkField.isBitfield || SymTagUDT != getSymTag(m_linkType))
+    {
+        throw InvalidUsageException("The link field must be a UDT, like LIST_ENTRY or RTL_BALANCED_NODE!");
+    }
+}
+
+LinkWalker::LinkPointer LinkWalker::resolveLinkPointer(const std::wstring& member) const
+{
+    const auto& pointerField = m_dataSource.resolveFieldPath(m_linkType, member);
+    if (pointerField.isBitfield || SymTagPointerType != getSymTag(stripTypedefs(pointerField.type)) || sizeof(ULONGLONG) < pointerField.size)
+    {
+        throw InvalidUsageException("The links of the link field must be pointers!");
+    }
+    return LinkPointer{pointerField.offset, static_cast<size_t>(pointerField.size)};
+}
+
+bool LinkWalker::readLink(ULONGLONG linkAddress, const LinkPointer& pointer, ULONGLONG& nextLinkAddress) const
+{
+    nextLinkAddress = 0;
+    return pointer.size == m_readMemory(linkAddress + pointer.offset, &nextLinkAddress, pointer.size);
+}
+
+LinkWalkStatus LinkWalker::walkList(ULONGLONG headAddress, const LinkWalkOptions& options, const LinkWalkBatchCallback& onBatch)
+{
+    const auto next = resolveLinkPointer(options.nextMember);
+    WalkState state{m_linkOffset, options, onBatch};
+    state.visit(headAddress);
+
+    ULONGLONG link = 0;
+    if (!readLink(headAddress, next, link))
+    {
+        return LinkWalkStatus::MemoryNotReadable;
+    }
+    while (0 != link && headAddress != link)
+    {
+        if (!state.visit(link))
+        {
+            return state.finish(LinkWalkStatus::CycleDetected);
+        }
+        const auto status = state.report(link);
+        if (LinkWalkStatus::Completed != status)
+        {
+            return state.finish(status);
+        }
+        if (!readLink(link, next, link))
+        {
+            return state.finish(LinkWalkStatus::MemoryNotReadable);
+        }
+    }
+    return state.finish(LinkWalkStatus::Completed);
+}
+
+LinkWalkStatus LinkWalker::walkTree(ULONGLONG rootAddress, const LinkWalkOptions& options, const LinkWalkBatchCallback& onBatch)
+{
+    const auto left  = resolveLinkPointer(options.leftMember);
+    const auto right = resolveLinkPointer(options.rightMember);
+    WalkState state{m_linkOffset, options, onBatch};
+
+    // An in-order walk with an explicit stack, as trees of corrupt dumps may be arbitrarily deep.
+    std::vector<ULONGLONG> ancestors{};
+    ULONGLONG link = rootAddress;
+    while (0 != link || !ancestors.empty())
+    {
+        while (0 != link)
+        {
+            if (!state.visit(link))
+            {
+                return state.finish(LinkWalkStatus::CycleDetected);
+            }
+            ancestors.push_back(link);
+            if (!readLink(link, left, link))
+            {
+                return state.finish(LinkWalkStatus::MemoryNotReadable);
+            }
+        }
+
+        link = ancestors.back();
+        ancestors.pop_back();
+        const auto status = state.report(link);
+        if (LinkWalkStatus::Completed != status)
+        {
+            return state.finish(status);
+        }
+        if (!readLink(link, right, link))
+        {
+            return state.finish(LinkWalkStatus::MemoryNotReadable);
+        }
+    }
+    return state.finish(LinkWalkStatus::Completed);
+}
+
+std::wstring linkWalkStatusToName(LinkWalkStatus status)
+{
+    switch (status)
+    {
+    case LinkWalkStatus::Completed:
+        return L"Completed";
+    case LinkWalkStatus::Stopped:
+        return L"Stopped";
+    case LinkWalkStatus::CycleDetected:
+        return L"CycleDetected";
+    case LinkWalkStatus::MemoryNotReadable:
+        return L"MemoryNotReadable";
+    case LinkWalkStatus::NodeLimitReached:
+        return L"NodeLimitReached";
+    default:
+        throw std::invalid_argument("Invalid LinkWalkStatus!");
+    }
+}
+
+}  // namespace dia
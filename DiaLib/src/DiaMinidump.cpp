@@ -0,0 +1,399 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaMinidump.h"
+#include "Exceptions.h"
+#include <DbgHelp.h>
+#include <algorithm>
+#include <cstring>
+
+namespace dia
+{
+namespace
+{
+const DWORD RSDS_SIGNATURE = 0x53445352;  // "RSDS"
+
+/// @brief The CodeView record of a module whose debug information is in a PDB 7.0 file.
+#pragma pack(push, 1)
+struct RsdsRecord
+{
+    DWORD signature;
+    GUID guid;
+    DWORD age;
+};
+#pragma pack(pop)
+
+template <typename T>
+T readStruct(const uint8_t* data)
+{
+    T value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+Symbol stripTypedefs(Symbol type)
+{
+    while (SymTagTypedef == getSymTag(type))
+    {
+        type = getType(type);
+    }
+    return type;
+}
+
+std::wstring getFileName(const std::wstring& path)
+{
+    const auto separator = path.find_last_of(L"\\/");
+    return (std::wstring::npos == separator) ? path : path.substr(separator + 1);
+}
+}  // namespace
+
+MinidumpReader::MinidumpReader(const std::wstring& dumpFilePath)
+{
+    const HANDLE file = CreateFileW(dumpFilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        throw WinApiException("Failed to open the minidump!");
+    }
+    m_file.Attach(file);
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(m_file, &fileSize))
+    {
+        throw WinApiException("Failed to get the size of the minidump!");
+    }
+    if (static_cast<ULONGLONG>(fileSize.QuadPart) < sizeof(MINIDUMP_HEADER))
+    {
+        throw InvalidFileFormatException("The file is too small to be a minidump!");
+    }
+    m_fileSize = static_cast<ULONGLONG>(fileSize.QuadPart);
+
+    const HANDLE mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (nullptr == mapping)
+    {
+        throw WinApiException("Failed to map the minidump!");
+    }
+    m_mapping.Attach(mapping);
+    m_fileData = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (nullptr == m_fileData)
+    {
+        throw WinApiException("Failed to map a view of the minidump!");
+    }
+
+    try
+    {
+        parseStreams();
+    }
+    catch (...)
+    {
+        UnmapViewOfFile(m_fileData);
+        throw;
+    }
+}
+
+MinidumpReader::~MinidumpReader() noexcept { UnmapViewOfFile(m_fileData); }
+
+void MinidumpReader::parseStreams()
+{
+    const auto header = readStruct<MINIDUMP_HEADER>(m_fileData);
+    if (MINIDUMP_SIGNATURE != header.Signature)
+    {
+        throw InvalidFileFormatException("The file is not a minidump!");
+    }
+    const auto directorySize = ULONGLONG{header.NumberOfStreams} * sizeof(MINIDUMP_DIRECTORY);
+    if (header.StreamDirectoryRva > m_fileSize || m_fileSize - header.StreamDirectoryRva < directorySize)
+    {
+        throw InvalidFileFormatException("The stream directory of the minidump is out of the bounds of the file!");
+    }
+
+    for (ULONG32 i = 0; i < header.NumberOfStreams; ++i)
+    {
+        const auto directory = readStruct<MINIDUMP_DIRECTORY>(m_fileData + header.StreamDirectoryRva + i * sizeof(MINIDUMP_DIRECTORY));
+        const auto& location = directory.Location;
+        if (location.Rva > m_fileSize || m_fileSize - location.Rva < location.DataSize)
+        {
+            throw InvalidFileFormatException("A stream of the minidump is out of the bounds of the file!");
+        }
+        const auto stream = m_fileData + location.Rva;
+        switch (directory.StreamType)
+        {
+        case ModuleListStream:
+            parseModuleList(stream, location.DataSize);
+            break;
+        case MemoryListStream:
+            parseMemoryList(stream, location.DataSize);
+            break;
+        case Memory64ListStream:
+            parseMemory64List(stream, location.DataSize);
+            break;
+        case SystemInfoStream:
+            parseSystemInfo(stream, location.DataSize);
+            break;
+        default:
+            break;
+        }
+    }
+
+    std::sort(m_memoryRanges.begin(), m_memoryRanges.end(),
+              [](const MinidumpMemoryRange& lhs, const MinidumpMemoryRange& rhs) { return lhs.address < rhs.address; });
+}
+
+void MinidumpReader::parseModuleList(const uint8_t* stream, ULONGLONG streamSize)
+{
+    const auto moduleCount = (sizeof(ULONG32) <= streamSize) ? readStruct<ULONG32>(stream) : 0;
+    if ((streamSize - sizeof(ULONG32)) / sizeof(MINIDUMP_MODULE) < moduleCount)
+    {
+        throw InvalidFileFormatException("The module list of the minidump is truncated!");
+    }
+
+    for (ULONG32 i = 0; i < moduleCount; ++i)
+    {
+        const auto module = readStruct<MINIDUMP_MODULE>(stream + sizeof(ULONG32) + i * sizeof(MINIDUMP_MODULE));
+        MinidumpModule minidumpModule{module.BaseOfImage, module.SizeOfImage, module.TimeDateStamp};
+        if (module.ModuleNameRva <= m_fileSize - sizeof(ULONG32))
+        {
+            const auto nameLength = readStruct<ULONG32>(m_fileData + module.ModuleNameRva);
+            if (nameLength <= m_fileSize - module.ModuleNameRva - sizeof(ULONG32))
+            {
+                const auto name = m_fileData + module.ModuleNameRva + sizeof(ULONG32);
+                minidumpModule.path.resize(nameLength / sizeof(wchar_t));
+                memcpy(&minidumpModule.path[0], name, minidumpModule.path.size() * sizeof(wchar_t));
+            }
+        }
+
+        const auto& cvRecord = module.CvRecord;
+        if (sizeof(RsdsRecord) <= cvRecord.DataSize && cvRecord.Rva <= m_fileSize && m_fileSize - cvRecord.Rva >= cvRecord.DataSize)
+        {
+            const auto rsdsRecord = readStruct<RsdsRecord>(m_fileData + cvRecord.Rva);
+            if (RSDS_SIGNATURE == rsdsRecord.signature)
+            {
+                minidumpModule.hasPdbSignature = true;
+                minidumpModule.pdbGuid         = rsdsRecord.guid;
+                minidumpModule.pdbAge          = rsdsRecord.age;
+            }
+        }
+        m_modules.push_back(std::move(minidumpModule));
+    }
+}
+
+void MinidumpReader::parseMemoryList(const uint8_t* stream, ULONGLONG streamSize)
+{
+    const auto rangeCount = (sizeof(ULONG32) <= streamSize) ? readStruct<ULONG32>(stream) : 0;
+    if ((streamSize - sizeof(ULONG32)) / sizeof(MINIDUMP_MEMORY_DESCRIPTOR) < rangeCount)
+    {
+        throw InvalidFileFormatException("The memory list of the minidump is truncated!");
+    }
+
+    for (ULONG32 i = 0; i < rangeCount; ++i)
+    {
+        const auto descriptor = readStruct<MINIDUMP_MEMORY_DESCRIPTOR>(stream + sizeof(ULONG32) + i * sizeof(MINIDUMP_MEMORY_DESCRIPTOR));
+        // Truncated dumps are common, so the ranges are clipped to the file rather than rejected.
+        if (descriptor.Memory.Rva < m_fileSize)
+        {
+            const auto size = (std::min)(ULONGLONG{descriptor.Memory.DataSize}, m_fileSize - descriptor.Memory.Rva);
+            if (0 != size)
+            {
+                m_memoryRanges.push_back(MinidumpMemoryRange{descriptor.StartOfMemoryRange, size, descriptor.Memory.Rva});
+            }
+        }
+    }
+}
+
+void MinidumpReader::parseMemory64List(const uint8_t* stream, ULONGLONG streamSize)
+{
+    const auto headerSize = sizeof(ULONG64) + sizeof(RVA64);
+    const auto rangeCount = (headerSize <= streamSize) ? readStruct<ULONG64>(stream) : 0;
+    if ((streamSize - headerSize) / sizeof(MINIDUMP_MEMORY_DESCRIPTOR64) < rangeCount)
+    {
+        throw InvalidFileFormatException("The memory64 list of the minidump is truncated!");
+    }
+
+    // The bytes of all the ranges follow each other, starting at the base RVA.
+    auto fileOffset = readStruct<RVA64>(stream + sizeof(ULONG64));
+    for (ULONG64 i = 0; i < rangeCount && fileOffset < m_fileSize; ++i)
+    {
+        const auto descriptor = readStruct<MINIDUMP_MEMORY_DESCRIPTOR64>(stream + headerSize + i * sizeof(MINIDUMP_MEMORY_DESCRIPTOR64));
+        const auto size       = (std::min)(descriptor.DataSize, m_fileSize - fileOffset);
+        if (0 != size)
+        {
+            m_memoryRanges.push_back(MinidumpMemoryRange{descriptor.StartOfMemoryRange, size, fileOffset});
+        }
+        fileOffset += descriptor.DataSize;
+    }
+}
+
+void MinidumpReader::parseSystemInfo(const uint8_t* stream, ULONGLONG streamSize)
+{
+    if (sizeof(MINIDUMP_SYSTEM_INFO) > streamSize)
+    {
+        return;
+    }
+    switch (readStruct<MINIDUMP_SYSTEM_INFO>(stream).ProcessorArchitecture)
+    {
+    case PROCESSOR_ARCHITECTURE_INTEL:
+    case PROCESSOR_ARCHITECTURE_ARM:
+        m_pointerSize = sizeof(ULONG);
+        break;
+    default:
+        m_pointerSize = sizeof(ULONGLONG);
+        break;
+    }
+}
+
+const MinidumpModule* MinidumpReader::findModule(ULONGLONG address) const
+{
+    for (const auto& module : m_modules)
+    {
+        if (address >= module.baseAddress && address - module.baseAddress < module.size)
+        {
+            return &module;
+        }
+    }
+    return nullptr;
+}
+
+const MinidumpModule* MinidumpReader::findModule(const std::wstring& name) const
+{
+    for (const auto& module : m_modules)
+    {
+        if (0 == _wcsicmp(module.path.c_str(), name.c_str()) || 0 == _wcsicmp(getFileName(module.path).c_str(), name.c_str()))
+        {
+            return &module;
+        }
+    }
+    return nullptr;
+}
+
+const MinidumpModule* MinidumpReader::findModule(const DataSource& dataSource) const
+{
+    // The GUID alone identifies the PDB: the age only changes when the PDB is updated in place, which does not change which module it is of.
+    const auto pdbGuid = getGuid(dataSource.getGlobalScope());
+    for (const auto& module : m_modules)
+    {
+        if (module.hasPdbSignature && IsEqualGUID(pdbGuid, module.pdbGuid))
+        {
+            return &module;
+        }
+    }
+    return nullptr;
+}
+
+const MinidumpMemoryRange* MinidumpReader::findMemoryRange(ULONGLONG address) const
+{
+    auto range = std::upper_bound(m_memoryRanges.begin(), m_memoryRanges.end(), address,
+                                  [](ULONGLONG value, const MinidumpMemoryRange& memoryRange) { return value < memoryRange.address; });
+    if (m_memoryRanges.begin() == range)
+    {
+        return nullptr;
+    }
+    --range;
+    return (address - range->address < range->size) ? &*range : nullptr;
+}
+
+bool MinidumpReader::translate(ULONGLONG address, const uint8_t*& data, ULONGLONG& available)
+{
+    const auto pageAddress = address & ~(MINIDUMP_PAGE_SIZE - 1);
+    const auto pageOffset  = address - pageAddress;
+    auto cachedPage        = m_pages.find(pageAddress);
+    if (m_pages.end() == cachedPage)
+    {
+        TranslatedPage page{nullptr, 0};
+        if (const auto range = findMemoryRange(pageAddress))
+        {
+            const auto rangeOffset = pageAddress - range->address;
+            page.data              = m_fileData + range->fileOffset + rangeOffset;
+            page.available         = range->size - rangeOffset;
+        }
+        cachedPage = m_pages.emplace(pageAddress, page).first;
+    }
+
+    const auto& page = cachedPage->second;
+    if (nullptr != page.data && pageOffset < page.available)
+    {
+        data      = page.data + pageOffset;
+        available = page.available - pageOffset;
+        return true;
+    }
+
+    // Ranges which are not page aligned may still start within the page, past its start.
+    const auto range = findMemoryRange(address);
+    if (nullptr == range)
+    {
+        return false;
+    }
+    const auto rangeOffset = address - range->address;
+    data                   = m_fileData + range->fileOffset + rangeOffset;
+    available              = range->size - rangeOffset;
+    return true;
+}
+
+MemoryView MinidumpReader::getView(ULONGLONG address, size_t size)
+{
+    MemoryView view{address, nullptr, size};
+    const uint8_t* data = nullptr;
+    ULONGLONG available = 0;
+    if (!translate(address, data, available))
+    {
+        return view;
+    }
+
+    // Adjacent ranges of memory are usually adjacent in the file as well (always so in the memory64 list), so a view may span several ranges.
+    auto viewEnd = data + (std::min)(available, ULONGLONG{size});
+    while (static_cast<size_t>(viewEnd - data) < size)
+    {
+        const uint8_t* nextData = nullptr;
+        const auto nextAddress  = address + static_cast<ULONGLONG>(viewEnd - data);
+        if (!translate(nextAddress, nextData, available) || nextData != viewEnd)
+        {
+            return view;
+        }
+        viewEnd += (std::min)(available, ULONGLONG{size - static_cast<size_t>(viewEnd - data)});
+    }
+    view.data = data;
+    return view;
+}
+
+size_t MinidumpReader::read(ULONGLONG address, void* buffer, size_t size)
+{
+    size_t copied = 0;
+    while (copied < size)
+    {
+        const uint8_t* data = nullptr;
+        ULONGLONG available = 0;
+        if (!translate(address + copied, data, available))
+        {
+            break;
+        }
+        const auto chunkSize = static_cast<size_t>((std::min)(available, ULONGLONG{size - copied}));
+        memcpy(static_cast<uint8_t*>(buffer) + copied, data, chunkSize);
+        copied += chunkSize;
+    }
+    return copied;
+}
+
+ULONGLONG MinidumpReader::readPointer(ULONGLONG address)
+{
+    ULONGLONG pointer = 0;
+    if (m_pointerSize != read(address, &pointer, m_pointerSize))
+    {
+        throw MemoryNotInDumpException("The pointer is not in the minidump!");
+    }
+    return pointer;
+}
+
+ULONGLONG MinidumpReader::followPointer(const DataSource& dataSource, const Symbol& udt, ULONGLONG address, const std::wstring& path)
+{
+    const auto& fieldPath = dataSource.resolveFieldPath(udt, path);
+    if (fieldPath.isBitfield || SymTagPointerType != getSymTag(stripTypedefs(fieldPath.type)) || sizeof(ULONGLONG) < fieldPath.size)
+    {
+        throw InvalidUsageException("Only pointer fields can be followed!");
+    }
+    ULONGLONG pointer = 0;
+    const auto size   = static_cast<size_t>(fieldPath.size);
+    if (size != read(address + fieldPath.offset, &pointer, size))
+    {
+        throw MemoryNotInDumpException("The pointer is not in the minidump!");
+    }
+    return pointer;
+}
+
+}  // namespace dia
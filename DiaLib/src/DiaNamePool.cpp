@@ -0,0 +1,46 @@
+#include "pch.h"
+//
+#include "DiaNamePool.h"
+#include "Exceptions.h"
+
+namespace dia
+{
+StringId Utf8NamePool::getNameId(const Symbol& symbol)
+{
+    const auto symIndexId   = getSymIndexId(symbol);
+    const auto cachedNameId = m_nameIdBySymIndexId.find(symIndexId);
+    if (m_nameIdBySymIndexId.end() != cachedNameId)
+    {
+        return cachedNameId->second;
+    }
+
+    // The member function hides the free one.
+    const auto name   = dia::getName(symbol);
+    const auto nameId = intern(name.c_str(), name.length());
+    m_nameIdBySymIndexId.emplace(symIndexId, nameId);
+    return nameId;
+}
+
+StringId Utf8NamePool::intern(const wchar_t* text, size_t length)
+{
+    m_conversionBuffer.clear();
+    if (0 != length)
+    {
+        const auto size = WideCharToMultiByte(CP_UTF8, 0, text, static_cast<int>(length), nullptr, 0, nullptr, nullptr);
+        if (0 == size)
+        {
+            throw WinApiException("Failed to convert a name to UTF-8!");
+        }
+        m_conversionBuffer.resize(size);
+        WideCharToMultiByte(CP_UTF8, 0, text, static_cast<int>(length), &m_conversionBuffer[0], size, nullptr, nullptr);
+    }
+    return m_interner.intern(m_conversionBuffer.data(), m_conversionBuffer.size());
+}
+
+void Utf8NamePool::clear()
+{
+    m_nameIdBySymIndexId.clear();
+    m_interner.clear();
+}
+
+}  // namespace dia
@@ -0,0 +1,204 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaParallelHash.h"
+#include "DiaSymbolEnumerator.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <utility>
+
+namespace dia
+{
+namespace
+{
+/// @brief Number of symbols a worker claims at once. Large enough to keep the shared counter cold, small enough to balance the load.
+constexpr size_t HASH_ALL_BATCH_SIZE = 64;
+
+/// @brief The hashes of a child of the global scope followed by those of its members, in enumeration order.
+/// The first of each pair is false for the symbols whose hash cannot be calculated.
+using SymbolHashes = std::vector<std::pair<bool, size_t>>;
+
+bool hasMembersToHash(const Symbol& symbol)
+{
+    const auto symTag = getSymTag(symbol);
+    return SymTagUDT == symTag || SymTagEnum == symTag;
+}
+
+std::pair<bool, size_t> tryCalcHash(const DataSource& dataSource, const Symbol& symbol)
+{
+    try
+    {
+        return {true, dataSource.calcHash(symbol)};
+    }
+    catch (const std::exception&)
+    {
+        // Some symbols carry properties which cannot be hashed (e.g. unsupported VARIANT types), leave them out.
+        return {false, 0};
+    }
+}
+
+void hashSymbolAndMembersInto(const DataSource& dataSource, const Symbol& symbol, std::unordered_map<DWORD, size_t>& hashes)
+{
+    const auto insertHash = [&dataSource, &hashes](const Symbol& hashedSymbol)
+    {
+        const auto hash = tryCalcHash(dataSource, hashedSymbol);
+        if (hash.first)
+        {
+            hashes.emplace(getSymIndexId(hashedSymbol), hash.second);
+        }
+    };
+
+    insertHash(symbol);
+    if (hasMembersToHash(symbol))
+    {
+        for (const auto& member : enumerate<Symbol>(symbol, SymTagNull))
+        {
+            insertHash(member);
+        }
+    }
+}
+
+SymbolHashes hashSymbolAndMembers(const DataSource& dataSource, const Symbol& symbol)
+{
+    SymbolHashes hashes{tryCalcHash(dataSource, symbol)};
+    if (hasMembersToHash(symbol))
+    {
+        for (const auto& member : enumerate<Symbol>(symbol, SymTagNull))
+        {
+            hashes.push_back(tryCalcHash(dataSource, member));
+        }
+    }
+    return hashes;
+}
+
+/// @brief Key the hashes a worker calculated for a child of the global scope and its members by their symIndexIds in the session of `symbol`.
+void insertSymbolHashes(const Symbol& symbol, const SymbolHashes& symbolHashes, std::unordered_map<DWORD, size_t>& hashes)
+{
+    size_t position       = 0;
+    const auto insertHash = [&symbolHashes, &hashes, &position](const Symbol& hashedSymbol)
+    {
+        if (symbolHashes.size() <= position)
+        {
+            throw InvalidUsageException("The sessions of the PDB enumerate different members!");
+        }
+        if (symbolHashes[position].first)
+        {
+            hashes.emplace(getSymIndexId(hashedSymbol), symbolHashes[position].second);
+        }
+        ++position;
+    };
+
+    insertHash(symbol);
+    if (hasMembersToHash(symbol))
+    {
+        for (const auto& member : enumerate<Symbol>(symbol, SymTagNull))
+        {
+            insertHash(member);
+        }
+    }
+    if (symbolHashes.size() != position)
+    {
+        throw InvalidUsageException("The sessions of the PDB enumerate different members!");
+    }
+}
+
+void hashSymbolsInOwnSession(const std::wstring& pdbFilePath, std::vector<SymbolHashes>& hashesByPosition, std::atomic<size_t>& nextPosition)
+{
+    const auto comInitResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    if (FAILED(comInitResult) && RPC_E_CHANGED_MODE != comInitResult)
+    {
+        throw DiaComException("Failed to initialize COM on a hashing worker!", comInitResult);
+    }
+
+    try
+    {
+        const DataSource workerDataSource{pdbFilePath};
+        // symIndexIds are assigned by each session, so symbols are addressed by their position in the enumeration of the global scope instead,
+        // which is the same in every session of the PDB.
+        std::vector<Symbol> globalSymbols{};
+        for (const auto& symbol : workerDataSource.getSymbols(SymTagNull))
+        {
+            globalSymbols.push_back(symbol);
+        }
+        if (globalSymbols.size() != hashesByPosition.size())
+        {
+            throw InvalidUsageException("The sessions of the PDB enumerate different symbols!");
+        }
+
+        for (auto batchBegin = nextPosition.fetch_add(HASH_ALL_BATCH_SIZE); batchBegin < globalSymbols.size();
+             batchBegin      = nextPosition.fetch_add(HASH_ALL_BATCH_SIZE))
+        {
+            const auto batchEnd = (std::min)(batchBegin + HASH_ALL_BATCH_SIZE, globalSymbols.size());
+            for (auto i = batchBegin; i < batchEnd; ++i)
+            {
+                // Each worker only ever writes the slots of the batches it claimed.
+                hashesByPosition[i] = hashSymbolAndMembers(workerDataSource, globalSymbols[i]);
+            }
+        }
+    }
+    catch (...)
+    {
+        if (SUCCEEDED(comInitResult))
+        {
+            CoUninitialize();
+        }
+        throw;
+    }
+
+    if (SUCCEEDED(comInitResult))
+    {
+        CoUninitialize();
+    }
+}
+}  // namespace
+
+std::unordered_map<DWORD, size_t> hashAll(const DataSource& dataSource, size_t workerCount)
+{
+    if (0 == workerCount)
+    {
+        workerCount = (std::max)(1u, std::thread::hardware_concurrency());
+    }
+
+    if (1 == workerCount)
+    {
+        std::unordered_map<DWORD, size_t> hashes{};
+        for (const auto& symbol : dataSource.getSymbols(SymTagNull))
+        {
+            hashSymbolAndMembersInto(dataSource, symbol, hashes);
+        }
+        return hashes;
+    }
+
+    std::vector<Symbol> globalSymbols{};
+    for (const auto& symbol : dataSource.getSymbols(SymTagNull))
+    {
+        globalSymbols.push_back(symbol);
+    }
+
+    const auto pdbFilePath = dataSource.getLoadedPdbFile();
+    std::vector<SymbolHashes> hashesByPosition(globalSymbols.size());
+    std::atomic<size_t> nextPosition{0};
+    std::vector<std::future<void>> workers{};
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.push_back(std::async(std::launch::async, hashSymbolsInOwnSession, std::cref(pdbFilePath), std::ref(hashesByPosition),
+                                     std::ref(nextPosition)));
+    }
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    std::unordered_map<DWORD, size_t> hashes{};
+    hashes.reserve(globalSymbols.size());
+    for (size_t i = 0; i < globalSymbols.size(); ++i)
+    {
+        insertSymbolHashes(globalSymbols[i], hashesByPosition[i], hashes);
+    }
+    return hashes;
+}
+
+}  // namespace dia
@@ -0,0 +1,99 @@
+#include "pch.h"
+//
+#include "DiaStringInterner.h"
+#include "Exceptions.h"
+#include "HashUtils.h"
+#include <algorithm>
+#include <cstring>
+
+namespace dia
+{
+namespace
+{
+/// @brief Size of the blocks of the arena. Longer strings get a block of their own.
+constexpr size_t STRING_ARENA_BLOCK_SIZE = 64 * 1024;
+constexpr size_t INITIAL_SLOT_COUNT      = 1024;
+
+uint32_t hashString(const char* data, size_t size) { return static_cast<uint32_t>(StableHasher{}.update(data, size).digest64()); }
+}  // namespace
+
+StringId StringInterner::intern(const char* data, size_t size)
+{
+    if (size >= UINT32_MAX)
+    {
+        throw InvalidUsageException("Cannot intern a string of 4GB or more!");
+    }
+    // Keep the table at most half full, so that probe sequences stay short.
+    if (2 * (m_entries.size() + 1) > m_slots.size())
+    {
+        rehash((std::max)(INITIAL_SLOT_COUNT, 2 * m_slots.size()));
+    }
+
+    const auto hash = hashString(data, size);
+    const auto mask = m_slots.size() - 1;
+    for (auto slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        const auto slotValue = m_slots[slot];
+        if (0 == slotValue)
+        {
+            const auto id = static_cast<StringId>(m_entries.size());
+            m_entries.push_back(Entry{store(data, size), static_cast<uint32_t>(size), hash});
+            m_slots[slot] = id + 1;
+            return id;
+        }
+
+        const auto& entry = m_entries[slotValue - 1];
+        if (entry.hash == hash && entry.size == size && 0 == memcmp(entry.data, data, size))
+        {
+            return slotValue - 1;
+        }
+    }
+}
+
+void StringInterner::clear()
+{
+    m_entries.clear();
+    m_slots.clear();
+    m_blocks.clear();
+    m_blockCursor    = nullptr;
+    m_blockRemaining = 0;
+    m_arenaSize      = 0;
+}
+
+const char* StringInterner::store(const char* data, size_t size)
+{
+    const auto storedSize = size + 1;
+    if (storedSize > m_blockRemaining)
+    {
+        const auto blockSize = (std::max)(STRING_ARENA_BLOCK_SIZE, storedSize);
+        m_blocks.emplace_back(new char[blockSize]);
+        m_blockCursor    = m_blocks.back().get();
+        m_blockRemaining = blockSize;
+        m_arenaSize += blockSize;
+    }
+
+    const auto stored = m_blockCursor;
+    memcpy(stored, data, size);
+    stored[size] = '\0';
+    m_blockCursor += storedSize;
+    m_blockRemaining -= storedSize;
+    return stored;
+}
+
+void StringInterner::rehash(size_t slotCount)
+{
+    std::vector<StringId> slots(slotCount, 0);
+    const auto mask = slotCount - 1;
+    for (size_t id = 0; id < m_entries.size(); ++id)
+    {
+        auto slot = m_entries[id].hash & mask;
+        while (0 != slots[slot])
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<StringId>(id + 1);
+    }
+    m_slots = std::move(slots);
+}
+
+}  // namespace dia
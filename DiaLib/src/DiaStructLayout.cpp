@@ -0,0 +1,463 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaHashing.h"
+#include "DiaStructLayout.h"
+#include "DiaSymbolEnumerator.h"
+#include "DiaTypeResolution.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <iterator>
+#include <thread>
+
+namespace dia
+{
+namespace
+{
+/// @brief Number of UDTs a worker claims at once.
+constexpr size_t LAYOUT_ANALYSIS_BATCH_SIZE = 64;
+/// @brief The largest alignment a scalar gets by default, that of `double`, `__int64` and 64-bit pointers.
+constexpr ULONGLONG MAX_SCALAR_ALIGNMENT = 8;
+
+ULONGLONG getScalarAlignment(ULONGLONG length)
+{
+    if (0 == length)
+    {
+        return 1;
+    }
+    ULONGLONG alignment = 1;
+    while (alignment < MAX_SCALAR_ALIGNMENT && 0 == length % (2 * alignment))
+    {
+        alignment *= 2;
+    }
+    return alignment;
+}
+
+ULONGLONG alignUp(ULONGLONG value, ULONGLONG alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+bool isUnion(enum UdtKind udtKind) { return UdtUnion == udtKind || UdtTaggedUnion == udtKind; }
+
+/// @brief The definition of a forward declared UDT, found by name in the global scope. A UDT which is never defined stands for itself.
+Symbol findUdtDefinition(const Symbol& udt)
+{
+    if (0 != getOrDefault(getLength, udt))
+    {
+        return udt;
+    }
+    // The lexical parent of a UDT, even a nested one, is the global scope.
+    const auto scope = getOrDefault(getLexicalParent, udt);
+    if (!scope)
+    {
+        return udt;
+    }
+    const std::wstring name = std::wstring(getName(udt));
+    for (const auto& candidate : enumerate<Symbol>(scope, SymTagUDT, name.c_str()))
+    {
+        if (0 != getOrDefault(getLength, candidate))
+        {
+            return candidate;
+        }
+    }
+    return udt;
+}
+
+/// @brief The number of bytes a field of the type takes, with forward declared UDTs taking the size of their definition.
+ULONGLONG getFieldLength(const Symbol& type)
+{
+    switch (getSymTag(type))
+    {
+    case SymTagTypedef:
+        return getFieldLength(getType(type));
+    case SymTagUDT:
+        return getLength(findUdtDefinition(type));
+    default:
+        return getLength(type);
+    }
+}
+
+/// @brief Whether a field spans more cache lines than its size requires, assuming the UDT starts on a cache line.
+bool straddlesCacheLine(const LayoutField& field, ULONGLONG cacheLineSize)
+{
+    if (0 == field.size)
+    {
+        return false;
+    }
+    const auto firstLine    = field.offset / cacheLineSize;
+    const auto lastLine     = (field.offset + field.size - 1) / cacheLineSize;
+    const auto minLineCount = (field.size + cacheLineSize - 1) / cacheLineSize;
+    return lastLine - firstLine + 1 > minLineCount;
+}
+
+/// @brief A UDT analyzed by a worker, at its index in the enumeration order.
+struct IndexedLayout
+{
+    size_t index;
+    StructLayout layout;
+};
+
+/// @brief The UDTs of a session which are defined, rather than only forward declared, in the same order in every session of the PDB.
+std::vector<Symbol> enumerateDefinedUdts(const DataSource& dataSource)
+{
+    std::vector<Symbol> udts{};
+    for (const auto& udt : dataSource.getSymbols(SymTagUDT))
+    {
+        if (0 != getOrDefault(getLength, udt))
+        {
+            udts.push_back(udt);
+        }
+    }
+    return udts;
+}
+
+std::vector<IndexedLayout> analyzeLayoutsInOwnSession(const std::wstring& pdbFilePath, size_t udtCount, ULONGLONG cacheLineSize,
+                                                      std::atomic<size_t>& nextIndex)
+{
+    const auto comInitResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    if (FAILED(comInitResult) && RPC_E_CHANGED_MODE != comInitResult)
+    {
+        throw DiaComException("Failed to initialize COM on a layout analysis worker!", comInitResult);
+    }
+
+    std::vector<IndexedLayout> layouts{};
+    try
+    {
+        const DataSource workerDataSource{pdbFilePath};
+        // symIndexIds are assigned by each session, so UDTs are addressed by their position in the enumeration instead, which is the same in
+        // every session of the PDB.
+        const auto udts = enumerateDefinedUdts(workerDataSource);
+        if (udts.size() != udtCount)
+        {
+            throw InvalidUsageException("The sessions of the PDB enumerate different symbols!");
+        }
+
+        StructLayoutAnalyzer analyzer{cacheLineSize};
+        for (auto batchBegin = nextIndex.fetch_add(LAYOUT_ANALYSIS_BATCH_SIZE); batchBegin < udts.size();
+             batchBegin      = nextIndex.fetch_add(LAYOUT_ANALYSIS_BATCH_SIZE))
+        {
+            const auto batchEnd = (std::min)(batchBegin + LAYOUT_ANALYSIS_BATCH_SIZE, udts.size());
+            for (auto i = batchBegin; i < batchEnd; ++i)
+            {
+                layouts.push_back(IndexedLayout{i, analyzer.analyze(udts[i])});
+            }
+        }
+    }
+    catch (...)
+    {
+        // The analysis fails as a whole, so the other workers need not claim any more UDTs.
+        nextIndex = udtCount;
+        if (SUCCEEDED(comInitResult))
+        {
+            CoUninitialize();
+        }
+        throw;
+    }
+
+    if (SUCCEEDED(comInitResult))
+    {
+        CoUninitialize();
+    }
+    return layouts;
+}
+}  // namespace
+
+ULONGLONG StructLayout::getHoleSize() const
+{
+    ULONGLONG holeSize = 0;
+    for (const auto& hole : holes)
+    {
+        holeSize += hole.size;
+    }
+    return holeSize;
+}
+
+size_t StructLayout::getStraddlingFieldCount() const
+{
+    return static_cast<size_t>(std::count_if(fields.begin(), fields.end(), [](const LayoutField& field) { return field.straddlesCacheLine; }));
+}
+
+StructLayoutAnalyzer::StructLayoutAnalyzer(ULONGLONG cacheLineSize)
+    : m_cacheLineSize{cacheLineSize}
+{
+    if (0 == m_cacheLineSize)
+    {
+        throw InvalidUsageException("The cache line size must not be 0!");
+    }
+}
+
+StructLayout StructLayoutAnalyzer::analyze(const Symbol& udt)
+{
+    if (SymTagUDT != getSymTag(udt))
+    {
+        throw InvalidUsageException("Only the layout of a UDT can be analyzed!");
+    }
+
+    StructLayout layout{};
+    layout.symIndexId = getSymIndexId(udt);
+    layout.name       = std::wstring(getName(udt));
+    layout.udtKind    = getUdtKind(udt);
+    layout.size       = getLength(udt);
+
+    // The alignments of the fields start as their natural alignments, and are capped by the packing once it is known.
+    auto& fields = layout.fields;
+    for (const auto& baseClass : enumerate<Symbol>(udt, SymTagBaseClass))
+    {
+        if (getOrDefault(getVirtualBaseClass, baseClass))
+        {
+            continue;
+        }
+        const auto baseType       = getType(baseClass);
+        const auto& baseAlignment = getUdtAlignment(baseType);
+        LayoutField field{LayoutFieldKind::BaseClass, std::wstring(getName(baseClass))};
+        field.offset    = static_cast<ULONGLONG>(getOffset(baseClass));
+        field.size      = baseAlignment.isEmpty ? 0 : getFieldLength(baseType);
+        field.alignment = baseAlignment.alignment;
+        fields.push_back(std::move(field));
+    }
+    for (const auto& vtable : enumerate<Symbol>(udt, SymTagVTable))
+    {
+        LayoutField field{LayoutFieldKind::VTablePointer, L"__vfptr"};
+        field.offset    = static_cast<ULONGLONG>(getOffset(vtable));
+        field.size      = getLength(getType(vtable));
+        field.alignment = getScalarAlignment(field.size);
+        fields.push_back(std::move(field));
+    }
+    for (const auto& member : enumerate<Symbol>(udt, SymTagData))
+    {
+        if (DataIsMember != getOrDefault(getDataKind, member))
+        {
+            continue;
+        }
+        const auto memberType = getType(member);
+        const auto offset     = static_cast<ULONGLONG>(getOffset(member));
+        const auto typeLength = getFieldLength(memberType);
+        if (LocIsBitField != getLocationType(member))
+        {
+            LayoutField field{LayoutFieldKind::Member, std::wstring(getName(member))};
+            field.offset    = offset;
+            field.size      = typeLength;
+            field.alignment = getAlignment(memberType);
+            fields.push_back(std::move(field));
+            continue;
+        }
+
+        // Consecutive bitfields share the storage unit they are declared at.
+        const auto bitCount = getLength(member);
+        if (!fields.empty() && LayoutFieldKind::Bitfields == fields.back().kind && fields.back().offset == offset &&
+            fields.back().size == typeLength)
+        {
+            fields.back().name += L", " + std::wstring(getName(member));
+            fields.back().usedBits += bitCount;
+            continue;
+        }
+        LayoutField field{LayoutFieldKind::Bitfields, std::wstring(getName(member))};
+        field.offset    = offset;
+        field.size      = typeLength;
+        field.alignment = getAlignment(memberType);
+        field.usedBits  = bitCount;
+        fields.push_back(std::move(field));
+    }
+    std::stable_sort(fields.begin(), fields.end(), [](const LayoutField& left, const LayoutField& right) { return left.offset < right.offset; });
+
+    // The packing is the largest power of two which every offset, and the size, is aligned to once the alignments are capped by it.
+    for (const auto& field : fields)
+    {
+        layout.naturalAlignment = (std::max)(layout.naturalAlignment, field.alignment);
+    }
+    auto packing = layout.naturalAlignment;
+    for (const auto& field : fields)
+    {
+        while (1 < packing && 0 != field.offset % (std::min)(field.alignment, packing))
+        {
+            packing /= 2;
+        }
+    }
+    while (1 < packing && 0 != layout.size % packing)
+    {
+        packing /= 2;
+    }
+    layout.alignment = packing;
+
+    ULONGLONG usedEnd      = 0;
+    ULONGLONG occupiedSize = 0;
+    ULONGLONG largestField = 0;
+    const bool isUnionUdt  = isUnion(layout.udtKind);
+    for (auto& field : fields)
+    {
+        field.alignment          = (std::min)(field.alignment, packing);
+        field.straddlesCacheLine = straddlesCacheLine(field, m_cacheLineSize);
+        if (LayoutFieldKind::Bitfields == field.kind && 8 * field.size > field.usedBits)
+        {
+            layout.unusedBitfieldBits += 8 * field.size - field.usedBits;
+        }
+        if (!isUnionUdt && field.offset > usedEnd)
+        {
+            layout.holes.push_back(LayoutHole{usedEnd, field.offset - usedEnd});
+        }
+        // The members of anonymous unions are flattened into the UDT and overlap, so only the bytes past the fields before count.
+        if (field.offset + field.size > usedEnd)
+        {
+            occupiedSize += field.offset + field.size - (std::max)(field.offset, usedEnd);
+        }
+        usedEnd = (std::max)(usedEnd, field.offset + field.size);
+        largestField = (std::max)(largestField, field.size);
+    }
+    layout.tailPadding = (layout.size > usedEnd) ? layout.size - usedEnd : 0;
+
+    // Sorting the fields by decreasing alignment leaves no padding between them, as the size of every type is a multiple of its alignment.
+    // Overlapping fields move together, as a single field spanning all of them. Every object takes at least one byte, and no analysis can make
+    // a UDT larger than it is.
+    const auto packedSize = alignUp(isUnionUdt ? largestField : occupiedSize, layout.alignment);
+    layout.minimumSize    = (std::min)(layout.size, (std::max)(ULONGLONG{1}, packedSize));
+
+    const bool isEmpty = std::all_of(fields.begin(), fields.end(), [](const LayoutField& field) { return 0 == field.size; });
+    m_udtAlignmentBySymIndexId.emplace(layout.symIndexId, UdtAlignment{layout.alignment, isEmpty});
+    return layout;
+}
+
+ULONGLONG StructLayoutAnalyzer::getAlignment(const Symbol& type)
+{
+    switch (getSymTag(type))
+    {
+    case SymTagUDT:
+        return getUdtAlignment(type).alignment;
+    case SymTagArrayType:
+    case SymTagTypedef:
+        return getAlignment(getType(type));
+    case SymTagBaseType:
+    case SymTagPointerType:
+    case SymTagEnum:
+        return getScalarAlignment(getOrDefault(getLength, type));
+    default:
+        return 1;
+    }
+}
+
+const StructLayoutAnalyzer::UdtAlignment& StructLayoutAnalyzer::getUdtAlignment(const Symbol& udt)
+{
+    const auto symIndexId = getSymIndexId(udt);
+    auto cachedAlignment  = m_udtAlignmentBySymIndexId.find(symIndexId);
+    if (m_udtAlignmentBySymIndexId.end() == cachedAlignment)
+    {
+        // A forward declaration has no fields, its alignment is the one of the definition.
+        const auto definition           = findUdtDefinition(udt);
+        const auto definitionSymIndexId = getSymIndexId(definition);
+        cachedAlignment                 = m_udtAlignmentBySymIndexId.find(definitionSymIndexId);
+        if (m_udtAlignmentBySymIndexId.end() == cachedAlignment)
+        {
+            // A UDT cannot contain itself by value, so the recursion always ends.
+            analyze(definition);
+            cachedAlignment = m_udtAlignmentBySymIndexId.find(definitionSymIndexId);
+        }
+        if (definitionSymIndexId != symIndexId)
+        {
+            cachedAlignment = m_udtAlignmentBySymIndexId.emplace(symIndexId, cachedAlignment->second).first;
+        }
+    }
+    return cachedAlignment->second;
+}
+
+std::vector<StructLayout> analyzeStructLayouts(const DataSource& dataSource, const StructLayoutReportOptions& options)
+{
+    auto workerCount = options.workerCount;
+    if (0 == workerCount)
+    {
+        workerCount = (std::max)(1u, std::thread::hardware_concurrency());
+    }
+
+    const auto udts = enumerateDefinedUdts(dataSource);
+    std::vector<StructLayout> layouts{};
+    layouts.reserve(udts.size());
+    if (1 == workerCount)
+    {
+        StructLayoutAnalyzer analyzer{options.cacheLineSize};
+        for (const auto& udt : udts)
+        {
+            layouts.push_back(analyzer.analyze(udt));
+        }
+        return layouts;
+    }
+
+    const auto pdbFilePath = dataSource.getLoadedPdbFile();
+    std::atomic<size_t> nextIndex{0};
+    std::vector<std::future<std::vector<IndexedLayout>>> workers{};
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.push_back(std::async(std::launch::async, analyzeLayoutsInOwnSession, std::cref(pdbFilePath), udts.size(), options.cacheLineSize,
+                                     std::ref(nextIndex)));
+    }
+
+    std::vector<IndexedLayout> indexedLayouts{};
+    for (auto& worker : workers)
+    {
+        auto workerLayouts = worker.get();
+        std::move(workerLayouts.begin(), workerLayouts.end(), std::back_inserter(indexedLayouts));
+    }
+    std::sort(indexedLayouts.begin(), indexedLayouts.end(),
+              [](const IndexedLayout& left, const IndexedLayout& right) { return left.index < right.index; });
+    for (auto& indexedLayout : indexedLayouts)
+    {
+        // The workers saw the symIndexIds of their own sessions.
+        indexedLayout.layout.symIndexId = getSymIndexId(udts[indexedLayout.index]);
+        layouts.push_back(std::move(indexedLayout.layout));
+    }
+    return layouts;
+}
+
+std::wstring layoutFieldKindToName(LayoutFieldKind kind)
+{
+    switch (kind)
+    {
+    case LayoutFieldKind::Member:
+        return L"Member";
+    case LayoutFieldKind::Bitfields:
+        return L"Bitfields";
+    case LayoutFieldKind::BaseClass:
+        return L"BaseClass";
+    case LayoutFieldKind::VTablePointer:
+        return L"VTablePointer";
+    default:
+        throw std::invalid_argument("Invalid LayoutFieldKind!");
+    }
+}
+
+}  // namespace dia
+
+std::wostream& operator<<(std::wostream& os, const dia::LayoutField& field)
+{
+    wchar_t range[48] = {};
+    swprintf_s(range, L"0x%04llx size=0x%llx ", field.offset, field.size);
+    os << range << dia::layoutFieldKindToName(field.kind) << L" " << field.name;
+    if (dia::LayoutFieldKind::Bitfields == field.kind)
+    {
+        os << L" bits=" << field.usedBits << L"/" << 8 * field.size;
+    }
+    if (field.straddlesCacheLine)
+    {
+        os << L" straddles-cache-line";
+    }
+    return os;
+}
+
+std::wostream& operator<<(std::wostream& os, const dia::StructLayout& layout)
+{
+    wchar_t summary[160] = {};
+    swprintf_s(summary, L" size=0x%llx align=0x%llx holes=0x%llx tail=0x%llx minimum=0x%llx", layout.size, layout.alignment,
+               layout.getHoleSize(), layout.tailPadding, layout.minimumSize);
+    os << dia::udtKindToStaticName(layout.udtKind) << L" " << layout.name << summary << std::endl;
+
+    // Holes are listed between the fields they separate.
+    auto hole = layout.holes.begin();
+    for (const auto& field : layout.fields)
+    {
+        for (; layout.holes.end() != hole && hole->offset < field.offset; ++hole)
+        {
+            wchar_t holeLine[48] = {};
+            swprintf_s(holeLine, L"    0x%04llx size=0x%llx Hole", hole->offset, hole->size);
+            os << holeLine << std::endl;
+        }
+        os << L"    " << field << std::endl;
+    }
+    return os;
+}
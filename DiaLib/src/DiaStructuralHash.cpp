@@ -0,0 +1,255 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaHashing.h"
+#include "DiaStructuralHash.h"
+#include "DiaSymbolEnumerator.h"
+#include "HashUtils.h"
+
+namespace dia
+{
+namespace
+{
+/// @brief Hash the const/volatile/unaligned modifiers shared by all type symbols.
+size_t hashTypeModifiers(const Symbol& symbol, size_t seed)
+{
+    size_t calculatedHash = seed;
+    hash_combine(calculatedHash, getOrDefault(getConstType, symbol), getOrDefault(getVolatileType, symbol), getOrDefault(getUnalignedType, symbol));
+    return calculatedHash;
+}
+}  // namespace
+
+size_t StructuralHasher::hash(const Symbol& symbol) { return hashType(symbol); }
+
+std::unordered_map<DWORD, size_t> StructuralHasher::hashTypes(const DataSource& dataSource)
+{
+    std::unordered_map<DWORD, size_t> hashes{};
+    for (const auto symTag : {SymTagUDT, SymTagEnum, SymTagTypedef})
+    {
+        for (const auto& type : dataSource.getSymbols(symTag))
+        {
+            hashes.emplace(getSymIndexId(type), hashType(type));
+        }
+    }
+    return hashes;
+}
+
+void StructuralHasher::clear()
+{
+    m_hashBySymIndexId.clear();
+    m_rootHashBySymIndexId.clear();
+    m_depthBySymbolInProgress.clear();
+    m_lowestPlaceholderDepth = SIZE_MAX;
+}
+
+size_t StructuralHasher::hashType(const Symbol& symbol)
+{
+    const DWORD symIndexId = getSymIndexId(symbol);
+    const auto memoizedHash = m_hashBySymIndexId.find(symIndexId);
+    if (m_hashBySymIndexId.end() != memoizedHash)
+    {
+        return memoizedHash->second;
+    }
+
+    const size_t depth = m_depthBySymbolInProgress.size();
+    if (0 == depth)
+    {
+        const auto memoizedRootHash = m_rootHashBySymIndexId.find(symIndexId);
+        if (m_rootHashBySymIndexId.end() != memoizedRootHash)
+        {
+            return memoizedRootHash->second;
+        }
+    }
+
+    const auto symbolInProgress = m_depthBySymbolInProgress.emplace(symIndexId, depth);
+    if (!symbolInProgress.second)
+    {
+        // The symbol (indirectly) contains itself. Named types are always referenced nominally through pointers, so this only happens with
+        // unnamed types. The placeholder is the nominal reference, which only depends on the symbol itself.
+        m_lowestPlaceholderDepth = (std::min)(m_lowestPlaceholderDepth, symbolInProgress.first->second);
+        return hashNominal(symbol);
+    }
+
+    const size_t outerLowestPlaceholderDepth = m_lowestPlaceholderDepth;
+    m_lowestPlaceholderDepth                 = SIZE_MAX;
+    size_t calculatedHash                    = m_seed;
+    try
+    {
+        const auto symTag = getSymTag(symbol);
+        hash_combine(calculatedHash, symTag);
+        switch (symTag)
+        {
+        case SymTagUDT:
+            hash_combine(calculatedHash, hashUserDefinedType(symbol));
+            break;
+        case SymTagEnum:
+            hash_combine(calculatedHash, hashEnum(symbol));
+            break;
+        case SymTagFunctionType:
+            hash_combine(calculatedHash, hashFunctionType(symbol));
+            break;
+        case SymTagData:
+            hash_combine(calculatedHash, hashDataMember(symbol));
+            break;
+        case SymTagTypedef:
+            hash_combine(calculatedHash, getName(symbol), hashType(getType(symbol)));
+            break;
+        case SymTagPointerType:
+            hash_combine(calculatedHash, getLength(symbol), getOrDefault(getReference, symbol), getOrDefault(getRValueReference, symbol),
+                         hashTypeModifiers(symbol, m_seed), hashReference(getType(symbol)));
+            break;
+        case SymTagArrayType:
+            hash_combine(calculatedHash, getCount(symbol), getLength(symbol), hashTypeModifiers(symbol, m_seed), hashType(getType(symbol)));
+            break;
+        case SymTagBaseType:
+            hash_combine(calculatedHash, getBaseType(symbol), getLength(symbol), hashTypeModifiers(symbol, m_seed));
+            break;
+        case SymTagFunctionArgType:
+            hash_combine(calculatedHash, hashReference(getType(symbol)));
+            break;
+        case SymTagFunction:
+            hash_combine(calculatedHash, getName(symbol), hashType(getType(symbol)));
+            break;
+        default:
+            hash_combine(calculatedHash, getOrDefault(getName, symbol));
+            break;
+        }
+    }
+    catch (...)
+    {
+        m_depthBySymbolInProgress.erase(symIndexId);
+        m_lowestPlaceholderDepth = outerLowestPlaceholderDepth;
+        throw;
+    }
+
+    m_depthBySymbolInProgress.erase(symIndexId);
+    if (SIZE_MAX == m_lowestPlaceholderDepth)
+    {
+        m_hashBySymIndexId.emplace(symIndexId, calculatedHash);
+    }
+    else if (0 == depth)
+    {
+        // The hash depends on its own placeholder only, but the types it contains would be hashed differently from within another one of them.
+        m_rootHashBySymIndexId.emplace(symIndexId, calculatedHash);
+    }
+    // Placeholders of the types enclosing this one also make the enclosing hashes depend on their context.
+    m_lowestPlaceholderDepth = (std::min)(outerLowestPlaceholderDepth, (depth <= m_lowestPlaceholderDepth) ? SIZE_MAX : m_lowestPlaceholderDepth);
+    return calculatedHash;
+}
+
+size_t StructuralHasher::hashReference(const Symbol& symbol)
+{
+    switch (getSymTag(symbol))
+    {
+    case SymTagUDT:
+    case SymTagEnum:
+    case SymTagTypedef:
+        if (!isSymbolUnnamed(symbol))
+        {
+            return hashNominal(symbol);
+        }
+        break;
+    default:
+        break;
+    }
+    // Anything else (base types, pointers, function types, unnamed types, ...) has no name to refer to it by, so it is hashed structurally.
+    return hashType(symbol);
+}
+
+size_t StructuralHasher::hashNominal(const Symbol& symbol) const
+{
+    size_t calculatedHash = m_seed;
+    const auto symTag     = getSymTag(symbol);
+    hash_combine(calculatedHash, std::wstring(L"nominal"), symTag, getOrDefault(getName, symbol));
+    if (SymTagUDT == symTag)
+    {
+        hash_combine(calculatedHash, getUdtKind(symbol));
+    }
+    return calculatedHash;
+}
+
+size_t StructuralHasher::hashUserDefinedType(const Symbol& udt)
+{
+    size_t calculatedHash = m_seed;
+    hash_combine(calculatedHash, getUdtKind(udt), getName(udt), getOrDefault(getLength, udt), getOrDefault(getPacked, udt),
+                 getOrDefault(getScoped, udt), hashTypeModifiers(udt));
+
+    // Children are enumerated in declaration order, which makes the member order part of the hash.
+    for (const auto& child : enumerate<Symbol>(udt, SymTagNull))
+    {
+        const auto childSymTag = getSymTag(child);
+        switch (childSymTag)
+        {
+        case SymTagBaseClass:
+            hash_combine(calculatedHash, childSymTag, getOrDefault(getOffset, child), getOrDefault(getVirtualBaseClass, child),
+                         getOrDefault(getIndirectVirtualBaseClass, child), getOrDefault(getAccess, child), hashType(getType(child)));
+            break;
+        case SymTagData:
+            hash_combine(calculatedHash, childSymTag, hashDataMember(child));
+            break;
+        case SymTagFunction:
+            hash_combine(calculatedHash, childSymTag, getName(child), getOrDefault(getVirtual, child), getOrDefault(getPure, child),
+                         getOrDefault(getIntro, child), getOrDefault(getIsStatic, child), getOrDefault(getAccess, child), hashType(getType(child)));
+            break;
+        case SymTagUDT:
+        case SymTagEnum:
+        case SymTagTypedef:
+            // Nested types
+            hash_combine(calculatedHash, childSymTag, hashReference(child));
+            break;
+        default:
+            break;
+        }
+    }
+    return calculatedHash;
+}
+
+size_t StructuralHasher::hashEnum(const Symbol& enumSymbol)
+{
+    size_t calculatedHash = m_seed;
+    hash_combine(calculatedHash, getName(enumSymbol), getOrDefault(getBaseType, enumSymbol), getOrDefault(getLength, enumSymbol),
+                 getOrDefault(getScoped, enumSymbol), hashTypeModifiers(enumSymbol));
+    for (const auto& value : enumerate<Symbol>(enumSymbol, SymTagData))
+    {
+        hash_combine(calculatedHash, getName(value), getValue(value));
+    }
+    return calculatedHash;
+}
+
+size_t StructuralHasher::hashFunctionType(const Symbol& functionType)
+{
+    size_t calculatedHash = m_seed;
+    hash_combine(calculatedHash, getCallingConvention(functionType), getOrDefault(getCount, functionType), getOrDefault(getThisAdjust, functionType),
+                 hashTypeModifiers(functionType), hashReference(getType(functionType)));
+    for (const auto& argument : enumerate<Symbol>(functionType, SymTagFunctionArgType))
+    {
+        hash_combine(calculatedHash, hashReference(getType(argument)));
+    }
+    return calculatedHash;
+}
+
+size_t StructuralHasher::hashDataMember(const Symbol& dataMember)
+{
+    size_t calculatedHash  = m_seed;
+    const auto locationType = getLocationType(dataMember);
+    hash_combine(calculatedHash, getName(dataMember), getDataKind(dataMember), locationType, getOrDefault(getIsStatic, dataMember),
+                 getOrDefault(getAccess, dataMember));
+    switch (locationType)
+    {
+    case LocIsThisRel:
+        hash_combine(calculatedHash, getOffset(dataMember));
+        break;
+    case LocIsBitField:
+        hash_combine(calculatedHash, getOffset(dataMember), getBitPosition(dataMember), getLength(dataMember));
+        break;
+    case LocIsConstant:
+        hash_combine(calculatedHash, getValue(dataMember));
+        break;
+    default:
+        break;
+    }
+    hash_combine(calculatedHash, hashType(getType(dataMember)));
+    return calculatedHash;
+}
+
+}  // namespace dia
@@ -4,6 +4,7 @@
 #include "DiaHashing.h"
 #include "DiaPrint.h"
 #include "DiaSymbol.h"
+#include "DiaSymbolDump.h"
 #include "DiaTypeResolution.h"
 #include "DiaUserDefinedTypeWrapper.h"
 #include "Exceptions.h"
@@ -106,13 +107,33 @@ template std::set<Symbol> queryDependencies<UserDefinedType>(const UserDefinedTy
 size_t Symbol::calcHash() const
 {
     _ASSERT(nullptr != this);
-    if (!!!*this)
+    StructuralHasher structuralHasher{};
+    return calcSymbolHash(*this, structuralHasher);
+}
+
+size_t calcSymbolHash(const Symbol& symbol, StructuralHasher& structuralHasher)
+{
+    if (!!!symbol)
     {
         // Uninitialized instance :(
         return 0;
     }
-#define __RETURN_HASH_SYMBOL(x) return std::hash<T>()(x);
-    XBY_SYMBOL_TYPE_T((*this), T, __RETURN_HASH_SYMBOL);
+
+    // Tags without a dedicated symbol type, which XBY_SYMBOL_TYPE_T does not cover.
+    switch (symbol.getSymTag())
+    {
+    case SymTagBlock:
+    case SymTagFuncDebugStart:
+    case SymTagFuncDebugEnd:
+    case SymTagUsingNamespace:
+    case SymTagVTableShape:
+    case SymTagVTable:
+        return calcUntypedSymbolHash(symbol);
+    default:
+        break;
+    }
+#define __RETURN_HASH_SYMBOL(x) return calcTypedSymbolHash(x, structuralHasher);
+    XBY_SYMBOL_TYPE_T(symbol, T, __RETURN_HASH_SYMBOL);
 }
 
 bool Symbol::operator==(const Symbol& other) const { return getUid() == other.getUid(); }
@@ -152,6 +173,21 @@ std::wostream& streamSymbolTypeModifiers(std::wostream& os, const Array& v)
 
 std::wostream& operator<<(std::wostream& os, const dia::Symbol& v)
 {
+    switch (v.getSymTag())
+    {
+    // These tags have no symbol type to dispatch to.
+    case SymTagBlock:
+    case SymTagFuncDebugStart:
+    case SymTagFuncDebugEnd:
+    case SymTagUsingNamespace:
+    case SymTagVTableShape:
+    case SymTagVTable:
+        os << dia::formatSymbol(v);
+        return os;
+    default:
+        break;
+    }
+
 #define __OS_STREAM_SYMBOL(x) os << x;
     XBY_SYMBOL_TYPE_T((v), T, __OS_STREAM_SYMBOL);
     return os;
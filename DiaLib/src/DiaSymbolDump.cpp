@@ -0,0 +1,777 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaHashing.h"
+#include "DiaSymbolDump.h"
+#include "DiaSymbolEnumerator.h"
+#include "DiaTypeResolution.h"
+#include "Exceptions.h"
+#include "VariantUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <exception>
+#include <future>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+
+namespace dia
+{
+namespace
+{
+/// @brief The dump is handed to the sink in chunks of at least this size.
+constexpr size_t SYMBOL_DUMP_BUFFER_SIZE = 64 * 1024;
+
+const wchar_t* dataKindToKeyword(enum DataKind dataKind)
+{
+    switch (dataKind)
+    {
+    case DataIsLocal:
+        return L"local";
+    case DataIsStaticLocal:
+        return L"static-local";
+    case DataIsParam:
+        return L"param";
+    case DataIsObjectPtr:
+        return L"this";
+    case DataIsFileStatic:
+        return L"file-static";
+    case DataIsGlobal:
+        return L"global";
+    case DataIsMember:
+        return L"member";
+    case DataIsStaticMember:
+        return L"static-member";
+    case DataIsConstant:
+        return L"constant";
+    default:
+        return L"unknown";
+    }
+}
+
+void appendUtf8(const wchar_t* text, size_t length, std::string& out)
+{
+    if (0 == length)
+    {
+        return;
+    }
+    const auto size = WideCharToMultiByte(CP_UTF8, 0, text, static_cast<int>(length), nullptr, 0, nullptr, nullptr);
+    if (0 == size)
+    {
+        throw WinApiException("Failed to convert the dump to UTF-8!");
+    }
+    const auto offset = out.size();
+    out.resize(offset + size);
+    WideCharToMultiByte(CP_UTF8, 0, text, static_cast<int>(length), &out[offset], size, nullptr, nullptr);
+}
+
+void appendSectionTitle(const wchar_t* title, std::wstring& out)
+{
+    out += L'\n';
+    out += title;
+    out += L'\n';
+    out.append(wcslen(title), L'=');
+    out += L'\n';
+}
+
+/// @brief Collects the text of the calling thread, and the sections rendered by the workers, and hands them to the sink in large UTF-8 chunks.
+class BufferedDumpWriter
+{
+public:
+    explicit BufferedDumpWriter(const SymbolDumpSink& sink)
+        : m_sink{sink}
+    {
+        m_buffer.reserve(SYMBOL_DUMP_BUFFER_SIZE);
+    }
+
+    /// @brief The text to write, which may be appended to directly as long as `flushIfFull` is only called between symbols.
+    std::wstring& getBuffer() { return m_buffer; }
+
+    /// @brief Write a section rendered by a worker, after the text written so far.
+    void writeUtf8(const std::string& text)
+    {
+        convertBuffer();
+        m_utf8Buffer += text;
+        flushIfFull();
+    }
+
+    void flushIfFull()
+    {
+        if (m_buffer.size() + m_utf8Buffer.size() >= SYMBOL_DUMP_BUFFER_SIZE)
+        {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        convertBuffer();
+        if (!m_utf8Buffer.empty())
+        {
+            m_sink(m_utf8Buffer.data(), m_utf8Buffer.size());
+            m_utf8Buffer.clear();
+        }
+    }
+
+private:
+    void convertBuffer()
+    {
+        appendUtf8(m_buffer.data(), m_buffer.size(), m_utf8Buffer);
+        m_buffer.clear();
+    }
+
+    const SymbolDumpSink& m_sink;
+    std::wstring m_buffer{};
+    std::string m_utf8Buffer{};
+};
+
+/// @brief The compiland sections rendered by the workers, handed over to the writer in order as soon as each one is ready.
+class RenderedSections
+{
+public:
+    explicit RenderedSections(size_t sectionCount)
+        : m_sections(sectionCount)
+        , m_isReady(sectionCount, false)
+    {
+    }
+
+    void complete(size_t index, std::string&& section)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{m_mutex};
+            m_sections[index] = std::move(section);
+            m_isReady[index]  = true;
+        }
+        m_readyCondition.notify_all();
+    }
+
+    void fail(std::exception_ptr error)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{m_mutex};
+            if (!m_error)
+            {
+                m_error = error;
+            }
+            m_hasFailed = true;
+        }
+        m_readyCondition.notify_all();
+    }
+
+    /// @brief Whether a worker failed, in which case the others may stop rendering.
+    bool hasFailed() const { return m_hasFailed; }
+
+    /// @brief Wait for a section and take it over.
+    /// @throws The exception of the worker which failed, if the section will never be ready.
+    std::string take(size_t index)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_readyCondition.wait(lock, [this, index]() { return m_isReady[index] || m_error; });
+        if (!m_isReady[index])
+        {
+            std::rethrow_exception(m_error);
+        }
+        return std::move(m_sections[index]);
+    }
+
+private:
+    std::mutex m_mutex{};
+    std::condition_variable m_readyCondition{};
+    std::vector<std::string> m_sections;
+    std::vector<bool> m_isReady;
+    std::exception_ptr m_error{};
+    std::atomic<bool> m_hasFailed{false};
+};
+
+void renderCompilandsInOwnSession(const std::wstring& pdbFilePath, size_t compilandCount, RenderedSections& sections,
+                                  std::atomic<size_t>& nextIndex)
+{
+    const auto comInitResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    if (FAILED(comInitResult) && RPC_E_CHANGED_MODE != comInitResult)
+    {
+        throw DiaComException("Failed to initialize COM on a dump worker!", comInitResult);
+    }
+
+    try
+    {
+        const DataSource workerDataSource{pdbFilePath};
+        // symIndexIds are assigned by each session, so compilands are addressed by their position in the enumeration instead, which is the same
+        // in every session of the PDB.
+        std::vector<Symbol> compilands{};
+        for (const auto& compiland : workerDataSource.getCompilands())
+        {
+            compilands.push_back(compiland);
+        }
+        if (compilands.size() != compilandCount)
+        {
+            throw InvalidUsageException("The sessions of the PDB enumerate different symbols!");
+        }
+
+        TypeNameResolver typeNameResolver{};
+        std::wstring text{};
+        SymbolDumpFormatter formatter{typeNameResolver, text};
+        // Compilands are few and large, so they are claimed one at a time.
+        for (auto index = nextIndex++; index < compilands.size() && !sections.hasFailed(); index = nextIndex++)
+        {
+            text.clear();
+            formatter.formatSymbolTree(compilands[index]);
+            std::string section{};
+            appendUtf8(text.data(), text.size(), section);
+            sections.complete(index, std::move(section));
+        }
+    }
+    catch (...)
+    {
+        if (SUCCEEDED(comInitResult))
+        {
+            CoUninitialize();
+        }
+        throw;
+    }
+
+    if (SUCCEEDED(comInitResult))
+    {
+        CoUninitialize();
+    }
+}
+
+void renderCompilands(const std::wstring& pdbFilePath, size_t compilandCount, RenderedSections& sections, std::atomic<size_t>& nextIndex)
+{
+    try
+    {
+        renderCompilandsInOwnSession(pdbFilePath, compilandCount, sections, nextIndex);
+    }
+    catch (...)
+    {
+        // The writer waits on the sections rather than on the workers, so that is where the failure must go.
+        sections.fail(std::current_exception());
+    }
+}
+
+void dumpGlobalSymbols(const DataSource& dataSource, enum SymTagEnum symTag, SymbolDumpFormatter& formatter, BufferedDumpWriter& writer)
+{
+    for (const auto& symbol : dataSource.getSymbols(symTag))
+    {
+        formatter.formatSymbolTree(symbol);
+        writer.flushIfFull();
+    }
+}
+
+void dumpCompilands(const DataSource& dataSource, const SymbolDumpOptions& options, SymbolDumpFormatter& formatter, BufferedDumpWriter& writer)
+{
+    auto workerCount = options.workerCount;
+    if (0 == workerCount)
+    {
+        workerCount = (std::max)(1u, std::thread::hardware_concurrency());
+    }
+
+    // The symIndexIds of the workers would be those of their own sessions, so only the given data source may dump them.
+    if (1 == workerCount || options.includeSymIndexIds)
+    {
+        dumpGlobalSymbols(dataSource, SymTagCompiland, formatter, writer);
+        return;
+    }
+
+    const auto compilandCount = dataSource.getCompilands().count();
+    const auto pdbFilePath    = dataSource.getLoadedPdbFile();
+    RenderedSections sections{compilandCount};
+    std::atomic<size_t> nextIndex{0};
+    // Declared after the sections, so that leaving early waits for the workers before the sections go away.
+    std::vector<std::future<void>> workers{};
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.push_back(
+            std::async(std::launch::async, renderCompilands, std::cref(pdbFilePath), compilandCount, std::ref(sections), std::ref(nextIndex)));
+    }
+
+    try
+    {
+        for (size_t i = 0; i < compilandCount; ++i)
+        {
+            writer.writeUtf8(sections.take(i));
+        }
+    }
+    catch (...)
+    {
+        // A throwing sink must stop the workers too, or leaving would wait for them to render every remaining compiland.
+        sections.fail(std::current_exception());
+        throw;
+    }
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+}
+}  // namespace
+
+SymbolDumpFormatter::SymbolDumpFormatter(TypeNameResolver& typeNameResolver, std::wstring& out, bool withSymIndexIds)
+    : m_typeNameResolver{typeNameResolver}
+    , m_out{out}
+    , m_withSymIndexIds{withSymIndexIds}
+{
+}
+
+void SymbolDumpFormatter::formatSymbol(const Symbol& symbol)
+{
+    const auto symTag = getSymTag(symbol);
+    append(symTagToStaticName(symTag));
+    if (m_withSymIndexIds)
+    {
+        append(L" #");
+        appendUnsigned(getSymIndexId(symbol));
+    }
+
+    switch (symTag)
+    {
+    case SymTagExe:
+        appendName(symbol);
+        appendUnsignedField(L"age", getOrDefault(getAge, symbol));
+        appendHexField(L"signature", getOrDefault(getSignature, symbol));
+        appendHexField(L"machine", getOrDefault(getMachineType, symbol));
+        break;
+    case SymTagCompiland:
+        appendName(symbol);
+        appendStringField(L"library", getOrDefault(getLibraryName, symbol));
+        appendStringField(L"source", getOrDefault(getSourceFileName, symbol));
+        break;
+    case SymTagCompilandDetails:
+        appendStringField(L"compiler", getOrDefault(getCompilerName, symbol));
+        appendUnsignedField(L"language", getOrDefault(getLanguage, symbol));
+        appendHexField(L"platform", getOrDefault(getPlatform, symbol));
+        appendUnsignedField(L"frontend", getOrDefault(getFrontEndMajor, symbol));
+        appendUnsignedField(L"backend", getOrDefault(getBackEndMajor, symbol));
+        break;
+    case SymTagCompilandEnv:
+        appendName(symbol);
+        appendValueField(symbol);
+        break;
+    case SymTagFunction:
+        appendName(symbol);
+        appendTypeField(symbol);
+        appendAddressFields(symbol);
+        appendFlag(L"virtual", getOrDefault(getVirtual, symbol));
+        appendFlag(L"pure", getOrDefault(getPure, symbol));
+        break;
+    case SymTagData:
+        m_out += L' ';
+        append(dataKindToKeyword(getOrDefault(getDataKind, symbol)));
+        appendName(symbol);
+        appendTypeField(symbol);
+        appendLocationFields(symbol);
+        break;
+    case SymTagUDT:
+        m_out += L' ';
+        append(udtKindToStaticName(getOrDefault(getUdtKind, symbol)));
+        appendName(symbol);
+        appendHexField(L"length", getOrDefault(getLength, symbol));
+        appendFlag(L"packed", getOrDefault(getPacked, symbol));
+        break;
+    case SymTagEnum:
+    case SymTagTypedef:
+        appendName(symbol);
+        appendTypeField(symbol);
+        break;
+    case SymTagBaseClass:
+        appendName(symbol);
+        appendOffsetField(getOrDefault(getOffset, symbol));
+        appendFlag(L"virtual", getOrDefault(getVirtualBaseClass, symbol));
+        break;
+    case SymTagPointerType:
+    case SymTagArrayType:
+    case SymTagBaseType:
+    case SymTagFunctionType:
+        m_out += L' ';
+        appendTypeName(symbol);
+        break;
+    case SymTagFunctionArgType:
+    case SymTagVTable:
+        appendTypeField(symbol);
+        break;
+    case SymTagVTableShape:
+        appendUnsignedField(L"count", getOrDefault(getCount, symbol));
+        break;
+    case SymTagThunk:
+        appendName(symbol);
+        appendAddressFields(symbol);
+        appendUnsignedField(L"ordinal", getOrDefault(getThunkOrdinal, symbol));
+        appendHexField(L"target", getOrDefault(getTargetRelativeVirtualAddress, symbol));
+        break;
+    case SymTagCallSite:
+    case SymTagHeapAllocationSite:
+        appendTypeField(symbol);
+        appendAddressFields(symbol);
+        break;
+    case SymTagCoffGroup:
+        appendName(symbol);
+        appendAddressFields(symbol);
+        appendHexField(L"characteristics", getOrDefault(getCharacteristics, symbol));
+        break;
+    case SymTagBlock:
+    case SymTagLabel:
+    case SymTagFuncDebugStart:
+    case SymTagFuncDebugEnd:
+    case SymTagPublicSymbol:
+    case SymTagExport:
+    case SymTagAnnotation:
+    case SymTagInlineSite:
+    case SymTagCaller:
+    case SymTagCallee:
+    case SymTagInlinee:
+        appendName(symbol);
+        appendAddressFields(symbol);
+        break;
+    default:
+        appendName(symbol);
+        break;
+    }
+}
+
+void SymbolDumpFormatter::formatSymbolLine(const Symbol& symbol, size_t depth)
+{
+    m_out.append(2 * depth, L' ');
+    const auto lineStart = m_out.size();
+    try
+    {
+        formatSymbol(symbol);
+    }
+    catch (const std::exception& exception)
+    {
+        m_out.resize(lineStart);
+        append(L"<unavailable: ");
+        for (const char* character = exception.what(); *character; ++character)
+        {
+            m_out += static_cast<wchar_t>(static_cast<unsigned char>(*character));
+        }
+        m_out += L'>';
+    }
+    m_out += L'\n';
+}
+
+void SymbolDumpFormatter::formatSymbolTree(const Symbol& symbol, size_t depth)
+{
+    formatSymbolLine(symbol, depth);
+    switch (getSymTag(symbol))
+    {
+    case SymTagUDT:
+    case SymTagEnum:
+        for (const auto& member : enumerate<Symbol>(symbol, SymTagNull))
+        {
+            formatSymbolLine(member, depth + 1);
+        }
+        break;
+    case SymTagCompiland:
+    case SymTagFunction:
+    case SymTagBlock:
+        for (const auto& child : enumerate<Symbol>(symbol, SymTagNull))
+        {
+            formatSymbolTree(child, depth + 1);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void SymbolDumpFormatter::append(const wchar_t* text) { m_out += text; }
+
+void SymbolDumpFormatter::append(const wchar_t* text, size_t length) { m_out.append(text, length); }
+
+void SymbolDumpFormatter::appendUnsigned(ULONGLONG value)
+{
+    wchar_t digits[20];
+    auto first = _countof(digits);
+    do
+    {
+        digits[--first] = static_cast<wchar_t>(L'0' + value % 10);
+        value /= 10;
+    } while (0 != value);
+    append(digits + first, _countof(digits) - first);
+}
+
+void SymbolDumpFormatter::appendSigned(LONGLONG value)
+{
+    if (value < 0)
+    {
+        m_out += L'-';
+        appendUnsigned(0ull - static_cast<ULONGLONG>(value));
+        return;
+    }
+    appendUnsigned(static_cast<ULONGLONG>(value));
+}
+
+void SymbolDumpFormatter::appendHex(ULONGLONG value)
+{
+    const wchar_t hexDigits[] = L"0123456789abcdef";
+    wchar_t digits[18];
+    auto first = _countof(digits);
+    do
+    {
+        digits[--first] = hexDigits[value & 0xF];
+        value >>= 4;
+    } while (0 != value);
+    digits[--first] = L'x';
+    digits[--first] = L'0';
+    append(digits + first, _countof(digits) - first);
+}
+
+void SymbolDumpFormatter::appendName(const Symbol& symbol)
+{
+    const auto name = getOrDefault(getName, symbol);
+    if (0 != name.length())
+    {
+        append(L" `");
+        append(name.c_str(), name.length());
+        m_out += L'`';
+    }
+}
+
+void SymbolDumpFormatter::appendStringField(const wchar_t* label, const BstrWrapper& text)
+{
+    if (0 != text.length())
+    {
+        m_out += L' ';
+        append(label);
+        append(L"=`");
+        append(text.c_str(), text.length());
+        m_out += L'`';
+    }
+}
+
+void SymbolDumpFormatter::appendUnsignedField(const wchar_t* label, ULONGLONG value)
+{
+    m_out += L' ';
+    append(label);
+    m_out += L'=';
+    appendUnsigned(value);
+}
+
+void SymbolDumpFormatter::appendHexField(const wchar_t* label, ULONGLONG value)
+{
+    m_out += L' ';
+    append(label);
+    m_out += L'=';
+    appendHex(value);
+}
+
+void SymbolDumpFormatter::appendOffsetField(LONGLONG offset)
+{
+    append(L" offset=");
+    if (offset < 0)
+    {
+        m_out += L'-';
+        appendHex(0ull - static_cast<ULONGLONG>(offset));
+        return;
+    }
+    appendHex(static_cast<ULONGLONG>(offset));
+}
+
+void SymbolDumpFormatter::appendFlag(const wchar_t* label, bool isSet)
+{
+    if (isSet)
+    {
+        m_out += L' ';
+        append(label);
+    }
+}
+
+void SymbolDumpFormatter::appendTypeName(const Symbol& type)
+{
+    try
+    {
+        const auto& typeName = m_typeNameResolver.resolve(type);
+        append(typeName.data(), typeName.size());
+    }
+    catch (const std::exception&)
+    {
+        append(L"<unresolved>");
+    }
+}
+
+void SymbolDumpFormatter::appendTypeField(const Symbol& symbol)
+{
+    const auto type = getOrDefault(getType, symbol);
+    if (!type)
+    {
+        return;
+    }
+    append(L" type=");
+    appendTypeName(type);
+}
+
+void SymbolDumpFormatter::appendAddressFields(const Symbol& symbol)
+{
+    const auto relativeVirtualAddress = getOrDefault(getRelativeVirtualAddress, symbol);
+    if (0 != relativeVirtualAddress)
+    {
+        appendHexField(L"rva", relativeVirtualAddress);
+    }
+    const auto length = getOrDefault(getLength, symbol);
+    if (0 != length)
+    {
+        appendHexField(L"length", length);
+    }
+}
+
+void SymbolDumpFormatter::appendLocationFields(const Symbol& symbol)
+{
+    const auto locationType = getOrDefault(getLocationType, symbol);
+    switch (locationType)
+    {
+    case LocIsNull:
+        break;
+    case LocIsStatic:
+        appendHexField(L"rva", getOrDefault(getRelativeVirtualAddress, symbol));
+        break;
+    case LocIsTLS:
+        append(L" tls");
+        appendOffsetField(getOrDefault(getAddressOffset, symbol));
+        break;
+    case LocIsRegRel:
+        appendUnsignedField(L"register", getOrDefault(getRegisterId, symbol));
+        appendOffsetField(getOrDefault(getOffset, symbol));
+        break;
+    case LocIsThisRel:
+        appendOffsetField(getOrDefault(getOffset, symbol));
+        break;
+    case LocIsEnregistered:
+        appendUnsignedField(L"register", getOrDefault(getRegisterId, symbol));
+        break;
+    case LocIsBitField:
+        appendOffsetField(getOrDefault(getOffset, symbol));
+        appendUnsignedField(L"bit", getOrDefault(getBitPosition, symbol));
+        appendUnsignedField(L"bits", getOrDefault(getLength, symbol));
+        break;
+    case LocIsConstant:
+        appendValueField(symbol);
+        break;
+    default:
+        append(L" location=");
+        append(locationTypeToStaticName(locationType));
+        break;
+    }
+}
+
+void SymbolDumpFormatter::appendValueField(const Symbol& symbol)
+{
+    auto value = getOrDefault(getValue, symbol);
+    switch (value.vt)
+    {
+    case VT_EMPTY:
+        return;
+    case VT_I1:
+    case VT_I2:
+    case VT_I4:
+    case VT_I8:
+    case VT_INT:
+        append(L" value=");
+        appendSigned(variantToInteger(value));
+        break;
+    case VT_UI1:
+    case VT_UI2:
+    case VT_UI4:
+    case VT_UI8:
+    case VT_UINT:
+        append(L" value=");
+        appendUnsigned(static_cast<ULONGLONG>(variantToInteger(value)));
+        break;
+    case VT_BOOL:
+        append(VARIANT_FALSE != value.boolVal ? L" value=true" : L" value=false");
+        break;
+    case VT_R4:
+    case VT_R8:
+    {
+        wchar_t digits[32];
+        swprintf_s(digits, L"%g", VT_R4 == value.vt ? value.fltVal : value.dblVal);
+        append(L" value=");
+        append(digits);
+        break;
+    }
+    case VT_BSTR:
+        append(L" value=\"");
+        append(value.bstrVal, SysStringLen(value.bstrVal));
+        m_out += L'"';
+        break;
+    default:
+        append(L" value=<vt ");
+        appendUnsigned(value.vt);
+        m_out += L'>';
+        break;
+    }
+    VariantClear(&value);
+}
+
+std::wstring formatSymbol(const Symbol& symbol)
+{
+    TypeNameResolver typeNameResolver{};
+    std::wstring text{};
+    SymbolDumpFormatter{typeNameResolver, text}.formatSymbol(symbol);
+    return text;
+}
+
+void dumpSymbols(const DataSource& dataSource, const SymbolDumpSink& sink, const SymbolDumpOptions& options)
+{
+    BufferedDumpWriter writer{sink};
+    auto& out = writer.getBuffer();
+    TypeNameResolver typeNameResolver{};
+    SymbolDumpFormatter formatter{typeNameResolver, out, options.includeSymIndexIds};
+
+    formatter.formatSymbolLine(dataSource.getGlobalScope());
+    if (options.includeTypes)
+    {
+        appendSectionTitle(L"Types", out);
+        for (const auto symTag : {SymTagUDT, SymTagEnum, SymTagTypedef})
+        {
+            dumpGlobalSymbols(dataSource, symTag, formatter, writer);
+        }
+    }
+    if (options.includeGlobals)
+    {
+        appendSectionTitle(L"Globals", out);
+        dumpGlobalSymbols(dataSource, SymTagData, formatter, writer);
+    }
+    if (options.includePublics)
+    {
+        appendSectionTitle(L"Publics", out);
+        dumpGlobalSymbols(dataSource, SymTagPublicSymbol, formatter, writer);
+    }
+    if (options.includeCompilands)
+    {
+        appendSectionTitle(L"Compilands", out);
+        dumpCompilands(dataSource, options, formatter, writer);
+    }
+    writer.flush();
+}
+
+void dumpSymbolsToFile(const DataSource& dataSource, const std::wstring& outputFilePath, const SymbolDumpOptions& options)
+{
+    const HANDLE file = CreateFileW(outputFilePath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        throw WinApiException("Failed to create the dump file!");
+    }
+    ATL::CHandle fileHandle{file};
+
+    dumpSymbols(
+        dataSource,
+        [&fileHandle](const char* data, size_t size)
+        {
+            DWORD bytesWritten = 0;
+            if (!WriteFile(fileHandle, data, static_cast<DWORD>(size), &bytesWritten, nullptr) || size != bytesWritten)
+            {
+                throw WinApiException("Failed to write the dump file!");
+            }
+        },
+        options);
+}
+
+std::string dumpSymbolsToString(const DataSource& dataSource, const SymbolDumpOptions& options)
+{
+    std::string dump{};
+    dumpSymbols(
+        dataSource, [&dump](const char* data, size_t size) { dump.append(data, size); }, options);
+    return dump;
+}
+
+}  // namespace dia
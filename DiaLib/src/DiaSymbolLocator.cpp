@@ -0,0 +1,85 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaHashing.h"
+#include "DiaSymbolEnumerator.h"
+#include "DiaSymbolLocator.h"
+#include "Exceptions.h"
+#include <algorithm>
+
+namespace dia
+{
+SymbolPath SymbolLocator::getPath(const DataSource& dataSource, const Symbol& symbol)
+{
+    SymbolPath path{};
+    Symbol current = symbol;
+    while (SymTagExe != getSymTag(current))
+    {
+        const auto symTag     = getSymTag(current);
+        const auto symIndexId = getSymIndexId(current);
+        bool found            = false;
+        for (const auto& parent : {getOrDefault(getClassParent, current), getOrDefault(getLexicalParent, current), dataSource.getGlobalScope()})
+        {
+            if (!parent)
+            {
+                continue;
+            }
+            const auto& children = getChildren(parent, symTag);
+            const auto position  = children.positionBySymIndexId.find(symIndexId);
+            if (children.positionBySymIndexId.end() != position)
+            {
+                path.push_back(SymbolPathStep{symTag, position->second});
+                current = parent;
+                found   = true;
+                break;
+            }
+        }
+        if (!found)
+        {
+            throw InvalidUsageException("The symbol is not enumerated by its parents!");
+        }
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+Symbol SymbolLocator::getSymbol(const DataSource& dataSource, const SymbolPath& path)
+{
+    Symbol current = dataSource.getGlobalScope();
+    for (const auto& step : path)
+    {
+        const auto& children = getChildren(current, step.symTag);
+        if (children.symIndexIds.size() <= step.position)
+        {
+            throw InvalidUsageException("The symbol path leads out of the enumerated children!");
+        }
+        current = dataSource.getSymbolById(children.symIndexIds[step.position]);
+    }
+    return current;
+}
+
+const SymbolLocator::Children& SymbolLocator::getChildren(const Symbol& parent, enum SymTagEnum symTag)
+{
+    const auto key      = (static_cast<ULONGLONG>(getSymIndexId(parent)) << 32) | static_cast<ULONGLONG>(symTag);
+    const auto inserted = m_childrenByParent.emplace(key, Children{});
+    auto& children      = inserted.first->second;
+    if (inserted.second)
+    {
+        try
+        {
+            for (const auto& child : enumerate<Symbol>(parent, symTag))
+            {
+                children.positionBySymIndexId.emplace(getSymIndexId(child), children.symIndexIds.size());
+                children.symIndexIds.push_back(getSymIndexId(child));
+            }
+        }
+        catch (...)
+        {
+            m_childrenByParent.erase(inserted.first);
+            throw;
+        }
+    }
+    return children;
+}
+
+}  // namespace dia
@@ -0,0 +1,372 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaSymbolEnumerator.h"
+#include "DiaTypeDependencyGraph.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+namespace dia
+{
+namespace
+{
+class DependencyCollector
+{
+public:
+    DependencyCollector(std::vector<Symbol>& nodeSymbols, std::unordered_map<DWORD, uint32_t>& nodeBySymIndexId)
+        : m_nodeSymbols{nodeSymbols}
+        , m_nodeBySymIndexId{nodeBySymIndexId}
+    {
+    }
+
+    /// @brief Add a named type as a node, unless it already is one.
+    uint32_t addNode(const Symbol& type)
+    {
+        const auto inserted = m_nodeBySymIndexId.emplace(getSymIndexId(type), static_cast<uint32_t>(m_nodeSymbols.size()));
+        if (inserted.second)
+        {
+            m_nodeSymbols.push_back(type);
+        }
+        return inserted.first->second;
+    }
+
+    /// @brief Collect the dependencies of a single node, sorted by target and without duplicates.
+    const std::vector<TypeEdge>& collect(uint32_t node)
+    {
+        m_currentNode = node;
+        m_edges.clear();
+        m_inlinedTypes.clear();
+
+        const Symbol type = m_nodeSymbols[node];
+        switch (getSymTag(type))
+        {
+        case SymTagUDT:
+            collectMembers(type, TypeEdgeKind::ByValue);
+            break;
+        case SymTagTypedef:
+            collectTypeReference(getType(type), TypeEdgeKind::ByValue);
+            break;
+        default:
+            break;
+        }
+
+        // Keep a single edge per target, the by-value one when there are both (ByValue sorts first).
+        std::sort(m_edges.begin(), m_edges.end(),
+                  [](const TypeEdge& first, const TypeEdge& second)
+                  { return first.target < second.target || (first.target == second.target && first.kind < second.kind); });
+        m_edges.erase(std::unique(m_edges.begin(), m_edges.end(),
+                                  [](const TypeEdge& first, const TypeEdge& second) { return first.target == second.target; }),
+                      m_edges.end());
+        return m_edges;
+    }
+
+private:
+    /// @param kind How the UDT itself is needed. The members of a UDT which is only declared are only declaration dependencies as well.
+    void collectMembers(const Symbol& udt, TypeEdgeKind kind)
+    {
+        for (const auto& child : enumerate<Symbol>(udt, SymTagNull))
+        {
+            switch (getSymTag(child))
+            {
+            case SymTagBaseClass:
+                collectTypeReference(getType(child), kind);
+                break;
+            case SymTagData:
+                // Static members are only declared inside the type, so their own type does not need to be complete.
+                collectTypeReference(getType(child), DataIsStaticMember == getDataKind(child) ? TypeEdgeKind::ByPointer : kind);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void collectTypeReference(const Symbol& type, TypeEdgeKind kind)
+    {
+        switch (getSymTag(type))
+        {
+        case SymTagPointerType:
+            collectTypeReference(getType(type), TypeEdgeKind::ByPointer);
+            break;
+        case SymTagArrayType:
+            collectTypeReference(getType(type), kind);
+            break;
+        case SymTagFunctionType:
+            collectTypeReference(getType(type), TypeEdgeKind::ByPointer);
+            for (const auto& argument : enumerate<Symbol>(type, SymTagFunctionArgType))
+            {
+                collectTypeReference(getType(argument), TypeEdgeKind::ByPointer);
+            }
+            break;
+        case SymTagUDT:
+            if (isSymbolUnnamed(type))
+            {
+                // An unnamed type contained by value is defined inline, so whatever its members need is needed by value as well. Behind a
+                // pointer it is only declared, and so are its dependencies. The same type may be reached both ways, so it is visited once per kind.
+                const auto key = (static_cast<ULONGLONG>(getSymIndexId(type)) << 1) | static_cast<ULONGLONG>(kind);
+                if (m_inlinedTypes.insert(key).second)
+                {
+                    collectMembers(type, kind);
+                }
+                break;
+            }
+            addEdge(type, kind);
+            break;
+        case SymTagEnum:
+        case SymTagTypedef:
+            if (!isSymbolUnnamed(type))
+            {
+                addEdge(type, kind);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void addEdge(const Symbol& type, TypeEdgeKind kind)
+    {
+        const auto target = addNode(type);
+        if (target != m_currentNode)
+        {
+            m_edges.push_back(TypeEdge{target, kind});
+        }
+    }
+
+    std::vector<Symbol>& m_nodeSymbols;
+    std::unordered_map<DWORD, uint32_t>& m_nodeBySymIndexId;
+    uint32_t m_currentNode{0};
+    std::vector<TypeEdge> m_edges{};
+    std::unordered_set<ULONGLONG> m_inlinedTypes{};
+};
+}  // namespace
+
+TypeDependencyGraph::TypeDependencyGraph(const DataSource& dataSource)
+{
+    std::vector<Symbol> nodeSymbols{};
+    DependencyCollector collector{nodeSymbols, m_nodeBySymIndexId};
+    for (const auto symTag : {SymTagUDT, SymTagEnum, SymTagTypedef})
+    {
+        for (const auto& type : dataSource.getSymbols(symTag))
+        {
+            if (!isSymbolUnnamed(type))
+            {
+                collector.addNode(type);
+            }
+        }
+    }
+
+    // Dependencies may discover types which were not enumerated (e.g. nested types), which are appended to the nodes and visited in turn.
+    m_offsets.push_back(0);
+    for (uint32_t node = 0; node < nodeSymbols.size(); ++node)
+    {
+        const auto& dependencies = collector.collect(node);
+        m_edges.insert(m_edges.end(), dependencies.begin(), dependencies.end());
+        m_offsets.push_back(static_cast<uint32_t>(m_edges.size()));
+    }
+
+    m_symIndexIds.reserve(nodeSymbols.size());
+    for (const auto& type : nodeSymbols)
+    {
+        m_symIndexIds.push_back(type.getSymIndexId());
+    }
+}
+
+bool TypeDependencyGraph::contains(DWORD symIndexId) const { return m_nodeBySymIndexId.end() != m_nodeBySymIndexId.find(symIndexId); }
+
+size_t TypeDependencyGraph::getNode(DWORD symIndexId) const
+{
+    const auto node = m_nodeBySymIndexId.find(symIndexId);
+    if (m_nodeBySymIndexId.end() == node)
+    {
+        throw SymbolNotFoundException("The symbol is not a node of the type dependency graph!");
+    }
+    return node->second;
+}
+
+TypeDependencyGraph::EdgeRange TypeDependencyGraph::getDependencies(size_t node) const
+{
+    if (node >= getNodeCount())
+    {
+        throw std::out_of_range("Node index out of bounds!");
+    }
+    return EdgeRange{m_edges.data() + m_offsets[node], m_edges.data() + m_offsets[node + 1]};
+}
+
+std::vector<size_t> TypeDependencyGraph::getTopologicalOrder() const
+{
+    // Kahn's algorithm over the reversed by-value edges: a node is ready once all of its by-value dependencies were emitted.
+    const auto nodeCount = getNodeCount();
+    std::vector<uint32_t> pendingDependencies(nodeCount, 0);
+    std::vector<uint32_t> dependentOffsets(nodeCount + 1, 0);
+    for (const auto& edge : m_edges)
+    {
+        if (TypeEdgeKind::ByValue == edge.kind)
+        {
+            ++dependentOffsets[edge.target + 1];
+        }
+    }
+    std::partial_sum(dependentOffsets.begin(), dependentOffsets.end(), dependentOffsets.begin());
+
+    std::vector<uint32_t> dependents(dependentOffsets.back());
+    std::vector<uint32_t> nextDependent(dependentOffsets.begin(), dependentOffsets.end() - 1);
+    for (uint32_t node = 0; node < nodeCount; ++node)
+    {
+        for (const auto& edge : getDependencies(node))
+        {
+            if (TypeEdgeKind::ByValue == edge.kind)
+            {
+                dependents[nextDependent[edge.target]++] = node;
+                ++pendingDependencies[node];
+            }
+        }
+    }
+
+    std::vector<size_t> order{};
+    order.reserve(nodeCount);
+    for (size_t node = 0; node < nodeCount; ++node)
+    {
+        if (0 == pendingDependencies[node])
+        {
+            order.push_back(node);
+        }
+    }
+    // The order vector doubles as the queue of ready nodes.
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const auto node = order[i];
+        for (auto dependent = dependentOffsets[node]; dependent < dependentOffsets[node + 1]; ++dependent)
+        {
+            if (0 == --pendingDependencies[dependents[dependent]])
+            {
+                order.push_back(dependents[dependent]);
+            }
+        }
+    }
+
+    if (order.size() != nodeCount)
+    {
+        throw InvalidUsageException("The types contain each other by value!");
+    }
+    return order;
+}
+
+std::vector<std::vector<size_t>> TypeDependencyGraph::getStronglyConnectedComponents(bool includePointerEdges) const
+{
+    constexpr uint32_t UNVISITED = UINT32_MAX;
+
+    struct Frame
+    {
+        uint32_t node;
+        uint32_t nextEdge;
+    };
+
+    const auto nodeCount = getNodeCount();
+    std::vector<uint32_t> indices(nodeCount, UNVISITED);
+    std::vector<uint32_t> lowLinks(nodeCount, 0);
+    std::vector<bool> isOnStack(nodeCount, false);
+    std::vector<uint32_t> componentStack{};
+    std::vector<Frame> callStack{};
+    std::vector<std::vector<size_t>> components{};
+    uint32_t nextIndex = 0;
+
+    // Iterative Tarjan, since the dependency chains of a large PDB are deep enough to overflow the native stack.
+    for (uint32_t root = 0; root < nodeCount; ++root)
+    {
+        if (UNVISITED != indices[root])
+        {
+            continue;
+        }
+
+        callStack.push_back(Frame{root, m_offsets[root]});
+        indices[root] = lowLinks[root] = nextIndex++;
+        componentStack.push_back(root);
+        isOnStack[root] = true;
+
+        while (!callStack.empty())
+        {
+            auto& frame = callStack.back();
+            if (frame.nextEdge < m_offsets[frame.node + 1])
+            {
+                const auto& edge = m_edges[frame.nextEdge++];
+                if (!includePointerEdges && TypeEdgeKind::ByPointer == edge.kind)
+                {
+                    continue;
+                }
+                if (UNVISITED == indices[edge.target])
+                {
+                    indices[edge.target] = lowLinks[edge.target] = nextIndex++;
+                    componentStack.push_back(edge.target);
+                    isOnStack[edge.target] = true;
+                    callStack.push_back(Frame{edge.target, m_offsets[edge.target]});
+                }
+                else if (isOnStack[edge.target])
+                {
+                    lowLinks[frame.node] = (std::min)(lowLinks[frame.node], indices[edge.target]);
+                }
+                continue;
+            }
+
+            const auto node = frame.node;
+            callStack.pop_back();
+            if (!callStack.empty())
+            {
+                lowLinks[callStack.back().node] = (std::min)(lowLinks[callStack.back().node], lowLinks[node]);
+            }
+            if (lowLinks[node] != indices[node])
+            {
+                continue;
+            }
+
+            std::vector<size_t> component{};
+            uint32_t member = 0;
+            do
+            {
+                member = componentStack.back();
+                componentStack.pop_back();
+                isOnStack[member] = false;
+                component.push_back(member);
+            } while (member != node);
+
+            // Self edges are never recorded, so only components of several nodes are cycles.
+            if (1 < component.size())
+            {
+                std::sort(component.begin(), component.end());
+                components.push_back(std::move(component));
+            }
+        }
+    }
+    return components;
+}
+
+std::vector<std::pair<size_t, size_t>> TypeDependencyGraph::suggestCycleBreaks() const
+{
+    const auto order = getTopologicalOrder();
+    std::vector<size_t> positions(getNodeCount());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        positions[order[i]] = i;
+    }
+
+    // By-value edges always point to an earlier position, so every edge pointing forward is a by-pointer one. Within a component those are
+    // exactly the edges closing its cycles.
+    std::vector<std::pair<size_t, size_t>> cycleBreaks{};
+    for (const auto& component : getStronglyConnectedComponents())
+    {
+        for (const auto node : component)
+        {
+            for (const auto& edge : getDependencies(node))
+            {
+                if (positions[edge.target] > positions[node] && std::binary_search(component.begin(), component.end(), edge.target))
+                {
+                    cycleBreaks.emplace_back(node, edge.target);
+                }
+            }
+        }
+    }
+    return cycleBreaks;
+}
+
+}  // namespace dia
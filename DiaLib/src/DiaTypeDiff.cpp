@@ -0,0 +1,367 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaHashing.h"
+#include "DiaSymbolEnumerator.h"
+#include "DiaTypeDiff.h"
+#include "DiaTypeResolution.h"
+#include "HashUtils.h"
+#include <map>
+#include <utility>
+
+namespace dia
+{
+namespace
+{
+struct TypeEntry
+{
+    Symbol symbol;
+    ULONGLONG length;
+};
+
+struct MemberEntry
+{
+    enum SymTagEnum symTag;
+    std::wstring name;
+    LONG offset;
+    ULONGLONG size;
+    DWORD bitPosition;
+    std::wstring typeName;
+    /// @brief The structural hash of the type of the member, which changes along with its content even when its name does not.
+    size_t typeHash;
+    size_t attributesHash;
+};
+
+/// @brief Members are matched by tag and name. Member functions are matched by signature too, which tells overloads apart.
+using MemberKey = std::pair<enum SymTagEnum, std::wstring>;
+
+MemberKey getMemberKey(const MemberEntry& member)
+{
+    return {member.symTag, (SymTagFunction == member.symTag) ? (member.name + member.typeName) : member.name};
+}
+
+/// @brief Types are matched by tag and name. Ordered, so the differences are reported in the same order whatever the hashing of the names.
+using TypeKey = std::pair<enum SymTagEnum, std::wstring>;
+
+/// @brief Index the named UDTs and enums of a data source by tag and name.
+std::map<TypeKey, TypeEntry> collectTypes(const DataSource& dataSource)
+{
+    std::map<TypeKey, TypeEntry> types{};
+    for (const auto symTag : {SymTagUDT, SymTagEnum})
+    {
+        for (const auto& type : dataSource.getSymbols(symTag))
+        {
+            if (isSymbolUnnamed(type))
+            {
+                continue;
+            }
+
+            // The same type is usually emitted once per compiland. Keep the first definition, but prefer it over a forward declaration.
+            const auto length = getOrDefault(getLength, type);
+            auto& entry       = types[TypeKey{symTag, std::wstring(getName(type))}];
+            if (!entry.symbol || (0 == entry.length && 0 != length))
+            {
+                entry = TypeEntry{type, length};
+            }
+        }
+    }
+    return types;
+}
+
+/// @brief Hash the properties of a UDT or enum itself which the structural hash covers, besides its name, size and members.
+size_t hashTypeAttributes(const Symbol& type)
+{
+    size_t calculatedHash = 0;
+    hash_combine(calculatedHash, getOrDefault(getUdtKind, type), getOrDefault(getBaseType, type), getOrDefault(getPacked, type),
+                 getOrDefault(getScoped, type), getOrDefault(getConstType, type), getOrDefault(getVolatileType, type),
+                 getOrDefault(getUnalignedType, type));
+    return calculatedHash;
+}
+
+/// @brief Collect everything the structural hash of a type covers, so a changed hash is always explained by at least one member.
+std::vector<MemberEntry> collectMembers(const DataSource& dataSource, const Symbol& type)
+{
+    const bool isEnum = SymTagEnum == getSymTag(type);
+    std::vector<MemberEntry> members{};
+    for (const auto& member : enumerate<Symbol>(type, SymTagNull))
+    {
+        const auto symTag = getSymTag(member);
+        MemberEntry entry{symTag, std::wstring(getOrDefault(getName, member)), 0, 0, 0, {}, 0, 0};
+        switch (symTag)
+        {
+        case SymTagData:
+            if (isEnum)
+            {
+                entry.attributesHash = std::hash<VARIANT>{}(getValue(member));
+            }
+            else
+            {
+                const auto memberType = getType(member);
+                entry.offset          = getOrDefault(getOffset, member);
+                entry.typeName        = dataSource.resolveTypeName(memberType);
+                entry.typeHash        = dataSource.getStructuralHash(memberType);
+                if (LocIsBitField == getLocationType(member))
+                {
+                    entry.size        = getLength(member);
+                    entry.bitPosition = getBitPosition(member);
+                }
+                else
+                {
+                    entry.size = getOrDefault(getLength, memberType);
+                }
+                hash_combine(entry.attributesHash, getDataKind(member), getOrDefault(getAccess, member), getOrDefault(getIsStatic, member));
+            }
+            break;
+        case SymTagBaseClass:
+        {
+            const auto baseType = getType(member);
+            entry.offset        = getOrDefault(getOffset, member);
+            entry.size          = getOrDefault(getLength, baseType);
+            entry.typeName      = dataSource.resolveTypeName(baseType);
+            entry.typeHash      = dataSource.getStructuralHash(baseType);
+            hash_combine(entry.attributesHash, getOrDefault(getVirtualBaseClass, member), getOrDefault(getIndirectVirtualBaseClass, member),
+                         getOrDefault(getAccess, member));
+            break;
+        }
+        case SymTagFunction:
+            entry.typeName = dataSource.resolveTypeName(getType(member));
+            entry.typeHash = dataSource.getStructuralHash(getType(member));
+            hash_combine(entry.attributesHash, getOrDefault(getVirtual, member), getOrDefault(getPure, member), getOrDefault(getIntro, member),
+                         getOrDefault(getIsStatic, member), getOrDefault(getAccess, member));
+            break;
+        case SymTagUDT:
+        case SymTagEnum:
+            // Nested types
+            entry.size           = getOrDefault(getLength, member);
+            entry.attributesHash = dataSource.getStructuralHash(member);
+            break;
+        case SymTagTypedef:
+            entry.typeName = dataSource.resolveTypeName(getType(member));
+            entry.typeHash = dataSource.getStructuralHash(getType(member));
+            break;
+        default:
+            continue;
+        }
+        members.push_back(std::move(entry));
+    }
+    return members;
+}
+
+std::vector<MemberDiff> diffMembers(const DataSource& oldDataSource, const Symbol& oldType, const DataSource& newDataSource, const Symbol& newType)
+{
+    const auto oldMembers = collectMembers(oldDataSource, oldType);
+    const auto newMembers = collectMembers(newDataSource, newType);
+
+    std::map<MemberKey, const MemberEntry*> oldMembersByKey{};
+    for (const auto& oldMember : oldMembers)
+    {
+        oldMembersByKey.emplace(getMemberKey(oldMember), &oldMember);
+    }
+
+    std::vector<MemberDiff> memberDiffs{};
+    for (const auto& newMember : newMembers)
+    {
+        MemberDiff memberDiff{};
+        memberDiff.symTag         = newMember.symTag;
+        memberDiff.name           = newMember.name;
+        memberDiff.newOffset      = newMember.offset;
+        memberDiff.newSize        = newMember.size;
+        memberDiff.newBitPosition = newMember.bitPosition;
+        memberDiff.newTypeName    = newMember.typeName;
+
+        const auto oldMember = oldMembersByKey.find(getMemberKey(newMember));
+        if (oldMembersByKey.end() == oldMember)
+        {
+            memberDiff.kind = DiffKind::Added;
+            memberDiffs.push_back(std::move(memberDiff));
+            continue;
+        }
+
+        const auto& matchedMember = *oldMember->second;
+        oldMembersByKey.erase(oldMember);
+        memberDiff.kind               = DiffKind::Changed;
+        memberDiff.oldOffset          = matchedMember.offset;
+        memberDiff.oldSize            = matchedMember.size;
+        memberDiff.oldBitPosition     = matchedMember.bitPosition;
+        memberDiff.oldTypeName        = matchedMember.typeName;
+        memberDiff.attributesChanged  = matchedMember.attributesHash != newMember.attributesHash;
+        memberDiff.typeContentChanged = !memberDiff.typeChanged() && matchedMember.typeHash != newMember.typeHash;
+        if (memberDiff.offsetChanged() || memberDiff.sizeChanged() || memberDiff.typeChanged() || memberDiff.typeContentChanged ||
+            memberDiff.attributesChanged)
+        {
+            memberDiffs.push_back(std::move(memberDiff));
+        }
+    }
+
+    // Whatever was not matched by a member of the new type was removed. Walk the old members to report them in declaration order.
+    for (const auto& oldMember : oldMembers)
+    {
+        const auto unmatchedMember = oldMembersByKey.find(getMemberKey(oldMember));
+        if (oldMembersByKey.end() == unmatchedMember || &oldMember != unmatchedMember->second)
+        {
+            continue;
+        }
+        MemberDiff memberDiff{};
+        memberDiff.kind           = DiffKind::Removed;
+        memberDiff.symTag         = oldMember.symTag;
+        memberDiff.name           = oldMember.name;
+        memberDiff.oldOffset      = oldMember.offset;
+        memberDiff.oldSize        = oldMember.size;
+        memberDiff.oldBitPosition = oldMember.bitPosition;
+        memberDiff.oldTypeName    = oldMember.typeName;
+        memberDiffs.push_back(std::move(memberDiff));
+    }
+    return memberDiffs;
+}
+}  // namespace
+
+void diffTypes(const DataSource& oldDataSource, const DataSource& newDataSource, const std::function<void(const TypeDiff&)>& onDiff)
+{
+    const auto oldTypes = collectTypes(oldDataSource);
+    const auto newTypes = collectTypes(newDataSource);
+
+    for (const auto& oldType : oldTypes)
+    {
+        if (newTypes.end() == newTypes.find(oldType.first))
+        {
+            TypeDiff typeDiff{};
+            typeDiff.kind    = DiffKind::Removed;
+            typeDiff.symTag  = oldType.first.first;
+            typeDiff.name    = oldType.first.second;
+            typeDiff.oldSize = oldType.second.length;
+            onDiff(typeDiff);
+        }
+    }
+
+    for (const auto& oldType : oldTypes)
+    {
+        const auto newType = newTypes.find(oldType.first);
+        if (newTypes.end() == newType)
+        {
+            continue;
+        }
+
+        const auto& oldSymbol = oldType.second.symbol;
+        const auto& newSymbol = newType->second.symbol;
+        if (oldDataSource.getStructuralHash(oldSymbol) == newDataSource.getStructuralHash(newSymbol))
+        {
+            continue;
+        }
+
+        TypeDiff typeDiff{};
+        typeDiff.kind              = DiffKind::Changed;
+        typeDiff.symTag            = oldType.first.first;
+        typeDiff.name              = oldType.first.second;
+        typeDiff.oldSize           = oldType.second.length;
+        typeDiff.newSize           = newType->second.length;
+        typeDiff.attributesChanged = hashTypeAttributes(oldSymbol) != hashTypeAttributes(newSymbol);
+        typeDiff.members           = diffMembers(oldDataSource, oldSymbol, newDataSource, newSymbol);
+        if (!typeDiff.sizeChanged() && !typeDiff.attributesChanged && typeDiff.members.empty())
+        {
+            // The members, size and attributes cover what the structural hash does, so this is only a safety net: a change is never reported
+            // without saying what changed.
+            continue;
+        }
+        onDiff(typeDiff);
+    }
+
+    // Everything which was not matched by an old type was added.
+    for (const auto& newType : newTypes)
+    {
+        if (oldTypes.end() == oldTypes.find(newType.first))
+        {
+            TypeDiff typeDiff{};
+            typeDiff.kind    = DiffKind::Added;
+            typeDiff.symTag  = newType.first.first;
+            typeDiff.name    = newType.first.second;
+            typeDiff.newSize = newType.second.length;
+            onDiff(typeDiff);
+        }
+    }
+}
+
+std::vector<TypeDiff> diffTypes(const DataSource& oldDataSource, const DataSource& newDataSource)
+{
+    std::vector<TypeDiff> typeDiffs{};
+    diffTypes(oldDataSource, newDataSource, [&typeDiffs](const TypeDiff& typeDiff) { typeDiffs.push_back(typeDiff); });
+    return typeDiffs;
+}
+
+std::wstring diffKindToName(DiffKind kind)
+{
+    switch (kind)
+    {
+    case DiffKind::Added:
+        return L"Added";
+    case DiffKind::Removed:
+        return L"Removed";
+    case DiffKind::Changed:
+        return L"Changed";
+    default:
+        throw std::invalid_argument("Invalid DiffKind!");
+    }
+}
+
+}  // namespace dia
+
+std::wostream& operator<<(std::wostream& os, const dia::MemberDiff& memberDiff)
+{
+    os << dia::diffKindToName(memberDiff.kind) << L" ";
+    if (SymTagData != memberDiff.symTag)
+    {
+        os << dia::symTagToName(memberDiff.symTag) << L" ";
+    }
+    os << memberDiff.name;
+    switch (memberDiff.kind)
+    {
+    case dia::DiffKind::Added:
+        os << L": " << memberDiff.newTypeName << L" @ " << memberDiff.newOffset;
+        break;
+    case dia::DiffKind::Removed:
+        os << L": " << memberDiff.oldTypeName << L" @ " << memberDiff.oldOffset;
+        break;
+    case dia::DiffKind::Changed:
+        if (memberDiff.offsetChanged())
+        {
+            os << L", offset " << memberDiff.oldOffset << L":" << memberDiff.oldBitPosition << L" -> " << memberDiff.newOffset << L":"
+               << memberDiff.newBitPosition;
+        }
+        if (memberDiff.sizeChanged())
+        {
+            os << L", size " << memberDiff.oldSize << L" -> " << memberDiff.newSize;
+        }
+        if (memberDiff.typeChanged())
+        {
+            os << L", type " << memberDiff.oldTypeName << L" -> " << memberDiff.newTypeName;
+        }
+        if (memberDiff.typeContentChanged)
+        {
+            os << L", content of " << memberDiff.newTypeName;
+        }
+        if (memberDiff.attributesChanged)
+        {
+            os << L", attributes";
+        }
+        break;
+    }
+    return os;
+}
+
+std::wostream& operator<<(std::wostream& os, const dia::TypeDiff& typeDiff)
+{
+    os << dia::diffKindToName(typeDiff.kind) << L" " << dia::symTagToName(typeDiff.symTag) << L" " << typeDiff.name;
+    if (dia::DiffKind::Changed == typeDiff.kind && typeDiff.sizeChanged())
+    {
+        os << L", size " << typeDiff.oldSize << L" -> " << typeDiff.newSize;
+    }
+    if (typeDiff.attributesChanged)
+    {
+        os << L", attributes";
+    }
+    os << std::endl;
+    for (const auto& memberDiff : typeDiff.members)
+    {
+        os << L"    " << memberDiff << std::endl;
+    }
+    return os;
+}
@@ -0,0 +1,229 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaHashing.h"
+#include "DiaStructuralHash.h"
+#include "DiaTypeEquivalence.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <numeric>
+
+namespace dia
+{
+namespace
+{
+struct TypeNode
+{
+    DWORD symIndexId;
+    enum SymTagEnum symTag;
+    size_t structuralHash;
+    bool isDefinition;
+};
+
+struct StructuralKey
+{
+    enum SymTagEnum symTag;
+    size_t structuralHash;
+    size_t confirmingHash;
+
+    bool operator==(const StructuralKey& other) const
+    {
+        return symTag == other.symTag && structuralHash == other.structuralHash && confirmingHash == other.confirmingHash;
+    }
+};
+
+struct StructuralKeyHash
+{
+    size_t operator()(const StructuralKey& key) const
+    {
+        size_t calculatedHash = 0;
+        hash_combine(calculatedHash, key.symTag, key.structuralHash, key.confirmingHash);
+        return calculatedHash;
+    }
+};
+
+/// @brief Union-find over node indices, with path halving and union by size.
+class DisjointSets
+{
+public:
+    explicit DisjointSets(size_t count)
+        : m_parents(count)
+        , m_sizes(count, 1)
+    {
+        std::iota(m_parents.begin(), m_parents.end(), size_t{0});
+    }
+
+    size_t find(size_t node)
+    {
+        while (m_parents[node] != node)
+        {
+            m_parents[node] = m_parents[m_parents[node]];
+            node            = m_parents[node];
+        }
+        return node;
+    }
+
+    void unite(size_t first, size_t second)
+    {
+        first  = find(first);
+        second = find(second);
+        if (first == second)
+        {
+            return;
+        }
+        if (m_sizes[first] < m_sizes[second])
+        {
+            std::swap(first, second);
+        }
+        m_parents[second] = first;
+        m_sizes[first] += m_sizes[second];
+    }
+
+private:
+    std::vector<size_t> m_parents;
+    std::vector<size_t> m_sizes;
+};
+
+/// @brief Whether a node should be preferred over another as the canonical representative of their class.
+bool isBetterRepresentative(const TypeNode& candidate, const TypeNode& current)
+{
+    if (candidate.isDefinition != current.isDefinition)
+    {
+        return candidate.isDefinition;
+    }
+    return candidate.symIndexId < current.symIndexId;
+}
+}  // namespace
+
+TypeEquivalenceClasses::TypeEquivalenceClasses(const DataSource& dataSource)
+{
+    std::vector<TypeNode> nodes{};
+    std::vector<std::wstring> forwardDeclarationNames{};
+    std::vector<size_t> forwardDeclarationNodes{};
+    std::unordered_map<std::wstring, std::vector<size_t>> definitionNodesByName{};
+
+    for (const auto symTag : {SymTagUDT, SymTagEnum, SymTagTypedef})
+    {
+        for (const auto& type : dataSource.getSymbols(symTag))
+        {
+            // A UDT without a length is only forward declared, everything else carries its whole definition.
+            const bool isDefinition = SymTagUDT != symTag || 0 != getOrDefault(getLength, type);
+            nodes.push_back(TypeNode{getSymIndexId(type), symTag, dataSource.getStructuralHash(type), isDefinition});
+
+            if (SymTagUDT != symTag || isSymbolUnnamed(type))
+            {
+                continue;
+            }
+            if (isDefinition)
+            {
+                definitionNodesByName[std::wstring(getName(type))].push_back(nodes.size() - 1);
+            }
+            else
+            {
+                forwardDeclarationNames.emplace_back(getName(type));
+                forwardDeclarationNodes.push_back(nodes.size() - 1);
+            }
+        }
+    }
+
+    DisjointSets sets{nodes.size()};
+
+    // Structurally identical types are the same type. A match of the 64-bit hashes alone could be a collision, so the types which share
+    // theirs are only merged when a second, independently seeded hash matches as well.
+    std::unordered_map<StructuralKey, size_t, StructuralKeyHash> nodeCountByKey{};
+    nodeCountByKey.reserve(nodes.size());
+    for (const auto& node : nodes)
+    {
+        ++nodeCountByKey[StructuralKey{node.symTag, node.structuralHash, 0}];
+    }
+
+    StructuralHasher confirmingHasher{CONFIRMING_STRUCTURAL_HASH_SEED};
+    std::unordered_map<StructuralKey, size_t, StructuralKeyHash> firstNodeByKey{};
+    firstNodeByKey.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        StructuralKey key{nodes[i].symTag, nodes[i].structuralHash, 0};
+        if (1 == nodeCountByKey[key])
+        {
+            continue;
+        }
+        key.confirmingHash   = confirmingHasher.hash(dataSource.getSymbolById(nodes[i].symIndexId));
+        const auto firstNode = firstNodeByKey.emplace(key, i).first->second;
+        sets.unite(firstNode, i);
+    }
+
+    // A forward declaration has no layout of its own, so it joins the definition with the same name. When several distinct definitions share
+    // that name (e.g. types local to different compilands) there is no telling which one it declares, and it stays in a class of its own.
+    for (size_t i = 0; i < forwardDeclarationNodes.size(); ++i)
+    {
+        const auto definitionNodes = definitionNodesByName.find(forwardDeclarationNames[i]);
+        if (definitionNodesByName.end() == definitionNodes)
+        {
+            continue;
+        }
+        const auto definitionRoot = sets.find(definitionNodes->second.front());
+        const bool isAmbiguous    = std::any_of(definitionNodes->second.begin(), definitionNodes->second.end(),
+                                                [&sets, definitionRoot](size_t node) { return sets.find(node) != definitionRoot; });
+        if (!isAmbiguous)
+        {
+            sets.unite(definitionRoot, forwardDeclarationNodes[i]);
+        }
+    }
+
+    std::unordered_map<size_t, size_t> classIndexByRoot{};
+    std::vector<size_t> canonicalNodes{};
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        const auto inserted = classIndexByRoot.emplace(sets.find(i), m_classes.size());
+        if (inserted.second)
+        {
+            m_classes.emplace_back();
+            canonicalNodes.push_back(i);
+        }
+
+        const auto classIndex = inserted.first->second;
+        m_classes[classIndex].symIndexIds.push_back(nodes[i].symIndexId);
+        if (isBetterRepresentative(nodes[i], nodes[canonicalNodes[classIndex]]))
+        {
+            canonicalNodes[classIndex] = i;
+        }
+    }
+
+    for (size_t classIndex = 0; classIndex < m_classes.size(); ++classIndex)
+    {
+        auto& equivalenceClass               = m_classes[classIndex];
+        const auto& canonicalNode            = nodes[canonicalNodes[classIndex]];
+        equivalenceClass.canonicalSymIndexId = canonicalNode.symIndexId;
+        equivalenceClass.structuralHash      = canonicalNode.structuralHash;
+        std::sort(equivalenceClass.symIndexIds.begin(), equivalenceClass.symIndexIds.end());
+    }
+    std::sort(m_classes.begin(), m_classes.end(), [](const TypeEquivalenceClass& first, const TypeEquivalenceClass& second)
+              { return first.canonicalSymIndexId < second.canonicalSymIndexId; });
+
+    m_classIndexBySymIndexId.reserve(nodes.size());
+    for (size_t classIndex = 0; classIndex < m_classes.size(); ++classIndex)
+    {
+        for (const auto symIndexId : m_classes[classIndex].symIndexIds)
+        {
+            m_classIndexBySymIndexId.emplace(symIndexId, classIndex);
+        }
+    }
+}
+
+bool TypeEquivalenceClasses::contains(DWORD symIndexId) const { return m_classIndexBySymIndexId.end() != m_classIndexBySymIndexId.find(symIndexId); }
+
+bool TypeEquivalenceClasses::contains(const Symbol& type) const { return contains(getSymIndexId(type)); }
+
+const TypeEquivalenceClass& TypeEquivalenceClasses::getClassOf(DWORD symIndexId) const
+{
+    const auto classIndex = m_classIndexBySymIndexId.find(symIndexId);
+    if (m_classIndexBySymIndexId.end() == classIndex)
+    {
+        throw SymbolNotFoundException("The symbol is not a type of this data source!");
+    }
+    return m_classes[classIndex->second];
+}
+
+const TypeEquivalenceClass& TypeEquivalenceClasses::getClassOf(const Symbol& type) const { return getClassOf(getSymIndexId(type)); }
+
+}  // namespace dia
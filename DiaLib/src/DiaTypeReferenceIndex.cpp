@@ -0,0 +1,177 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaSymbolEnumerator.h"
+#include "DiaTypeEquivalence.h"
+#include "DiaTypeReferenceIndex.h"
+#include <algorithm>
+
+namespace dia
+{
+namespace
+{
+struct IndexedReference
+{
+    DWORD targetSymIndexId;
+    TypeReference reference;
+};
+
+class ReferenceCollector
+{
+public:
+    explicit ReferenceCollector(std::vector<IndexedReference>& references)
+        : m_references{references}
+    {
+    }
+
+    void collectUdt(const Symbol& udt)
+    {
+        const auto referrer = getSymIndexId(udt);
+        for (const auto& child : enumerate<Symbol>(udt, SymTagNull))
+        {
+            switch (getSymTag(child))
+            {
+            case SymTagBaseClass:
+            case SymTagData:
+                collectTypeReference(referrer, getType(child), TypeReferenceKind::ByValue);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void collectTypedef(const Symbol& typeDef) { collectTypeReference(getSymIndexId(typeDef), getType(typeDef), TypeReferenceKind::ByValue); }
+
+    void collectFunction(const Symbol& function)
+    {
+        const auto functionType = getType(function);
+        if (SymTagFunctionType != getSymTag(functionType))
+        {
+            return;
+        }
+        const auto referrer = getSymIndexId(function);
+        collectTypeReference(referrer, getType(functionType), TypeReferenceKind::Return);
+        for (const auto& argument : enumerate<Symbol>(functionType, SymTagFunctionArgType))
+        {
+            collectTypeReference(referrer, getType(argument), TypeReferenceKind::Argument);
+        }
+    }
+
+    void collectGlobal(const Symbol& global) { collectTypeReference(getSymIndexId(global), getType(global), TypeReferenceKind::ByValue); }
+
+private:
+    void collectTypeReference(DWORD referrer, const Symbol& type, TypeReferenceKind kind)
+    {
+        switch (getSymTag(type))
+        {
+        case SymTagPointerType:
+            // A pointer hides whatever lies behind it, so it wins over arrays, arguments and return types.
+            collectTypeReference(referrer, getType(type), TypeReferenceKind::ByPointer);
+            break;
+        case SymTagArrayType:
+            collectTypeReference(referrer, getType(type), TypeReferenceKind::ByValue == kind ? TypeReferenceKind::ArrayElement : kind);
+            break;
+        case SymTagFunctionType:
+            // Only reachable through a pointer, the signature of a function pointer is referred to by pointer as a whole.
+            collectTypeReference(referrer, getType(type), TypeReferenceKind::ByPointer);
+            for (const auto& argument : enumerate<Symbol>(type, SymTagFunctionArgType))
+            {
+                collectTypeReference(referrer, getType(argument), TypeReferenceKind::ByPointer);
+            }
+            break;
+        case SymTagUDT:
+        case SymTagEnum:
+        case SymTagTypedef:
+        case SymTagBaseType:
+            m_references.push_back(IndexedReference{getSymIndexId(type), TypeReference{referrer, kind}});
+            break;
+        default:
+            break;
+        }
+    }
+
+    std::vector<IndexedReference>& m_references;
+};
+
+bool isReferenceLess(const TypeReference& first, const TypeReference& second)
+{
+    return first.referrerSymIndexId < second.referrerSymIndexId ||
+           (first.referrerSymIndexId == second.referrerSymIndexId && first.kind < second.kind);
+}
+
+bool isSameReference(const TypeReference& first, const TypeReference& second)
+{
+    return first.referrerSymIndexId == second.referrerSymIndexId && first.kind == second.kind;
+}
+}  // namespace
+
+TypeReferenceIndex::TypeReferenceIndex(const DataSource& dataSource)
+{
+    std::vector<IndexedReference> references{};
+    ReferenceCollector collector{references};
+    for (const auto& udt : dataSource.getSymbols(SymTagUDT))
+    {
+        collector.collectUdt(udt);
+    }
+    for (const auto& typeDef : dataSource.getSymbols(SymTagTypedef))
+    {
+        collector.collectTypedef(typeDef);
+    }
+    for (const auto& function : dataSource.getSymbols(SymTagFunction))
+    {
+        collector.collectFunction(function);
+    }
+    for (const auto& global : dataSource.getSymbols(SymTagData))
+    {
+        collector.collectGlobal(global);
+    }
+
+    // Group the references by target, then lay them out contiguously so that each lookup is a single range.
+    std::sort(references.begin(), references.end(),
+              [](const IndexedReference& first, const IndexedReference& second)
+              {
+                  return first.targetSymIndexId < second.targetSymIndexId ||
+                         (first.targetSymIndexId == second.targetSymIndexId && isReferenceLess(first.reference, second.reference));
+              });
+    references.erase(std::unique(references.begin(), references.end(),
+                                 [](const IndexedReference& first, const IndexedReference& second)
+                                 { return first.targetSymIndexId == second.targetSymIndexId && isSameReference(first.reference, second.reference); }),
+                     references.end());
+
+    m_references.reserve(references.size());
+    for (const auto& indexedReference : references)
+    {
+        const auto position = static_cast<uint32_t>(m_references.size());
+        auto& range         = m_rangeBySymIndexId.emplace(indexedReference.targetSymIndexId, std::make_pair(position, position)).first->second;
+        ++range.second;
+        m_references.push_back(indexedReference.reference);
+    }
+}
+
+TypeReferenceIndex::ReferenceRange TypeReferenceIndex::getReferencesTo(DWORD symIndexId) const
+{
+    const auto range = m_rangeBySymIndexId.find(symIndexId);
+    if (m_rangeBySymIndexId.end() == range)
+    {
+        return ReferenceRange{nullptr, nullptr};
+    }
+    return ReferenceRange{m_references.data() + range->second.first, m_references.data() + range->second.second};
+}
+
+TypeReferenceIndex::ReferenceRange TypeReferenceIndex::getReferencesTo(const Symbol& type) const { return getReferencesTo(getSymIndexId(type)); }
+
+std::vector<TypeReference> TypeReferenceIndex::getReferencesTo(const TypeEquivalenceClass& equivalenceClass) const
+{
+    std::vector<TypeReference> references{};
+    for (const auto symIndexId : equivalenceClass.symIndexIds)
+    {
+        const auto range = getReferencesTo(symIndexId);
+        references.insert(references.end(), range.begin(), range.end());
+    }
+    std::sort(references.begin(), references.end(), isReferenceLess);
+    references.erase(std::unique(references.begin(), references.end(), isSameReference), references.end());
+    return references;
+}
+
+}  // namespace dia
@@ -173,7 +173,7 @@ static const wchar_t* SYM_TAG_TYPE_NAMES[] = {
 };
 constexpr auto SYM_TAG_TYPE_NAMES_COUNT = sizeof(SYM_TAG_TYPE_NAMES) / sizeof(SYM_TAG_TYPE_NAMES[0]);
 
-std::wstring symTagToName(const enum SymTagEnum v)
+const wchar_t* symTagToStaticName(const enum SymTagEnum v)
 {
     const size_t vIndex = static_cast<size_t>(v);
     if (vIndex >= SYM_TAG_TYPE_NAMES_COUNT)
@@ -183,13 +183,15 @@ std::wstring symTagToName(const enum SymTagEnum v)
     return SYM_TAG_TYPE_NAMES[vIndex];
 }
 
+std::wstring symTagToName(const enum SymTagEnum v) { return symTagToStaticName(v); }
+
 constexpr const wchar_t* LOCATION_TYPE_NAMES[] = {
     L"LocIsNull", L"LocIsStatic", L"LocIsTLS",      L"LocIsRegRel",   L"LocIsThisRel",          L"LocIsEnregistered", L"LocIsBitField",
     L"LocIsSlot", L"LocIsIlRel",  L"LocInMetaData", L"LocIsConstant", L"LocIsRegRelAliasIndir", L"LocTypeMax",
 };
 constexpr const auto LOCATION_TYPE_NAMES_COUNT = sizeof(LOCATION_TYPE_NAMES) / sizeof(LOCATION_TYPE_NAMES[0]);
 
-std::wstring locationTypeToName(const enum LocationType v)
+const wchar_t* locationTypeToStaticName(const enum LocationType v)
 {
     const size_t vIndex = static_cast<size_t>(v);
     if (vIndex >= LOCATION_TYPE_NAMES_COUNT)
@@ -199,6 +201,25 @@ std::wstring locationTypeToName(const enum LocationType v)
     return LOCATION_TYPE_NAMES[vIndex];
 }
 
+std::wstring locationTypeToName(const enum LocationType v) { return locationTypeToStaticName(v); }
+
+const wchar_t* udtKindToStaticName(const enum UdtKind v)
+{
+    switch (v)
+    {
+    case UdtClass:
+        return L"class";
+    case UdtUnion:
+        return L"union";
+    case UdtInterface:
+        return L"interface";
+    case UdtTaggedUnion:
+        return L"tagged-union";
+    default:
+        return L"struct";
+    }
+}
+
 std::wstring callingConventionToName(const CvCall v)
 {
     switch (v)
@@ -338,46 +359,90 @@ std::string convertGuidToString(const GUID& guid)
     return std::string{rawGuidString, 34};
 }
 
-static std::wstring resolveFunctionTypeName(const FunctionType& funcTypeSymbol, bool withCallingConvention)
+std::wstring resolveTypeName(const Symbol& symbol)
+{
+    TypeNameResolver resolver{};
+    return resolver.resolve(symbol);
+}
+
+const std::wstring& TypeNameResolver::resolve(const Symbol& symbol)
+{
+    const auto cachedName = m_nameBySymIndexId.find(getSymIndexId(symbol));
+    if (m_nameBySymIndexId.end() != cachedName)
+    {
+        return *cachedName->second;
+    }
+
+    std::wstring name{};
+    appendTypeName(symbol, name);
+    return *m_nameBySymIndexId.at(getSymIndexId(symbol));
+}
+
+void TypeNameResolver::clear()
+{
+    m_nameBySymIndexId.clear();
+    m_internedNames.clear();
+}
+
+const std::wstring& TypeNameResolver::intern(std::wstring&& name) { return *m_internedNames.insert(std::move(name)).first; }
+
+void TypeNameResolver::appendTypeName(const Symbol& symbol, std::wstring& name)
+{
+    const DWORD symIndexId = getSymIndexId(symbol);
+    const auto cachedName  = m_nameBySymIndexId.find(symIndexId);
+    if (m_nameBySymIndexId.end() != cachedName)
+    {
+        name += *cachedName->second;
+        return;
+    }
+
+    const auto nameStart = name.size();
+    appendUncachedTypeName(symbol, name);
+    m_nameBySymIndexId.emplace(symIndexId, &intern(name.substr(nameStart)));
+}
+
+void TypeNameResolver::appendFunctionTypeName(const FunctionType& funcTypeSymbol, bool withCallingConvention, std::wstring& name)
 {
     const auto functionReturnType = funcTypeSymbol.getType();
     const auto callingConvention  = resolveCppCallingConventionAttribute(funcTypeSymbol.getCallingConvention());
 
-    auto functionSignature        = resolveTypeName(functionReturnType) + std::wstring(L"(");
+    name += L"std::function<";
+    appendTypeName(functionReturnType, name);
+    name += L'(';
     if (withCallingConvention)
     {
-        functionSignature += callingConvention + std::wstring(L"*)(");
+        name += callingConvention;
+        name += L"*)(";
     }
 
-    const auto functionArgCount = funcTypeSymbol.getCount();
-    DWORD functionArgIndex      = 0;
+    bool isFirstArg = true;
     for (const auto& functionArg : funcTypeSymbol)
     {
-        functionSignature += resolveTypeName(functionArg.getType());
-        if (functionArgIndex < functionArgCount - 1)
+        if (!isFirstArg)
         {
-            functionSignature += L", ";
+            name += L", ";
         }
-        functionArgIndex++;
+        appendTypeName(functionArg.getType(), name);
+        isFirstArg = false;
     }
 
-    functionSignature += L")";
+    name += L')';
 
     // Add qualifiers
     if (funcTypeSymbol.getConstType())
     {
-        functionSignature += L" const";
+        name += L" const";
     }
     if (funcTypeSymbol.getVolatileType())
     {
-        functionSignature += L" volatile";
+        name += L" volatile";
     }
     // TODO: What does unaligned mean in this context?
 
-    return L"std::function<" + functionSignature + L">";
+    name += L'>';
 }
 
-std::wstring resolveTypeName(const Symbol& symbol)
+void TypeNameResolver::appendUncachedTypeName(const Symbol& symbol, std::wstring& name)
 {
     const auto symTag = symbol.getSymTag();
 
@@ -398,35 +463,45 @@ std::wstring resolveTypeName(const Symbol& symbol)
     {
     case SymTagBaseType:
     {
-        return resolveBaseTypeName(symbol);
+        name += resolveBaseTypeName(symbol);
+        break;
     }
     case SymTagPointerType:
     {
-        if (SymTagFunctionType == symbol.getType().getSymTag())
+        const auto pointeeType = symbol.getType();
+        if (SymTagFunctionType == pointeeType.getSymTag())
         {
             // Pointers to functions are treated differently since a pointer-to function signature/std::function is odd.
-            return resolveFunctionTypeName(symbol.getType(), false);
+            appendFunctionTypeName(static_cast<const FunctionType&>(pointeeType), false, name);
+            break;
         }
-        return resolveTypeName(symbol.getType()) + L"*";
+        appendTypeName(pointeeType, name);
+        name += L'*';
+        break;
     }
     case SymTagArrayType:
     {
         const auto elementType  = symbol.getType();
         const auto elementCount = symbol.getCount();
-        return L"std::array<" + resolveTypeName(elementType) + L", " + std::to_wstring(elementCount) + L">";
+        name += L"std::array<";
+        appendTypeName(elementType, name);
+        name += L", ";
+        name += std::to_wstring(elementCount);
+        name += L'>';
+        break;
     }
     case SymTagTypedef:
     {
-        const auto underlyingType = symbol.getType();
-        return resolveTypeName(underlyingType);
+        appendTypeName(symbol.getType(), name);
+        break;
     }
     case SymTagUDT:
     case SymTagEnum:
     {
         if (!isSymbolUnnamed(symbol) || true)
         {
-            const auto typeName = symbol.getName();
-            return typeName;
+            name += std::wstring(symbol.getName());
+            break;
         }
         // Unnamed symbol.
         // Unfortunately, we cannot always inline the struct, as in cases of std::array<T>, T may not be an anonymous struct.
@@ -438,12 +513,15 @@ std::wstring resolveTypeName(const Symbol& symbol)
             throw UnimplementedException("Unnamed bitfields as nested types are not supported!");
         }
         const auto length = symbol.getLength();
-        return L"/* Unnamed struct */ std::array<char, " + std::to_wstring(length) + L">";
+        name += L"/* Unnamed struct */ std::array<char, ";
+        name += std::to_wstring(length);
+        name += L'>';
+        break;
     }
     case SymTagFunctionType:
     {
-        const FunctionType funcTypeSymbol = static_cast<const FunctionType&>(symbol);
-        return resolveFunctionTypeName(funcTypeSymbol, true);
+        appendFunctionTypeName(static_cast<const FunctionType&>(symbol), true, name);
+        break;
     }
     default:
         throw std::invalid_argument("Unrecognized SymTag!");
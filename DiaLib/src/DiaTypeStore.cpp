@@ -0,0 +1,510 @@
+#include "pch.h"
+//
+#include "DiaDataSource.h"
+#include "DiaHashing.h"
+#include "DiaStructuralHash.h"
+#include "DiaSymbolEnumerator.h"
+#include "DiaTypeEquivalence.h"
+#include "DiaTypeResolution.h"
+#include "DiaTypeStore.h"
+#include "Exceptions.h"
+#include "HashUtils.h"
+#include "VariantUtils.h"
+#include <algorithm>
+
+namespace dia
+{
+namespace
+{
+constexpr char TYPE_STORE_MAGIC[8]           = {'D', 'I', 'A', 'T', 'Y', 'P', 'E', 'S'};
+constexpr uint32_t TYPE_STORE_FORMAT_VERSION = 2;
+
+// File layout: the header, followed by records. Each record is its kind and payload size (both uint32_t) followed by the payload.
+constexpr size_t TYPE_STORE_HEADER_SIZE = sizeof(TYPE_STORE_MAGIC) + 4 * sizeof(uint32_t);
+constexpr size_t RECORD_HEADER_SIZE     = 2 * sizeof(uint32_t);
+
+constexpr uint32_t TYPE_RECORD_KIND  = 1;
+constexpr uint32_t BUILD_RECORD_KIND = 2;
+
+class RecordWriter
+{
+public:
+    template <typename T>
+    void write(T value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written as is");
+        const auto data = reinterpret_cast<const uint8_t*>(&value);
+        m_buffer.insert(m_buffer.end(), data, data + sizeof(value));
+    }
+
+    void writeString(const std::wstring& string)
+    {
+        write(static_cast<uint32_t>(string.length()));
+        const auto data = reinterpret_cast<const uint8_t*>(string.data());
+        m_buffer.insert(m_buffer.end(), data, data + string.length() * sizeof(wchar_t));
+    }
+
+    const std::vector<uint8_t>& getBuffer() const { return m_buffer; }
+
+private:
+    std::vector<uint8_t> m_buffer{};
+};
+
+class RecordReader
+{
+public:
+    explicit RecordReader(const std::vector<uint8_t>& buffer)
+        : m_buffer{buffer}
+    {
+    }
+
+    template <typename T>
+    T read()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read as is");
+        T value{};
+        memcpy(&value, consume(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    std::wstring readString()
+    {
+        const auto length = read<uint32_t>();
+        const auto data   = consume(length * sizeof(wchar_t));
+        return std::wstring(reinterpret_cast<const wchar_t*>(data), length);
+    }
+
+private:
+    const uint8_t* consume(size_t size)
+    {
+        if (m_buffer.size() - m_position < size)
+        {
+            throw InvalidFileFormatException("Type store record is truncated!");
+        }
+        const auto data = m_buffer.data() + m_position;
+        m_position += size;
+        return data;
+    }
+
+    const std::vector<uint8_t>& m_buffer;
+    size_t m_position{0};
+};
+
+/// @return Whether all the bytes could be read. Reading past the end of the file is not an error, since the last record may be truncated.
+bool readAt(HANDLE file, LONGLONG offset, void* buffer, size_t size)
+{
+    OVERLAPPED overlapped{};
+    overlapped.Offset     = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD bytesRead       = 0;
+    if (!ReadFile(file, buffer, static_cast<DWORD>(size), &bytesRead, &overlapped) && ERROR_HANDLE_EOF != GetLastError())
+    {
+        throw WinApiException("Failed to read from the type store!");
+    }
+    return size == bytesRead;
+}
+
+void writeAt(HANDLE file, LONGLONG offset, const void* buffer, size_t size)
+{
+    OVERLAPPED overlapped{};
+    overlapped.Offset     = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD bytesWritten    = 0;
+    if (!WriteFile(file, buffer, static_cast<DWORD>(size), &bytesWritten, &overlapped) || size != bytesWritten)
+    {
+        throw WinApiException("Failed to write to the type store!");
+    }
+}
+
+std::vector<uint8_t> writeHeader()
+{
+    RecordWriter header{};
+    for (const auto magicChar : TYPE_STORE_MAGIC)
+    {
+        header.write(magicChar);
+    }
+    header.write(TYPE_STORE_FORMAT_VERSION);
+    header.write(STABLE_HASH_VERSION);
+    // Structural hashes are size_t, so stores are only comparable between builds of the same bitness.
+    header.write(static_cast<uint32_t>(sizeof(size_t)));
+    header.write(uint32_t{0});
+    return header.getBuffer();
+}
+
+StoredMember makeStoredMember(const DataSource& dataSource, const Symbol& member)
+{
+    StoredMember storedMember{};
+    storedMember.symTag = getSymTag(member);
+    storedMember.name   = std::wstring(getOrDefault(getName, member));
+    storedMember.access = static_cast<DWORD>(getOrDefault(getAccess, member));
+    switch (storedMember.symTag)
+    {
+    case SymTagData:
+    {
+        const auto memberType = getType(member);
+        storedMember.typeName = dataSource.resolveTypeName(memberType);
+        storedMember.offset   = getOrDefault(getOffset, member);
+        storedMember.isStatic = getOrDefault(getIsStatic, member);
+        if (LocIsBitField == getLocationType(member))
+        {
+            storedMember.size        = getLength(member);
+            storedMember.bitPosition = getBitPosition(member);
+        }
+        else
+        {
+            storedMember.size = getOrDefault(getLength, memberType);
+        }
+        break;
+    }
+    case SymTagBaseClass:
+    {
+        const auto baseType    = getType(member);
+        storedMember.typeName  = dataSource.resolveTypeName(baseType);
+        storedMember.offset    = getOrDefault(getOffset, member);
+        storedMember.size      = getOrDefault(getLength, baseType);
+        storedMember.isVirtual = getOrDefault(getVirtualBaseClass, member);
+        break;
+    }
+    case SymTagFunction:
+        storedMember.typeName  = dataSource.resolveTypeName(getType(member));
+        storedMember.isStatic  = getOrDefault(getIsStatic, member);
+        storedMember.isVirtual = getOrDefault(getVirtual, member);
+        break;
+    case SymTagUDT:
+    case SymTagEnum:
+        // Nested types
+        storedMember.size = getOrDefault(getLength, member);
+        break;
+    case SymTagTypedef:
+        storedMember.typeName = dataSource.resolveTypeName(getType(member));
+        break;
+    default:
+        break;
+    }
+    return storedMember;
+}
+
+StoredType makeStoredType(const DataSource& dataSource, const Symbol& type, uint64_t structuralHash, uint64_t confirmingHash)
+{
+    StoredType storedType{};
+    storedType.structuralHash = structuralHash;
+    storedType.confirmingHash = confirmingHash;
+    storedType.symTag         = getSymTag(type);
+    storedType.name           = std::wstring(getOrDefault(getName, type));
+
+    switch (storedType.symTag)
+    {
+    case SymTagUDT:
+        storedType.length = getOrDefault(getLength, type);
+        // The children the structural hash covers, see StructuralHasher::hashUserDefinedType.
+        for (const auto& member : enumerate<Symbol>(type, SymTagNull))
+        {
+            switch (getSymTag(member))
+            {
+            case SymTagData:
+            case SymTagBaseClass:
+            case SymTagFunction:
+            case SymTagUDT:
+            case SymTagEnum:
+            case SymTagTypedef:
+                storedType.members.push_back(makeStoredMember(dataSource, member));
+                break;
+            default:
+                break;
+            }
+        }
+        break;
+    case SymTagEnum:
+        storedType.length = getOrDefault(getLength, type);
+        for (const auto& value : enumerate<Symbol>(type, SymTagData))
+        {
+            StoredMember storedMember{};
+            storedMember.name  = std::wstring(getName(value));
+            storedMember.value = variantToInteger(getValue(value));
+            storedType.members.push_back(std::move(storedMember));
+        }
+        break;
+    case SymTagTypedef:
+    {
+        const auto aliasedType = getType(type);
+        storedType.length      = getOrDefault(getLength, aliasedType);
+        storedType.typeName    = dataSource.resolveTypeName(aliasedType);
+        break;
+    }
+    default:
+        break;
+    }
+    return storedType;
+}
+
+std::vector<uint8_t> serializeType(const StoredType& storedType)
+{
+    RecordWriter record{};
+    // The hashes must stay first, since loading the store only reads them.
+    record.write(storedType.structuralHash);
+    record.write(storedType.confirmingHash);
+    record.write(static_cast<uint32_t>(storedType.symTag));
+    record.write(storedType.length);
+    record.writeString(storedType.name);
+    record.writeString(storedType.typeName);
+    record.write(static_cast<uint32_t>(storedType.members.size()));
+    for (const auto& member : storedType.members)
+    {
+        record.write(static_cast<uint32_t>(member.symTag));
+        record.writeString(member.name);
+        record.writeString(member.typeName);
+        record.write(member.offset);
+        record.write(member.size);
+        record.write(member.bitPosition);
+        record.write(member.value);
+        record.write(member.access);
+        record.write(member.isStatic);
+        record.write(member.isVirtual);
+    }
+    return record.getBuffer();
+}
+
+StoredType deserializeType(const std::vector<uint8_t>& payload)
+{
+    RecordReader record{payload};
+    StoredType storedType{};
+    storedType.structuralHash = record.read<uint64_t>();
+    storedType.confirmingHash = record.read<uint64_t>();
+    storedType.symTag         = static_cast<enum SymTagEnum>(record.read<uint32_t>());
+    storedType.length         = record.read<ULONGLONG>();
+    storedType.name           = record.readString();
+    storedType.typeName       = record.readString();
+    storedType.members.resize(record.read<uint32_t>());
+    for (auto& member : storedType.members)
+    {
+        member.symTag      = static_cast<enum SymTagEnum>(record.read<uint32_t>());
+        member.name        = record.readString();
+        member.typeName    = record.readString();
+        member.offset      = record.read<LONG>();
+        member.size        = record.read<ULONGLONG>();
+        member.bitPosition = record.read<DWORD>();
+        member.value       = record.read<LONGLONG>();
+        member.access      = record.read<DWORD>();
+        member.isStatic    = record.read<bool>();
+        member.isVirtual   = record.read<bool>();
+    }
+    return storedType;
+}
+}  // namespace
+
+TypeStore::TypeStore(const std::wstring& storeFilePath)
+{
+    const HANDLE file = CreateFileW(storeFilePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file)
+    {
+        throw WinApiException("Failed to open the type store!");
+    }
+    m_file.Attach(file);
+    load();
+}
+
+void TypeStore::load()
+{
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(m_file, &fileSize))
+    {
+        throw WinApiException("Failed to get the size of the type store!");
+    }
+
+    const auto expectedHeader = writeHeader();
+    if (0 == fileSize.QuadPart)
+    {
+        writeAt(m_file, 0, expectedHeader.data(), expectedHeader.size());
+        m_endOfFile = expectedHeader.size();
+        return;
+    }
+
+    std::vector<uint8_t> header(TYPE_STORE_HEADER_SIZE);
+    if (!readAt(m_file, 0, header.data(), header.size()) || 0 != memcmp(header.data(), TYPE_STORE_MAGIC, sizeof(TYPE_STORE_MAGIC)))
+    {
+        throw InvalidFileFormatException("The file is not a type store!");
+    }
+    if (header != expectedHeader)
+    {
+        throw InvalidFileFormatException("The type store was written by an incompatible version!");
+    }
+
+    LONGLONG offset = TYPE_STORE_HEADER_SIZE;
+    std::vector<uint8_t> payload{};
+    for (;;)
+    {
+        uint32_t recordHeader[2] = {};
+        if (!readAt(m_file, offset, recordHeader, RECORD_HEADER_SIZE) || fileSize.QuadPart - offset - RECORD_HEADER_SIZE < recordHeader[1])
+        {
+            break;
+        }
+
+        const auto recordKind    = recordHeader[0];
+        const auto payloadSize   = recordHeader[1];
+        const auto payloadOffset = offset + RECORD_HEADER_SIZE;
+        if (TYPE_RECORD_KIND == recordKind)
+        {
+            uint64_t hashes[2] = {};
+            if (payloadSize < sizeof(hashes) || !readAt(m_file, payloadOffset, hashes, sizeof(hashes)))
+            {
+                break;
+            }
+            m_typeLocations.emplace(hashes[0], TypeLocation{payloadOffset, payloadSize, hashes[1]});
+        }
+        else if (BUILD_RECORD_KIND == recordKind)
+        {
+            payload.resize(payloadSize);
+            if (!readAt(m_file, payloadOffset, payload.data(), payload.size()))
+            {
+                break;
+            }
+            RecordReader record{payload};
+            auto buildName = record.readString();
+            std::vector<uint64_t> typeHashes(record.read<uint32_t>());
+            for (auto& typeHash : typeHashes)
+            {
+                typeHash = record.read<uint64_t>();
+            }
+            addBuild(buildName, std::move(typeHashes));
+        }
+        // Records of unknown kinds are skipped, so that older readers can open stores extended with new kinds of records.
+        offset = payloadOffset + payloadSize;
+    }
+
+    // Drop whatever was left of an interrupted write, so that it does not get in the way of the next record.
+    m_endOfFile = offset;
+    if (offset != fileSize.QuadPart)
+    {
+        LARGE_INTEGER endOfFile{};
+        endOfFile.QuadPart = offset;
+        if (!SetFilePointerEx(m_file, endOfFile, nullptr, FILE_BEGIN) || !SetEndOfFile(m_file))
+        {
+            throw WinApiException("Failed to truncate the type store!");
+        }
+    }
+}
+
+void TypeStore::appendRecord(uint32_t recordKind, const std::vector<uint8_t>& payload)
+{
+    RecordWriter record{};
+    record.write(recordKind);
+    record.write(static_cast<uint32_t>(payload.size()));
+    std::vector<uint8_t> buffer = record.getBuffer();
+    buffer.insert(buffer.end(), payload.begin(), payload.end());
+
+    writeAt(m_file, m_endOfFile, buffer.data(), buffer.size());
+    m_endOfFile += buffer.size();
+}
+
+void TypeStore::addBuild(const std::wstring& buildName, std::vector<uint64_t>&& typeHashes)
+{
+    const auto buildIndex = m_buildNames.size();
+    for (const auto typeHash : typeHashes)
+    {
+        m_buildIndicesByType[typeHash].push_back(buildIndex);
+    }
+    m_buildIndexByName.emplace(buildName, buildIndex);
+    m_buildNames.push_back(buildName);
+    m_buildTypes.push_back(std::move(typeHashes));
+}
+
+size_t TypeStore::ingest(const std::wstring& buildName, const DataSource& dataSource)
+{
+    if (containsBuild(buildName))
+    {
+        throw InvalidUsageException("A build with the same name was already ingested!");
+    }
+
+    size_t newTypeCount = 0;
+    std::vector<uint64_t> typeHashes{};
+    const TypeEquivalenceClasses equivalenceClasses{dataSource};
+    StructuralHasher confirmingHasher{CONFIRMING_STRUCTURAL_HASH_SEED};
+    for (const auto& equivalenceClass : equivalenceClasses.getClasses())
+    {
+        const uint64_t structuralHash = equivalenceClass.structuralHash;
+        const auto canonicalType      = dataSource.getSymbolById(equivalenceClass.canonicalSymIndexId);
+        const uint64_t confirmingHash = confirmingHasher.hash(canonicalType);
+        typeHashes.push_back(structuralHash);
+        const auto location = m_typeLocations.find(structuralHash);
+        if (m_typeLocations.end() != location)
+        {
+            if (confirmingHash != location->second.confirmingHash)
+            {
+                throw HashCollisionException("A type of the build has the structural hash of a different stored type!");
+            }
+            continue;
+        }
+
+        // Types are written before the build which references them, so a build never refers to a type missing from the store.
+        const auto payload       = serializeType(makeStoredType(dataSource, canonicalType, structuralHash, confirmingHash));
+        const auto payloadOffset = m_endOfFile + RECORD_HEADER_SIZE;
+        appendRecord(TYPE_RECORD_KIND, payload);
+        m_typeLocations.emplace(structuralHash, TypeLocation{payloadOffset, static_cast<uint32_t>(payload.size()), confirmingHash});
+        ++newTypeCount;
+    }
+    std::sort(typeHashes.begin(), typeHashes.end());
+    typeHashes.erase(std::unique(typeHashes.begin(), typeHashes.end()), typeHashes.end());
+
+    RecordWriter record{};
+    record.writeString(buildName);
+    record.write(static_cast<uint32_t>(typeHashes.size()));
+    for (const auto typeHash : typeHashes)
+    {
+        record.write(typeHash);
+    }
+    appendRecord(BUILD_RECORD_KIND, record.getBuffer());
+    if (!FlushFileBuffers(m_file))
+    {
+        throw WinApiException("Failed to flush the type store!");
+    }
+
+    addBuild(buildName, std::move(typeHashes));
+    return newTypeCount;
+}
+
+bool TypeStore::containsType(uint64_t structuralHash) const { return m_typeLocations.end() != m_typeLocations.find(structuralHash); }
+
+StoredType TypeStore::getType(uint64_t structuralHash) const
+{
+    const auto location = m_typeLocations.find(structuralHash);
+    if (m_typeLocations.end() == location)
+    {
+        throw SymbolNotFoundException("No type with the given hash is stored!");
+    }
+
+    std::vector<uint8_t> payload(location->second.recordSize);
+    if (!readAt(m_file, location->second.fileOffset, payload.data(), payload.size()))
+    {
+        throw InvalidFileFormatException("Type store record is truncated!");
+    }
+    return deserializeType(payload);
+}
+
+bool TypeStore::containsBuild(const std::wstring& buildName) const { return m_buildIndexByName.end() != m_buildIndexByName.find(buildName); }
+
+const std::vector<uint64_t>& TypeStore::getBuildTypes(const std::wstring& buildName) const
+{
+    const auto buildIndex = m_buildIndexByName.find(buildName);
+    if (m_buildIndexByName.end() == buildIndex)
+    {
+        throw SymbolNotFoundException("No build with the given name was ingested!");
+    }
+    return m_buildTypes[buildIndex->second];
+}
+
+std::vector<std::wstring> TypeStore::getBuildsContaining(uint64_t structuralHash) const
+{
+    std::vector<std::wstring> buildNames{};
+    const auto buildIndices = m_buildIndicesByType.find(structuralHash);
+    if (m_buildIndicesByType.end() != buildIndices)
+    {
+        for (const auto buildIndex : buildIndices->second)
+        {
+            buildNames.push_back(m_buildNames[buildIndex]);
+        }
+    }
+    return buildNames;
+}
+
+}  // namespace dia
@@ -0,0 +1,1440 @@
+#include "pch.h"
+//
+#include "AnyString.h"
+#include "DiaUndecorate.h"
+#include "Exceptions.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <thread>
+
+namespace dia
+{
+namespace
+{
+/// @brief Number of names a worker claims at once. Undecorating a name takes about a microsecond, so batches keep the shared counter cold.
+constexpr size_t UNDECORATE_BATCH_SIZE = 0x400;
+
+/// @brief Decorated names refer back to at most 10 names and 10 parameter types.
+constexpr size_t MAX_BACK_REFERENCES = 10;
+
+/// @brief How deeply types, template instantiations and nested symbols may nest, so a crafted name cannot overflow the stack of the parser.
+/// Real names nest far less than this.
+constexpr size_t MAX_NESTING_DEPTH = 128;
+
+/// @brief Thrown when a name is not a valid decorated name, which is then returned as is.
+struct UndecorateError
+{
+};
+
+std::string toUtf8(const std::wstring& text)
+{
+    if (text.empty())
+    {
+        return {};
+    }
+    const auto size = WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    if (0 == size)
+    {
+        throw WinApiException("Failed to convert a decorated name to UTF-8!");
+    }
+    std::string utf8Text(size, '\0');
+    WideCharToMultiByte(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), &utf8Text[0], size, nullptr, nullptr);
+    return utf8Text;
+}
+
+/// @brief Append a word, separated by a space unless either is empty.
+void appendWord(std::string& text, const std::string& word)
+{
+    if (word.empty())
+    {
+        return;
+    }
+    if (!text.empty())
+    {
+        text += ' ';
+    }
+    text += word;
+}
+
+enum class TypeKind
+{
+    Simple,
+    Pointer,
+    Function,
+    Array,
+};
+
+/// @brief A decoded type. Types are rendered around a declarator (the name they declare), as pointers to functions and arrays wrap it.
+struct TypeNode
+{
+    TypeKind kind{TypeKind::Simple};
+    /// @brief The name of a simple type (e.g. "int" or "class Foo"), or the token of a pointer ("*", "&", "&&" or "Foo::*").
+    std::string name{};
+    /// @brief The qualifiers of the type, or those of `this` for member functions.
+    bool isConst{false};
+    bool isVolatile{false};
+    bool isPtr64{false};
+    bool isRestrict{false};
+    bool isUnaligned{false};
+    /// @brief The pointee of a pointer, the element of an array, or the return type of a function (null for structors).
+    TypeNode* target{nullptr};
+    const char* callingConvention{nullptr};
+    const char* refQualifier{nullptr};
+    std::vector<const TypeNode*> parameters{};
+    bool isVariadic{false};
+    bool isNoexcept{false};
+    std::vector<LONGLONG> dimensions{};
+};
+
+/// @brief The last component of a qualified name.
+struct Identifier
+{
+    enum class Kind
+    {
+        Plain,
+        Constructor,
+        Destructor,
+        Conversion,
+    };
+
+    std::string name{};
+    Kind kind{Kind::Plain};
+    std::string templateArguments{};
+};
+
+/// @brief Whether a type is decorated with its qualifiers: function return types are (as "?A"), parameters and pointees are not.
+enum class QualifierMode
+{
+    Drop,
+    Result,
+};
+
+/// @brief A recursive descent parser of the MSVC name decoration scheme, rendering names like undname.exe (and thus DIA) does.
+class Undecorator
+{
+public:
+    Undecorator(const std::string& decoratedName, uint32_t flags)
+        : m_cur{decoratedName.data()}
+        , m_end{decoratedName.data() + decoratedName.size()}
+        , m_flags{flags}
+    {
+    }
+
+    std::string undecorate()
+    {
+        auto name = undecorateSymbol();
+        expectEnd();
+        return name;
+    }
+
+    std::string undecorateType()
+    {
+        consume('.');
+        const auto type = render(*parseType(QualifierMode::Result), {});
+        expectEnd();
+        return type;
+    }
+
+private:
+    struct BackReferences
+    {
+        /// @brief Memorized names, as their decorated key (which is only different for anonymous namespaces) and their rendering.
+        std::vector<std::pair<std::string, std::string>> names{};
+        std::vector<const TypeNode*> parameters{};
+    };
+
+    /// @brief Counts a level of nesting for as long as it lives, and rejects the name once it nests too deeply.
+    class NestingGuard
+    {
+    public:
+        explicit NestingGuard(size_t& depth)
+            : m_depth{depth}
+        {
+            if (MAX_NESTING_DEPTH <= m_depth)
+            {
+                throw UndecorateError{};
+            }
+            ++m_depth;
+        }
+        ~NestingGuard() { --m_depth; }
+        NestingGuard(const NestingGuard&)            = delete;
+        NestingGuard& operator=(const NestingGuard&) = delete;
+
+    private:
+        size_t& m_depth;
+    };
+
+    bool hasFlag(uint32_t flag) const { return flag == (m_flags & flag); }
+
+    char peek() const { return (m_cur == m_end) ? '\0' : *m_cur; }
+
+    char next()
+    {
+        if (m_cur == m_end)
+        {
+            throw UndecorateError{};
+        }
+        return *m_cur++;
+    }
+
+    bool consume(char c)
+    {
+        if (c != peek())
+        {
+            return false;
+        }
+        ++m_cur;
+        return true;
+    }
+
+    bool startsWith(const char* prefix) const
+    {
+        const auto length = strlen(prefix);
+        return static_cast<size_t>(m_end - m_cur) >= length && 0 == memcmp(m_cur, prefix, length);
+    }
+
+    bool consume(const char* prefix)
+    {
+        if (!startsWith(prefix))
+        {
+            return false;
+        }
+        m_cur += strlen(prefix);
+        return true;
+    }
+
+    void expect(char c)
+    {
+        if (!consume(c))
+        {
+            throw UndecorateError{};
+        }
+    }
+
+    void expectEnd() const
+    {
+        if (m_cur != m_end)
+        {
+            throw UndecorateError{};
+        }
+    }
+
+    static bool isDigit(char c) { return '0' <= c && c <= '9'; }
+
+    TypeNode* newNode(TypeKind kind)
+    {
+        m_nodes.emplace_back();
+        m_nodes.back().kind = kind;
+        return &m_nodes.back();
+    }
+
+    /// @brief A Microsoft keyword (e.g. "__cdecl"), unless the flags leave them out.
+    std::string msKeyword(const char* keyword) const
+    {
+        if (hasFlag(UNDECORATE_NO_MS_KEYWORDS))
+        {
+            return {};
+        }
+        if (hasFlag(UNDECORATE_NO_LEADING_UNDERSCORES))
+        {
+            while ('_' == *keyword)
+            {
+                ++keyword;
+            }
+        }
+        return keyword;
+    }
+
+    std::string ptr64Keyword() const { return hasFlag(UNDECORATE_NO_PTR64) ? std::string{} : msKeyword("__ptr64"); }
+
+    // Numbers are a digit for 1 to 10, or hexadecimal digits from 'A' to 'P' ending with '@', negative after a '?'.
+    LONGLONG parseNumber()
+    {
+        const bool isNegative = consume('?');
+        ULONGLONG value       = 0;
+        if (isDigit(peek()))
+        {
+            value = static_cast<ULONGLONG>(next() - '0') + 1;
+        }
+        else
+        {
+            for (auto digit = next(); '@' != digit; digit = next())
+            {
+                if (digit < 'A' || 'P' < digit)
+                {
+                    throw UndecorateError{};
+                }
+                value = (value << 4) | static_cast<ULONGLONG>(digit - 'A');
+            }
+        }
+        return isNegative ? -static_cast<LONGLONG>(value) : static_cast<LONGLONG>(value);
+    }
+
+    void parseQualifiers(bool& isConst, bool& isVolatile)
+    {
+        const auto qualifiers = next();
+        if (qualifiers < 'A' || 'D' < qualifiers)
+        {
+            throw UndecorateError{};
+        }
+        isConst    = 0 != ((qualifiers - 'A') & 1);
+        isVolatile = 0 != ((qualifiers - 'A') & 2);
+    }
+
+    void parsePointerExtQualifiers(TypeNode& type)
+    {
+        for (;;)
+        {
+            if (consume('E'))
+            {
+                type.isPtr64 = true;
+            }
+            else if (consume('I'))
+            {
+                type.isRestrict = true;
+            }
+            else if (consume('F'))
+            {
+                type.isUnaligned = true;
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    void memorizeName(const std::string& key, const std::string& name)
+    {
+        auto& names = m_backReferences.names;
+        if (MAX_BACK_REFERENCES > names.size() &&
+            names.end() == std::find_if(names.begin(), names.end(), [&key](const auto& memorized) { return memorized.first == key; }))
+        {
+            names.emplace_back(key, name);
+        }
+    }
+
+    std::string parseNameBackReference()
+    {
+        const auto index = static_cast<size_t>(next() - '0');
+        if (m_backReferences.names.size() <= index)
+        {
+            throw UndecorateError{};
+        }
+        return m_backReferences.names[index].second;
+    }
+
+    std::string parseSimpleName(bool memorize)
+    {
+        const auto end = std::find(m_cur, m_end, '@');
+        if (m_end == end || m_cur == end)
+        {
+            throw UndecorateError{};
+        }
+        std::string name{m_cur, end};
+        m_cur = end + 1;
+        if (memorize)
+        {
+            memorizeName(name, name);
+        }
+        return name;
+    }
+
+    static std::string renderIdentifier(const Identifier& identifier) { return identifier.name + identifier.templateArguments; }
+
+    /// @brief The last component of the name of a symbol, which may be an operator or a special name.
+    Identifier parseUnqualifiedSymbolName()
+    {
+        if (isDigit(peek()))
+        {
+            return Identifier{parseNameBackReference()};
+        }
+        if (consume("?$"))
+        {
+            return parseTemplateInstantiation(false);
+        }
+        if (consume('?'))
+        {
+            return parseSpecialName();
+        }
+        return Identifier{parseSimpleName(true)};
+    }
+
+    /// @brief A template instantiation, whose name and arguments have back references of their own.
+    Identifier parseTemplateInstantiation(bool memorize)
+    {
+        const NestingGuard nesting{m_depth};
+        BackReferences outerBackReferences{};
+        std::swap(outerBackReferences, m_backReferences);
+        auto identifier              = parseUnqualifiedSymbolName();
+        identifier.templateArguments = parseTemplateArguments();
+        std::swap(outerBackReferences, m_backReferences);
+
+        if (memorize)
+        {
+            if (Identifier::Kind::Plain != identifier.kind)
+            {
+                throw UndecorateError{};
+            }
+            const auto name = renderIdentifier(identifier);
+            memorizeName(name, name);
+        }
+        return identifier;
+    }
+
+    std::string parseTemplateArguments()
+    {
+        std::string arguments{};
+        while (!consume('@'))
+        {
+            // Empty parameter packs.
+            if (consume("$S") || consume("$$V") || consume("$$$V") || consume("$$Z"))
+            {
+                continue;
+            }
+
+            std::string argument{};
+            if (consume("$0"))
+            {
+                argument = std::to_string(parseNumber());
+            }
+            else if (consume("$D"))
+            {
+                argument = "`template-parameter" + std::to_string(parseNumber()) + "'";
+            }
+            else if (consume("$1"))
+            {
+                argument = "&" + undecorateSymbol();
+            }
+            else if (consume("$E"))
+            {
+                argument = undecorateSymbol();
+            }
+            else if (consume("$$Y"))
+            {
+                argument = parseFullyQualifiedTypeName();
+            }
+            else
+            {
+                argument = render(*parseType(QualifierMode::Drop), {});
+            }
+            arguments += arguments.empty() ? "" : ",";
+            arguments += argument;
+        }
+        // Closing angle brackets are kept apart, as in pre-C++11 code.
+        return "<" + arguments + ((!arguments.empty() && '>' == arguments.back()) ? " >" : ">");
+    }
+
+    /// @brief The name of an operator, a structor or a compiler generated symbol, after its '?'.
+    Identifier parseSpecialName()
+    {
+        static const char* const OPERATORS[] = {
+            "",
+            "",
+            "operator new",
+            "operator delete",
+            "operator=",
+            "operator>>",
+            "operator<<",
+            "operator!",
+            "operator==",
+            "operator!=",
+            "operator[]",
+            "",
+            "operator->",
+            "operator*",
+            "operator++",
+            "operator--",
+            "operator-",
+            "operator+",
+            "operator&",
+            "operator->*",
+            "operator/",
+            "operator%",
+            "operator<",
+            "operator<=",
+            "operator>",
+            "operator>=",
+            "operator,",
+            "operator()",
+            "operator~",
+            "operator^",
+            "operator|",
+            "operator&&",
+            "operator||",
+            "operator*=",
+            "operator+=",
+            "operator-=",
+        };
+        static const char* const UNDERSCORE_NAMES[] = {
+            "operator/=",
+            "operator%=",
+            "operator>>=",
+            "operator<<=",
+            "operator&=",
+            "operator|=",
+            "operator^=",
+            "`vftable'",
+            "`vbtable'",
+            "`vcall'",
+            "`typeof'",
+            "`local static guard'",
+            "`string'",
+            "`vbase destructor'",
+            "`vector deleting destructor'",
+            "`default constructor closure'",
+            "`scalar deleting destructor'",
+            "`vector constructor iterator'",
+            "`vector destructor iterator'",
+            "`vector vbase constructor iterator'",
+            "`virtual displacement map'",
+            "`eh vector constructor iterator'",
+            "`eh vector destructor iterator'",
+            "`eh vector vbase constructor iterator'",
+            "`copy constructor closure'",
+            "",
+            "",
+            "",
+            "`local vftable'",
+            "`local vftable constructor closure'",
+            "operator new[]",
+            "operator delete[]",
+            "",
+            "`placement delete closure'",
+            "`placement delete[] closure'",
+        };
+        static const char* const DOUBLE_UNDERSCORE_NAMES[] = {
+            "`managed vector constructor iterator'",
+            "`managed vector destructor iterator'",
+            "`eh vector copy constructor iterator'",
+            "`eh vector vbase copy constructor iterator'",
+            "",
+            "",
+            "`vector copy constructor iterator'",
+            "`vector vbase copy constructor iterator'",
+            "`managed vector copy constructor iterator'",
+            "`local static thread guard'",
+            "",
+            "operator co_await",
+            "operator<=>",
+        };
+
+        const auto code = next();
+        if ('0' == code)
+        {
+            return Identifier{{}, Identifier::Kind::Constructor};
+        }
+        if ('1' == code)
+        {
+            return Identifier{{}, Identifier::Kind::Destructor};
+        }
+        if ('B' == code)
+        {
+            return Identifier{{}, Identifier::Kind::Conversion};
+        }
+        if ('_' != code)
+        {
+            return Identifier{lookUpName(OPERATORS, _countof(OPERATORS), codeToIndex(code))};
+        }
+
+        const auto underscoreCode = next();
+        if ('R' == underscoreCode)
+        {
+            return Identifier{parseRttiName()};
+        }
+        if ('_' != underscoreCode)
+        {
+            return Identifier{lookUpName(UNDERSCORE_NAMES, _countof(UNDERSCORE_NAMES), codeToIndex(underscoreCode))};
+        }
+
+        const auto doubleUnderscoreCode = next();
+        switch (doubleUnderscoreCode)
+        {
+        case 'E':
+            return Identifier{"`dynamic initializer for '" + parseInitializedName() + "''"};
+        case 'F':
+            return Identifier{"`dynamic atexit destructor for '" + parseInitializedName() + "''"};
+        case 'K':
+            return Identifier{"operator \"\" " + parseSimpleName(false)};
+        default:
+            // These codes are letters only.
+            return Identifier{lookUpName(DOUBLE_UNDERSCORE_NAMES, _countof(DOUBLE_UNDERSCORE_NAMES), codeToIndex(doubleUnderscoreCode) - 10)};
+        }
+    }
+
+    /// @brief The index of a code, which is a digit or a capital letter ("0" to "9" and then "A" to "Z").
+    static size_t codeToIndex(char code)
+    {
+        if (isDigit(code))
+        {
+            return static_cast<size_t>(code - '0');
+        }
+        if ('A' <= code && code <= 'Z')
+        {
+            return static_cast<size_t>(code - 'A') + 10;
+        }
+        throw UndecorateError{};
+    }
+
+    static std::string lookUpName(const char* const* names, size_t count, size_t index)
+    {
+        if (count <= index || '\0' == *names[index])
+        {
+            throw UndecorateError{};
+        }
+        return names[index];
+    }
+
+    std::string parseRttiName()
+    {
+        switch (next())
+        {
+        case '1':
+        {
+            const auto memberDisplacement  = parseNumber();
+            const auto vbtableDisplacement = parseNumber();
+            const auto vbaseDisplacement   = parseNumber();
+            const auto attributes          = parseNumber();
+            return "`RTTI Base Class Descriptor at (" + std::to_string(memberDisplacement) + "," + std::to_string(vbtableDisplacement) + "," +
+                   std::to_string(vbaseDisplacement) + "," + std::to_string(attributes) + ")'";
+        }
+        case '2':
+            return "`RTTI Base Class Array'";
+        case '3':
+            return "`RTTI Class Hierarchy Descriptor'";
+        case '4':
+            return "`RTTI Complete Object Locator'";
+        default:
+            throw UndecorateError{};
+        }
+    }
+
+    /// @brief The variable of a dynamic initializer or atexit destructor, as a name or as a whole decorated symbol ending with '@'.
+    std::string parseInitializedName()
+    {
+        if ('?' != peek())
+        {
+            return parseSimpleName(false);
+        }
+        auto name = undecorateSymbol();
+        expect('@');
+        return name;
+    }
+
+    /// @brief The scopes of a name, from the innermost one, up to the '@' ending them.
+    std::vector<std::string> parseScopes()
+    {
+        std::vector<std::string> scopes{};
+        while (!consume('@'))
+        {
+            scopes.push_back(parseScope());
+        }
+        return scopes;
+    }
+
+    std::string parseScope()
+    {
+        if (isDigit(peek()))
+        {
+            return parseNameBackReference();
+        }
+        if (consume("?$"))
+        {
+            return renderIdentifier(parseTemplateInstantiation(true));
+        }
+        if (consume("?A"))
+        {
+            const auto key = "?A" + parseSimpleName(false);
+            memorizeName(key, "`anonymous namespace'");
+            return "`anonymous namespace'";
+        }
+        if (startsWithLocalScope())
+        {
+            // The scope of a name declared in a function is the function, and the index of the block declaring it.
+            expect('?');
+            const auto block = parseNumber();
+            expect('?');
+            return "`" + undecorateSymbol() + "'::`" + std::to_string(block) + "'";
+        }
+        return parseSimpleName(true);
+    }
+
+    bool startsWithLocalScope() const
+    {
+        if ('?' != peek())
+        {
+            return false;
+        }
+        auto cur = m_cur + 1;
+        if (cur != m_end && isDigit(*cur))
+        {
+            ++cur;
+        }
+        else
+        {
+            const auto hexStart = cur;
+            while (cur != m_end && 'A' <= *cur && *cur <= 'P')
+            {
+                ++cur;
+            }
+            if (hexStart == cur || cur == m_end || '@' != *cur)
+            {
+                return false;
+            }
+            ++cur;
+        }
+        return cur != m_end && '?' == *cur;
+    }
+
+    static std::string joinScopes(const std::vector<std::string>& scopes, const std::string& name)
+    {
+        std::string qualifiedName{};
+        for (auto scope = scopes.rbegin(); scopes.rend() != scope; ++scope)
+        {
+            qualifiedName += *scope;
+            qualifiedName += "::";
+        }
+        return qualifiedName + name;
+    }
+
+    /// @brief The qualified name of a type (a class, struct, union or enum).
+    std::string parseFullyQualifiedTypeName()
+    {
+        std::string name{};
+        if (isDigit(peek()))
+        {
+            name = parseNameBackReference();
+        }
+        else if (consume("?$"))
+        {
+            name = renderIdentifier(parseTemplateInstantiation(true));
+        }
+        else
+        {
+            name = parseSimpleName(true);
+        }
+        return joinScopes(parseScopes(), name);
+    }
+
+    TypeNode* parseType(QualifierMode mode)
+    {
+        const NestingGuard nesting{m_depth};
+        bool isConst    = false;
+        bool isVolatile = false;
+        if ((QualifierMode::Result == mode && consume('?')) || consume("$$C"))
+        {
+            parseQualifiers(isConst, isVolatile);
+        }
+
+        TypeNode* type = nullptr;
+        switch (peek())
+        {
+        case 'T':
+        case 'U':
+        case 'V':
+        case 'W':
+            type = parseTagType();
+            break;
+        case 'A':
+        case 'B':
+        case 'P':
+        case 'Q':
+        case 'R':
+        case 'S':
+            type = parsePointerType();
+            break;
+        case 'Y':
+            type = parseArrayType();
+            break;
+        case '$':
+            if (consume("$$T"))
+            {
+                type       = newNode(TypeKind::Simple);
+                type->name = "std::nullptr_t";
+            }
+            else if (consume("$$A6"))
+            {
+                type = parseFunctionType(false);
+            }
+            else if (consume("$$A8@@"))
+            {
+                type = parseFunctionType(true);
+            }
+            else if (consume("$$B"))
+            {
+                type = parseArrayType();
+            }
+            else if (startsWith("$$Q") || startsWith("$$R"))
+            {
+                type = parsePointerType();
+            }
+            else
+            {
+                throw UndecorateError{};
+            }
+            break;
+        default:
+            type = parsePrimitiveType();
+            break;
+        }
+        type->isConst    = type->isConst || isConst;
+        type->isVolatile = type->isVolatile || isVolatile;
+        return type;
+    }
+
+    /// @brief The name of a primitive type by its code.
+    static const char* primitiveTypeName(char code)
+    {
+        switch (code)
+        {
+        case 'C':
+            return "signed char";
+        case 'D':
+            return "char";
+        case 'E':
+            return "unsigned char";
+        case 'F':
+            return "short";
+        case 'G':
+            return "unsigned short";
+        case 'H':
+            return "int";
+        case 'I':
+            return "unsigned int";
+        case 'J':
+            return "long";
+        case 'K':
+            return "unsigned long";
+        case 'M':
+            return "float";
+        case 'N':
+            return "double";
+        case 'O':
+            return "long double";
+        case 'X':
+            return "void";
+        default:
+            throw UndecorateError{};
+        }
+    }
+
+    /// @brief The name of a primitive type by its code after an underscore.
+    static const char* extendedPrimitiveTypeName(char code)
+    {
+        switch (code)
+        {
+        case 'D':
+            return "__int8";
+        case 'E':
+            return "unsigned __int8";
+        case 'F':
+            return "__int16";
+        case 'G':
+            return "unsigned __int16";
+        case 'H':
+            return "__int32";
+        case 'I':
+            return "unsigned __int32";
+        case 'J':
+            return "__int64";
+        case 'K':
+            return "unsigned __int64";
+        case 'L':
+            return "__int128";
+        case 'M':
+            return "unsigned __int128";
+        case 'N':
+            return "bool";
+        case 'Q':
+            return "char8_t";
+        case 'S':
+            return "char16_t";
+        case 'U':
+            return "char32_t";
+        case 'W':
+            return "wchar_t";
+        default:
+            throw UndecorateError{};
+        }
+    }
+
+    TypeNode* parsePrimitiveType()
+    {
+        const auto code = next();
+        auto type       = newNode(TypeKind::Simple);
+        type->name      = ('_' == code) ? extendedPrimitiveTypeName(next()) : primitiveTypeName(code);
+        return type;
+    }
+
+    TypeNode* parseTagType()
+    {
+        const char* keyword = nullptr;
+        switch (next())
+        {
+        case 'T':
+            keyword = "union";
+            break;
+        case 'U':
+            keyword = "struct";
+            break;
+        case 'V':
+            keyword = "class";
+            break;
+        default:
+            // The digit after an enum is the size of its underlying type, which is no longer used.
+            keyword = "enum";
+            next();
+            break;
+        }
+
+        auto type  = newNode(TypeKind::Simple);
+        type->name = hasFlag(UNDECORATE_NO_ECSU) ? parseFullyQualifiedTypeName() : std::string{keyword} + " " + parseFullyQualifiedTypeName();
+        return type;
+    }
+
+    TypeNode* parsePointerType()
+    {
+        auto pointer = newNode(TypeKind::Pointer);
+        if (consume("$$Q"))
+        {
+            pointer->name = "&&";
+        }
+        else if (consume("$$R"))
+        {
+            pointer->name       = "&&";
+            pointer->isVolatile = true;
+        }
+        else
+        {
+            const auto code     = next();
+            const bool isRef    = 'A' == code || 'B' == code;
+            pointer->name       = isRef ? "&" : "*";
+            pointer->isConst    = 'Q' == code || 'S' == code;
+            pointer->isVolatile = 'B' == code || 'R' == code || 'S' == code;
+        }
+        parsePointerExtQualifiers(*pointer);
+
+        if (consume('6'))
+        {
+            pointer->target = parseFunctionType(false);
+            return pointer;
+        }
+        if (consume('8'))
+        {
+            pointer->name   = parseFullyQualifiedTypeName() + "::" + pointer->name;
+            pointer->target = parseFunctionType(true);
+            return pointer;
+        }
+
+        // The qualifiers of the pointee, which is a data member of a class from 'Q' to 'T'.
+        auto qualifiers        = next();
+        const bool isMemberPtr = 'Q' <= qualifiers && qualifiers <= 'T';
+        if (isMemberPtr)
+        {
+            qualifiers    = static_cast<char>(qualifiers - 'Q' + 'A');
+            pointer->name = parseFullyQualifiedTypeName() + "::" + pointer->name;
+        }
+        if (qualifiers < 'A' || 'D' < qualifiers)
+        {
+            throw UndecorateError{};
+        }
+        pointer->target             = parseType(QualifierMode::Drop);
+        pointer->target->isConst    = pointer->target->isConst || 0 != ((qualifiers - 'A') & 1);
+        pointer->target->isVolatile = pointer->target->isVolatile || 0 != ((qualifiers - 'A') & 2);
+        return pointer;
+    }
+
+    TypeNode* parseArrayType()
+    {
+        expect('Y');
+        const auto dimensionCount = parseNumber();
+        if (0 >= dimensionCount)
+        {
+            throw UndecorateError{};
+        }
+        auto array = newNode(TypeKind::Array);
+        for (LONGLONG i = 0; i < dimensionCount; ++i)
+        {
+            array->dimensions.push_back(parseNumber());
+        }
+        array->target = parseType(QualifierMode::Drop);
+        return array;
+    }
+
+    TypeNode* parseFunctionType(bool hasThisQualifiers)
+    {
+        auto function = newNode(TypeKind::Function);
+        if (hasThisQualifiers)
+        {
+            parsePointerExtQualifiers(*function);
+            if (consume('G'))
+            {
+                function->refQualifier = "&";
+            }
+            else if (consume('H'))
+            {
+                function->refQualifier = "&&";
+            }
+            parseQualifiers(function->isConst, function->isVolatile);
+        }
+        function->callingConvention = parseCallingConvention();
+        // Structors return nothing.
+        if (!consume('@'))
+        {
+            function->target = parseType(QualifierMode::Result);
+        }
+        parseParameters(*function);
+        if (consume("_E"))
+        {
+            function->isNoexcept = true;
+        }
+        else
+        {
+            expect('Z');
+        }
+        return function;
+    }
+
+    const char* parseCallingConvention()
+    {
+        switch (next())
+        {
+        case 'A':
+        case 'B':
+            return "__cdecl";
+        case 'C':
+        case 'D':
+            return "__pascal";
+        case 'E':
+        case 'F':
+            return "__thiscall";
+        case 'G':
+        case 'H':
+            return "__stdcall";
+        case 'I':
+        case 'J':
+            return "__fastcall";
+        case 'M':
+        case 'N':
+            return "__clrcall";
+        case 'O':
+        case 'P':
+            return "__eabi";
+        case 'Q':
+            return "__vectorcall";
+        default:
+            throw UndecorateError{};
+        }
+    }
+
+    void parseParameters(TypeNode& function)
+    {
+        if (consume('X'))
+        {
+            return;
+        }
+        for (;;)
+        {
+            if (consume('@'))
+            {
+                return;
+            }
+            if (consume('Z'))
+            {
+                function.isVariadic = true;
+                return;
+            }
+            if (isDigit(peek()))
+            {
+                const auto index = static_cast<size_t>(next() - '0');
+                if (m_backReferences.parameters.size() <= index)
+                {
+                    throw UndecorateError{};
+                }
+                function.parameters.push_back(m_backReferences.parameters[index]);
+                continue;
+            }
+
+            // Parameters decorated with more than one character can be referred back to.
+            const auto start     = m_cur;
+            const auto parameter = parseType(QualifierMode::Drop);
+            if (1 < m_cur - start && MAX_BACK_REFERENCES > m_backReferences.parameters.size())
+            {
+                m_backReferences.parameters.push_back(parameter);
+            }
+            function.parameters.push_back(parameter);
+        }
+    }
+
+    std::string render(const TypeNode& type, const std::string& declarator) const
+    {
+        switch (type.kind)
+        {
+        case TypeKind::Simple:
+        {
+            auto text = type.name;
+            appendWord(text, type.isConst ? "const" : "");
+            appendWord(text, type.isVolatile ? "volatile" : "");
+            appendWord(text, declarator);
+            return text;
+        }
+        case TypeKind::Pointer:
+        {
+            auto pointer = type.name;
+            appendWord(pointer, type.isPtr64 ? ptr64Keyword() : "");
+            appendWord(pointer, type.isRestrict ? msKeyword("__restrict") : "");
+            appendWord(pointer, type.isUnaligned ? msKeyword("__unaligned") : "");
+            appendWord(pointer, type.isConst ? "const" : "");
+            appendWord(pointer, type.isVolatile ? "volatile" : "");
+            appendWord(pointer, declarator);
+
+            const auto& target = *type.target;
+            if (TypeKind::Function == target.kind)
+            {
+                // The calling convention of a pointer to function goes with the pointer: "void (__cdecl*)(int)".
+                auto callingConvention = msKeyword(target.callingConvention);
+                if (!callingConvention.empty() && std::string::npos != type.name.find("::"))
+                {
+                    callingConvention += ' ';
+                }
+                return renderFunction(target, "(" + callingConvention + pointer + ")", false);
+            }
+            if (TypeKind::Array == target.kind)
+            {
+                return render(target, "(" + pointer + ")");
+            }
+            return render(target, pointer);
+        }
+        case TypeKind::Function:
+            return renderFunction(type, declarator, true);
+        case TypeKind::Array:
+        {
+            auto text = declarator;
+            for (const auto dimension : type.dimensions)
+            {
+                text += "[" + std::to_string(dimension) + "]";
+            }
+            return render(*type.target, text);
+        }
+        default:
+            throw UndecorateError{};
+        }
+    }
+
+    std::string renderParameters(const TypeNode& function) const
+    {
+        std::string parameters{};
+        for (const auto parameter : function.parameters)
+        {
+            parameters += parameters.empty() ? "" : ",";
+            parameters += render(*parameter, {});
+        }
+        if (function.isVariadic)
+        {
+            parameters += parameters.empty() ? "..." : ",...";
+        }
+        return parameters.empty() ? "void" : parameters;
+    }
+
+    /// @brief The qualifiers of `this`, which follow the parameters: "(void)const __ptr64".
+    std::string renderThisQualifiers(const TypeNode& function) const
+    {
+        if (0 != (m_flags & UNDECORATE_NO_THISTYPE))
+        {
+            return {};
+        }
+        std::string qualifiers{};
+        appendWord(qualifiers, function.isConst ? "const" : "");
+        appendWord(qualifiers, function.isVolatile ? "volatile" : "");
+        std::string keywords{};
+        appendWord(keywords, function.isPtr64 ? ptr64Keyword() : "");
+        appendWord(keywords, function.isRestrict ? msKeyword("__restrict") : "");
+        appendWord(keywords, function.isUnaligned ? msKeyword("__unaligned") : "");
+        appendWord(keywords, (nullptr != function.refQualifier) ? function.refQualifier : "");
+        return keywords.empty() ? qualifiers : qualifiers + " " + keywords;
+    }
+
+    std::string renderFunction(const TypeNode& function, const std::string& declarator, bool withCallingConvention) const
+    {
+        std::string text{};
+        if (withCallingConvention)
+        {
+            appendWord(text, msKeyword(function.callingConvention));
+        }
+        appendWord(text, declarator);
+        text += "(" + renderParameters(function) + ")" + renderThisQualifiers(function);
+        if (function.isNoexcept && !hasFlag(UNDECORATE_NO_THROW_SIGNATURES))
+        {
+            text += " noexcept";
+        }
+        return (nullptr != function.target) ? render(*function.target, text) : text;
+    }
+
+    std::string undecorateSymbol()
+    {
+        const NestingGuard nesting{m_depth};
+        // Hashed names (of overly long names) and string literals have nothing to undecorate.
+        if (consume("??@"))
+        {
+            throw UndecorateError{};
+        }
+        if (consume("??_C@_"))
+        {
+            m_cur = m_end;
+            return "`string'";
+        }
+        if (consume("??_R0"))
+        {
+            const auto type = render(*parseType(QualifierMode::Result), {});
+            expect('@');
+            expect('8');
+            return type + " `RTTI Type Descriptor'";
+        }
+
+        expect('?');
+        auto identifier   = parseUnqualifiedSymbolName();
+        const auto scopes = parseScopes();
+        if (Identifier::Kind::Constructor == identifier.kind || Identifier::Kind::Destructor == identifier.kind)
+        {
+            // Structors are named after their class, which is the innermost scope, unless they are templates themselves.
+            if (scopes.empty())
+            {
+                throw UndecorateError{};
+            }
+            const auto& className = scopes.front();
+            identifier.name       = identifier.templateArguments.empty() ? className : className.substr(0, className.find('<'));
+            if (Identifier::Kind::Destructor == identifier.kind)
+            {
+                identifier.name.insert(0, 1, '~');
+            }
+        }
+
+        const auto code = next();
+        if ('0' <= code && code <= '4')
+        {
+            return undecorateVariable(code, joinScopes(scopes, renderIdentifier(identifier)));
+        }
+        if ('6' == code || '7' == code)
+        {
+            return undecorateSpecialTable(joinScopes(scopes, renderIdentifier(identifier)));
+        }
+        if ('8' == code)
+        {
+            return joinScopes(scopes, renderIdentifier(identifier));
+        }
+        return undecorateFunction(code, scopes, identifier);
+    }
+
+    std::string undecorateVariable(char storageClass, const std::string& name)
+    {
+        static const char* const ACCESS_SPECIFIERS[] = {"private: ", "protected: ", "public: "};
+
+        const auto type = parseType(QualifierMode::Drop);
+        // The qualifiers of a pointer variable are those of its pointee, as those of the pointer come with its type.
+        bool isConst    = false;
+        bool isVolatile = false;
+        if (TypeKind::Pointer == type->kind)
+        {
+            parsePointerExtQualifiers(*type);
+            parseQualifiers(isConst, isVolatile);
+            type->target->isConst    = type->target->isConst || isConst;
+            type->target->isVolatile = type->target->isVolatile || isVolatile;
+        }
+        else
+        {
+            parseQualifiers(type->isConst, type->isVolatile);
+        }
+
+        if (hasFlag(UNDECORATE_NAME_ONLY))
+        {
+            return name;
+        }
+        std::string text{};
+        if ('3' > storageClass)
+        {
+            text += hasFlag(UNDECORATE_NO_ACCESS_SPECIFIERS) ? "" : ACCESS_SPECIFIERS[storageClass - '0'];
+            text += hasFlag(UNDECORATE_NO_MEMBER_TYPE) ? "" : "static ";
+        }
+        return text + render(*type, name);
+    }
+
+    /// @brief A virtual function table or virtual base table, and the bases it is for: "const Foo::`vftable'{for `Bar'}".
+    std::string undecorateSpecialTable(const std::string& name)
+    {
+        bool isConst    = false;
+        bool isVolatile = false;
+        parseQualifiers(isConst, isVolatile);
+        std::string targets{};
+        while (!consume('@'))
+        {
+            targets += targets.empty() ? "{for `" : "s `";
+            targets += parseFullyQualifiedTypeName() + "'";
+        }
+        if (!targets.empty())
+        {
+            targets += "}";
+        }
+
+        if (hasFlag(UNDECORATE_NAME_ONLY))
+        {
+            return name;
+        }
+        std::string text{};
+        appendWord(text, isConst ? "const" : "");
+        appendWord(text, isVolatile ? "volatile" : "");
+        appendWord(text, name);
+        return text + targets;
+    }
+
+    std::string undecorateFunction(char functionClass, const std::vector<std::string>& scopes, const Identifier& identifier)
+    {
+        static const char* const ACCESS_SPECIFIERS[] = {"private: ", "protected: ", "public: "};
+
+        if (functionClass < 'A' || 'Z' < functionClass)
+        {
+            throw UndecorateError{};
+        }
+        // From 'A' to 'X', groups of 8 codes per access: member, static, virtual and thunk, near and far.
+        const bool isGlobal   = 'Y' <= functionClass;
+        const auto classIndex = (functionClass - 'A') / 2 % 4;
+        const bool isStatic   = !isGlobal && 1 == classIndex;
+        const bool isVirtual  = !isGlobal && 2 <= classIndex;
+        const bool isThunk    = !isGlobal && 3 == classIndex;
+        LONGLONG adjustor     = 0;
+        if (isThunk)
+        {
+            adjustor = parseNumber();
+        }
+        const auto function = parseFunctionType(!isGlobal && !isStatic);
+
+        // Conversion operators are named after the type they return.
+        auto name = renderIdentifier(identifier);
+        if (Identifier::Kind::Conversion == identifier.kind)
+        {
+            if (nullptr == function->target)
+            {
+                throw UndecorateError{};
+            }
+            name = "operator " + render(*function->target, {}) + identifier.templateArguments;
+        }
+        auto qualifiedName = joinScopes(scopes, name);
+        if (hasFlag(UNDECORATE_NAME_ONLY))
+        {
+            return qualifiedName;
+        }
+
+        std::string text = isThunk ? "[thunk]:" : "";
+        if (!isGlobal)
+        {
+            text += hasFlag(UNDECORATE_NO_ACCESS_SPECIFIERS) ? "" : ACCESS_SPECIFIERS[(functionClass - 'A') / 8];
+            if (!hasFlag(UNDECORATE_NO_MEMBER_TYPE))
+            {
+                text += isStatic ? "static " : (isVirtual ? "virtual " : "");
+            }
+        }
+        if (isThunk)
+        {
+            qualifiedName += "`adjustor{" + std::to_string(adjustor) + "}' ";
+        }
+
+        std::string declarator{};
+        if (!hasFlag(UNDECORATE_NO_ALLOCATION_LANGUAGE))
+        {
+            appendWord(declarator, msKeyword(function->callingConvention));
+        }
+        appendWord(declarator, qualifiedName);
+        declarator += "(" + renderParameters(*function) + ")" + renderThisQualifiers(*function);
+        if (function->isNoexcept && !hasFlag(UNDECORATE_NO_THROW_SIGNATURES))
+        {
+            declarator += " noexcept";
+        }
+
+        const bool hasReturnType = nullptr != function->target && Identifier::Kind::Conversion != identifier.kind;
+        return text + ((hasReturnType && !hasFlag(UNDECORATE_NO_FUNCTION_RETURNS)) ? render(*function->target, declarator) : declarator);
+    }
+
+    const char* m_cur;
+    const char* const m_end;
+    const uint32_t m_flags;
+    /// @brief The number of types, template instantiations and symbols being parsed (see `NestingGuard`).
+    size_t m_depth{0};
+    BackReferences m_backReferences{};
+    std::deque<TypeNode> m_nodes{};
+};
+
+void undecorateBatches(const std::vector<std::string>& decoratedNames, uint32_t flags, std::atomic<size_t>& nextIndex,
+                       std::vector<std::string>& undecoratedNames)
+{
+    for (auto batchBegin = nextIndex.fetch_add(UNDECORATE_BATCH_SIZE); batchBegin < decoratedNames.size();
+         batchBegin      = nextIndex.fetch_add(UNDECORATE_BATCH_SIZE))
+    {
+        const auto batchEnd = (std::min)(batchBegin + UNDECORATE_BATCH_SIZE, decoratedNames.size());
+        for (auto i = batchBegin; i < batchEnd; ++i)
+        {
+            undecoratedNames[i] = undecorateName(decoratedNames[i], flags);
+        }
+    }
+}
+}  // namespace
+
+std::string undecorateName(const std::string& decoratedName, uint32_t flags)
+{
+    const bool isTypeOnly = UNDECORATE_TYPE_ONLY == (flags & UNDECORATE_TYPE_ONLY);
+    if (!isTypeOnly && (decoratedName.size() < 2 || '?' != decoratedName.front()))
+    {
+        return decoratedName;
+    }
+    try
+    {
+        Undecorator undecorator{decoratedName, flags};
+        return isTypeOnly ? undecorator.undecorateType() : undecorator.undecorate();
+    }
+    catch (const UndecorateError&)
+    {
+        return decoratedName;
+    }
+}
+
+std::wstring undecorateName(const std::wstring& decoratedName, uint32_t flags)
+{
+    if (decoratedName.empty() || (L'?' != decoratedName.front() && UNDECORATE_TYPE_ONLY != (flags & UNDECORATE_TYPE_ONLY)))
+    {
+        return decoratedName;
+    }
+    return convertToWstring(undecorateName(toUtf8(decoratedName), flags));
+}
+
+std::vector<std::string> undecorateNames(const std::vector<std::string>& decoratedNames, uint32_t flags, size_t workerCount)
+{
+    if (0 == workerCount)
+    {
+        workerCount = (std::max)(1u, std::thread::hardware_concurrency());
+    }
+    // Each worker fills its own batches of the results, so the workers share nothing but the counter of the next batch.
+    workerCount = (std::min)(workerCount, (decoratedNames.size() + UNDECORATE_BATCH_SIZE - 1) / UNDECORATE_BATCH_SIZE);
+
+    std::vector<std::string> undecoratedNames(decoratedNames.size());
+    std::atomic<size_t> nextIndex{0};
+    if (1 >= workerCount)
+    {
+        undecorateBatches(decoratedNames, flags, nextIndex, undecoratedNames);
+        return undecoratedNames;
+    }
+
+    std::vector<std::future<void>> workers{};
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        workers.push_back(std::async(std::launch::async, undecorateBatches, std::cref(decoratedNames), flags, std::ref(nextIndex),
+                                     std::ref(undecoratedNames)));
+    }
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+    return undecoratedNames;
+}
+
+}  // namespace dia
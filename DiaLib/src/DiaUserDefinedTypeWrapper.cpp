@@ -35,6 +35,8 @@ std::set<UserDefinedType> UserDefinedType::queryForwardDependencies() const
     return types;
 }
 
+StructLayout UserDefinedType::analyzeLayout(ULONGLONG cacheLineSize) const { return StructLayoutAnalyzer{cacheLineSize}.analyze(*this); }
+
 Data UserDefinedType::getMember(const AnyString& memberName) const
 {
     auto dataMembers = enumerate<Data>(*this, SymTagData, memberName.c_str());
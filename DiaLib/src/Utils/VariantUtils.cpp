@@ -0,0 +1,35 @@
+#include "pch.h"
+//
+#include "VariantUtils.h"
+
+namespace dia
+{
+LONGLONG variantToInteger(const VARIANT& variantValue)
+{
+    switch (variantValue.vt)
+    {
+    case VT_I1:
+        return variantValue.cVal;
+    case VT_I2:
+        return variantValue.iVal;
+    case VT_I4:
+        return variantValue.lVal;
+    case VT_I8:
+        return variantValue.llVal;
+    case VT_INT:
+        return variantValue.intVal;
+    case VT_UI1:
+        return variantValue.bVal;
+    case VT_UI2:
+        return variantValue.uiVal;
+    case VT_UI4:
+        return variantValue.ulVal;
+    case VT_UI8:
+        return static_cast<LONGLONG>(variantValue.ullVal);
+    case VT_UINT:
+        return variantValue.uintVal;
+    default:
+        return 0;
+    }
+}
+}  // namespace dia
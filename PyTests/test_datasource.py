@@ -1,7 +1,11 @@
 import os
+import re
+import shutil
+import struct
+import subprocess
 import pytest
-from common import get_test_resources_dir
-from pydia import DataSource, Error
+from common import get_adhoc_test_file, get_test_resources_dir, get_ntdll_datasource
+from pydia import DataSource, Error, Minidump, dump_symbols, generate_header, undecorate_many
 
 
 def test_create_empty_datasource():
@@ -18,3 +22,183 @@ def test_create_datasource_from_pdb():
     file_path = os.path.join(get_test_resources_dir(), "ntdll.dll")
     data_source = DataSource(file_path)
     assert data_source
+
+
+def test_generate_header_orders_types_by_dependency():
+    header = generate_header(get_ntdll_datasource(), worker_count=2)
+    assert header.startswith("#pragma once")
+    # _LDR_DATA_TABLE_ENTRY contains a _LIST_ENTRY by value, so it must come after it.
+    list_entry = header.index("struct _LIST_ENTRY\n{")
+    ldr_data_table_entry = header.index("struct _LDR_DATA_TABLE_ENTRY\n{")
+    assert list_entry < ldr_data_table_entry
+    assert header == generate_header(get_ntdll_datasource(), worker_count=1)
+
+
+def test_generate_header_declares_arrays_of_unnamed_types(tmp_path):
+    data_source = DataSource(get_adhoc_test_file("unnamed_types.pdb"))
+    header = generate_header(data_source, worker_count=1)
+    assert "<unnamed" not in header
+    assert header.count("{") == header.count("}")
+    # Nothing uses them, so the aliases of the COM basic types are left out.
+    assert "HRESULT" not in header
+    assert "BSTR" not in header
+
+    grid = header[header.index("struct Grid_s\n{") :]
+    grid = grid[: grid.index("\n};\n")]
+    assert re.search(r"struct\n\s*\{[^{}]*int16_t X;[^{}]*\} Cells\[4\]\[2\];", grid)
+    assert re.search(r"enum : \w+\n\s*\{[^{}]*GridLarge = 1,[^{}]*\} Sizes\[3\];", grid)
+    # The template type is declared under an identifier made from its name.
+    box = re.search(r"^struct (Box_s_\w+)\n\{", header, re.MULTILINE)
+    assert box
+    assert f" {box.group(1)} Box;" in grid
+    assert "void* Indirect;" in header
+
+    compiler = shutil.which("cl")
+    if compiler is None:
+        pytest.skip("The generated header is only compiled when cl is on the path.")
+    (tmp_path / "unnamed_types.h").write_text(header, encoding="utf-8")
+    source_path = tmp_path / "unnamed_types.cpp"
+    source_path.write_text(
+        '#include "unnamed_types.h"\n'
+        f"static_assert(sizeof(windows::Grid_s) == {data_source.get_struct('Grid_s').length});\n",
+        encoding="utf-8",
+    )
+    subprocess.run([compiler, "/nologo", "/std:c++17", "/Zs", str(source_path)], cwd=tmp_path, check=True)
+
+
+def test_type_dependency_graph_orders_by_value_dependencies():
+    data_source = get_ntdll_datasource()
+    graph = data_source.get_type_dependency_graph()
+    node_count = graph.get_node_count()
+    assert node_count > 0
+
+    order = graph.get_topological_order()
+    assert sorted(order) == list(range(node_count))
+    positions = {node: position for position, node in enumerate(order)}
+    for node in range(node_count):
+        for dependency, by_pointer in graph.get_dependencies(node):
+            assert by_pointer or positions[dependency] < positions[node]
+
+    # _LDR_DATA_TABLE_ENTRY contains a _LIST_ENTRY by value.
+    list_entry = graph.get_node(data_source.get_struct("_LIST_ENTRY"))
+    ldr_data_table_entry = graph.get_node(data_source.get_struct("_LDR_DATA_TABLE_ENTRY"))
+    assert graph.get_symbol(list_entry).get_name() == "_LIST_ENTRY"
+    assert (list_entry, False) in graph.get_dependencies(ldr_data_table_entry)
+
+
+def test_type_dependency_graph_cycles():
+    graph = get_ntdll_datasource().get_type_dependency_graph()
+    for dependent, dependency in graph.suggest_cycle_breaks():
+        assert (dependency, True) in graph.get_dependencies(dependent)
+    # Types commonly point to each other, but their by-value dependencies can never form a cycle.
+    assert graph.get_strongly_connected_components()
+    assert graph.get_strongly_connected_components(include_pointer_edges=False) == []
+
+
+def test_type_dependency_graph_rejects_invalid_nodes():
+    data_source = get_ntdll_datasource()
+    graph = data_source.get_type_dependency_graph()
+    with pytest.raises(IndexError):
+        graph.get_symbol(graph.get_node_count())
+    with pytest.raises(IndexError):
+        graph.get_dependencies(-1)
+    with pytest.raises(TypeError):
+        graph.get_node("_LIST_ENTRY")
+
+
+def test_dump_symbols_is_identical_across_worker_counts():
+    dump = dump_symbols(get_ntdll_datasource(), worker_count=2)
+    assert "\nUDT struct `_LIST_ENTRY` length=" in dump
+    assert "\n  Data member `Flink` type=_LIST_ENTRY* offset=0x0\n" in dump
+    assert dump.index("\nTypes\n") < dump.index("\nCompilands\n")
+    assert dump == dump_symbols(get_ntdll_datasource(), worker_count=1)
+
+
+def write_minidump(path, memory_address, memory):
+    # A header, a stream directory, an AMD64 system info stream and a memory64 list holding a single range.
+    directory_rva = 32
+    memory64_list_rva = directory_rva + 2 * 12
+    system_info_rva = memory64_list_rva + 32
+    memory_rva = system_info_rva + 56
+    header = struct.pack("<IIIIIIQ", 0x504D444D, 0xA793, 2, directory_rva, 0, 0, 0)
+    directory = struct.pack("<III", 9, 32, memory64_list_rva) + struct.pack("<III", 7, 56, system_info_rva)
+    memory64_list = struct.pack("<QQQQ", 1, memory_rva, memory_address, len(memory))
+    system_info = struct.pack("<H", 9).ljust(56, b"\0")
+    path.write_bytes(header + directory + memory64_list + system_info + memory)
+
+
+def test_minidump_struct_views(tmp_path):
+    dump_path = tmp_path / "list.dmp"
+    # Two _LIST_ENTRYs pointing at each other.
+    write_minidump(dump_path, 0x10000, struct.pack("<QQQQ", 0x10010, 0x10010, 0x10000, 0x10000))
+    dump = Minidump(str(dump_path))
+    assert dump.get_pointer_size() == 8
+    assert dump.get_memory_ranges() == [(0x10000, 32)]
+    assert dump.get_modules() == []
+
+    list_entry = get_ntdll_datasource().get_struct("_LIST_ENTRY")
+    assert dump.decode_struct(list_entry, 0x10000) == {"Flink": 0x10010, "Blink": 0x10010}
+    assert dump.follow_pointer(list_entry, 0x10010, "Blink") == 0x10000
+    assert bytes(dump.view_struct(list_entry, 0x10010)) == struct.pack("<QQ", 0x10000, 0x10000)
+    assert list_entry.decode(dump.view(0x10000, 16), as_tuple=True) == (0x10010, 0x10010)
+    assert dump.read(0x10018, 16) == struct.pack("<Q", 0x10000)
+    assert dump.get_cached_page_count() == 1
+    with pytest.raises(Error):
+        dump.read_pointer(0x20000)
+    with pytest.raises(Error):
+        dump.view(0x10018, 16)
+    # Reloading would unmap the file under the views.
+    view = dump.view(0x10000, 16)
+    with pytest.raises(Error):
+        dump.__init__(str(dump_path))
+    assert bytes(view) == struct.pack("<QQ", 0x10010, 0x10010)
+
+
+def test_walk_list_and_tree(tmp_path):
+    data_source = get_ntdll_datasource()
+    ldr_entry = data_source.get_struct("_LDR_DATA_TABLE_ENTRY")
+    link_offset = ldr_entry.resolve_field_path("InMemoryOrderLinks")["offset"]
+    head, first, second = 0x10000, 0x10100, 0x10400
+    memory = bytearray(0x1000)
+
+    def link(address, flink):
+        memory[address - 0x10000 : address - 0x10000 + 8] = struct.pack("<Q", flink)
+
+    link(head, first + link_offset)
+    link(first + link_offset, second + link_offset)
+    link(second + link_offset, head)
+    # A balanced node whose children are leaves.
+    root, left, right = 0x10800, 0x10900, 0x10A00
+    memory[root - 0x10000 : root - 0x10000 + 16] = struct.pack("<QQ", left, right)
+
+    dump_path = tmp_path / "links.dmp"
+    write_minidump(dump_path, 0x10000, bytes(memory))
+    dump = Minidump(str(dump_path))
+    assert ldr_entry.walk_list(dump, head, "InMemoryOrderLinks") == ([first, second], "Completed")
+    assert ldr_entry.walk_list(dump.read, head, "InMemoryOrderLinks", max_nodes=1) == ([first], "NodeLimitReached")
+    records, status = ldr_entry.walk_list(dump, head, "InMemoryOrderLinks", decode=True)
+    assert status == "Completed"
+    assert records[0]["InMemoryOrderLinks"]["Flink"] == second + link_offset
+
+    balanced_node = data_source.get_struct("_RTL_BALANCED_NODE")
+    assert balanced_node.walk_tree(dump, root, "") == ([left, root, right], "Completed")
+
+    # The memory may also be read by any callable, here one over a corrupt list looping back to its first entry.
+    link(second + link_offset, first + link_offset)
+    read_memory = lambda address, size: bytes(memory[address - 0x10000 : address - 0x10000 + size])
+    assert ldr_entry.walk_list(read_memory, head, "InMemoryOrderLinks") == ([first, second], "CycleDetected")
+
+
+def test_undecorate_many():
+    names = ["?get@Foo@@QEBAHXZ", "??0Foo@@QEAA@XZ", "RtlAllocateHeap"] * 1000
+    undecorated = undecorate_many(names, worker_count=4)
+    assert undecorated[:3] == [
+        "public: int __cdecl Foo::get(void)const __ptr64",
+        "public: __cdecl Foo::Foo(void) __ptr64",
+        "RtlAllocateHeap",
+    ]
+    assert undecorated == undecorate_many(names, worker_count=1)
+    UNDNAME_NAME_ONLY = 0x1000
+    assert undecorate_many(["?get@Foo@@QEBAHXZ"], UNDNAME_NAME_ONLY) == ["Foo::get"]
+    with pytest.raises(TypeError):
+        undecorate_many([b"?get@Foo@@QEBAHXZ"])
@@ -1,3 +1,8 @@
+import ast
+import pickle
+import struct
+import subprocess
+import sys
 from time import sleep
 import pytest
 from common import get_adhoc_test_file, get_ntdll_datasource
@@ -18,6 +23,14 @@ def test_hashing():
     assert hash(struct)
 
 
+def test_hash_is_stable_and_usable_as_key():
+    data_source = get_ntdll_datasource()
+    struct = data_source.get_struct("_KUSER_SHARED_DATA")
+    assert hash(struct) == hash(struct)
+    assert hash(struct) == hash(data_source.get_struct("_KUSER_SHARED_DATA"))
+    assert {struct: 1}[data_source.get_struct("_KUSER_SHARED_DATA")] == 1
+
+
 def test_check_simple_struct_member_attributes():
     """
     // This is the original code of this struct
@@ -47,6 +60,56 @@ def test_check_simple_struct_member_attributes():
         assert member.get_location_type() == pydia.LocationType.ThisRel
 
 
+def test_struct_member_properties():
+    data_source = DataSource(get_adhoc_test_file("my_structs.pdb"))
+    assert data_source
+    struct_name = "MyCoolStruct_s"
+    struct = data_source.get_struct(struct_name)
+    assert struct.name == struct.get_name() == struct_name
+    assert struct.length == struct.get_length()
+    assert struct.sym_index_id == struct.get_sym_index_id()
+    for member in struct.enumerate_members():
+        assert member.name == member.get_name()
+        assert member.offset == member.get_offset()
+        assert member.type_id == member.get_type_id()
+        assert member.type == member.get_type()
+        assert member.data_kind == pydia.DataKind.Member
+
+
+def test_properties_follow_method_availability():
+    data_source = DataSource(get_adhoc_test_file("my_structs.pdb"))
+    assert data_source
+    struct = data_source.get_struct("MyCoolStruct_s")
+    member = next(iter(struct.enumerate_members()))
+    for symbol in (struct, member):
+        for name in ("length", "offset", "type", "data_kind", "udt_kind", "value", "class_parent_id"):
+            assert hasattr(type(symbol), name) == hasattr(type(symbol), "get_" + name)
+
+
+def test_member_names_are_shared():
+    data_source = get_ntdll_datasource()
+    unicode_length = next(iter(data_source.get_struct("_UNICODE_STRING").enumerate_members()))
+    ansi_length = next(iter(data_source.get_struct("_STRING").enumerate_members()))
+    assert unicode_length.name == "Length"
+    # Names are interned per data source, so both members hand out the very same str.
+    assert unicode_length.name is ansi_length.name
+    assert unicode_length.name is unicode_length.get_name()
+
+
+def test_struct_member_to_dict():
+    data_source = DataSource(get_adhoc_test_file("my_structs.pdb"))
+    assert data_source
+    struct = data_source.get_struct("MyCoolStruct_s")
+    for member in struct.enumerate_members():
+        member_dict = member.to_dict()
+        assert member_dict["name"] == member.get_name()
+        assert member_dict["offset"] == member.get_offset()
+        assert member_dict["data_kind"] == pydia.DataKind.Member
+        assert member.to_dict(fields=["name", "type_id"]) == {"name": member.get_name(), "type_id": member.get_type_id()}
+    with pytest.raises(ValueError):
+        struct.to_dict(fields=["no_such_property"])
+
+
 def test_check_volatile_struct_member_attributes():
     """
     // This is the original code of this struct
@@ -102,6 +165,97 @@ def test_packed_struct():
     assert struct.is_packed() == True  # Why does this fail???
 
 
+def test_struct_layout():
+    data_source = DataSource(get_adhoc_test_file("my_structs.pdb"))
+    # MyCoolStruct_s: uint8_t, uint16_t, uint32_t, uint64_t, so a byte of padding follows MyUint8.
+    layout = data_source.get_struct("MyCoolStruct_s").analyze_layout()
+    assert layout["size"] == 16
+    assert layout["alignment"] == 8
+    assert [field["offset"] for field in layout["fields"]] == [0, 2, 4, 8]
+    assert layout["holes"] == [(1, 1)]
+    assert layout["tail_padding"] == 0
+    assert layout["minimum_size"] == 16
+    # MyPackedStruct_s is packed to 1, so it has no padding at all.
+    packed_layout = data_source.get_struct("MyPackedStruct_s").analyze_layout()
+    assert packed_layout["alignment"] == 1
+    assert packed_layout["natural_alignment"] == 8
+    assert packed_layout["padding"] == 0
+    assert packed_layout["minimum_size"] == packed_layout["size"]
+
+
+def test_struct_layouts_are_identical_across_worker_counts():
+    layouts = pydia.analyze_struct_layouts(get_ntdll_datasource(), worker_count=2)
+    assert layouts
+    assert layouts == pydia.analyze_struct_layouts(get_ntdll_datasource(), worker_count=1)
+    assert all(layout["minimum_size"] <= layout["size"] for layout in layouts)
+
+
+def test_resolve_field_path():
+    data_source = get_ntdll_datasource()
+    ldr_entry = data_source.get_struct("_LDR_DATA_TABLE_ENTRY")
+    blink = ldr_entry.resolve_field_path("InLoadOrderLinks.Blink")
+    flink = ldr_entry.resolve_field_path("InLoadOrderLinks.Flink")
+    assert blink["offset"] == flink["offset"] + flink["size"]
+    assert not blink["is_bitfield"]
+    # PackagedBinary is a bitfield of a struct nested in an anonymous union.
+    packaged_binary = ldr_entry.resolve_field_path("PackagedBinary")
+    assert packaged_binary["is_bitfield"]
+    assert packaged_binary["bit_length"] == 1
+    shared_data = data_source.get_struct("_KUSER_SHARED_DATA")
+    features = shared_data.resolve_field_path("ProcessorFeatures")
+    assert shared_data.resolve_field_path("ProcessorFeatures[3]")["offset"] == features["offset"] + 3
+    with pytest.raises(pydia.Error):
+        shared_data.resolve_field_path("NoSuchMember")
+
+
+def test_decode():
+    data_source = DataSource(get_adhoc_test_file("my_structs.pdb"))
+    my_cool_struct = data_source.get_struct("MyCoolStruct_s")
+    # MyCoolStruct_s: uint8_t, (padding), uint16_t, uint32_t, uint64_t.
+    instances = b"".join(struct.pack("<BxHIQ", i, 2 * i, 3 * i, 4 * i) for i in range(3))
+    assert my_cool_struct.decode(instances) == {"MyUint8": 0, "MyUint16": 0, "MyUint32": 0, "MyUint64": 0}
+    assert my_cool_struct.decode(instances, offset=16, as_tuple=True) == (1, 2, 3, 4)
+    decoded = my_cool_struct.decode_many(memoryview(instances))
+    assert [instance["MyUint64"] for instance in decoded] == [0, 4, 8]
+    assert len(my_cool_struct.decode_many(instances, count=2, offset=16)) == 2
+    with pytest.raises(ValueError):
+        my_cool_struct.decode(instances, offset=40)
+
+
+def test_to_numpy_dtype():
+    np = pytest.importorskip("numpy")
+    data_source = DataSource(get_adhoc_test_file("my_structs.pdb"))
+    my_cool_struct = data_source.get_struct("MyCoolStruct_s")
+    dtype = my_cool_struct.to_numpy_dtype()
+    assert dtype.itemsize == 16
+    assert dtype.names == ("MyUint8", "MyUint16", "MyUint32", "MyUint64")
+    assert [dtype.fields[name][1] for name in dtype.names] == [0, 2, 4, 8]
+    assert dtype.metadata["bitfields"] == {}
+    instances = b"".join(struct.pack("<BxHIQ", i, 2 * i, 3 * i, 4 * i) for i in range(3))
+    view = np.frombuffer(instances, dtype=dtype)
+    assert view["MyUint64"].tolist() == [0, 4, 8]
+    assert view[1]["MyUint16"] == 2
+
+    packed_struct = data_source.get_struct("MyPackedStruct_s")
+    assert packed_struct.to_numpy_dtype().itemsize == 18
+
+
+def test_extract_bitfields():
+    data_source = get_ntdll_datasource()
+    peb = data_source.get_struct("_PEB")
+    bit_field = peb.resolve_field_path("BitField")["offset"]
+    instances = bytearray(peb.length * 4)
+    for i in range(4):
+        instances[i * peb.length + bit_field] = i
+    fields = peb.extract_bitfields(instances, ["ImageUsesLargePages", "IsProtectedProcess", "BitField"])
+    assert fields["ImageUsesLargePages"].tolist() == [0, 1, 0, 1]
+    assert fields["IsProtectedProcess"].tolist() == [0, 0, 1, 1]
+    assert fields["BitField"].tolist() == [0, 1, 2, 3]
+    assert peb.extract_bitfields(instances, ["IsProtectedProcess"], count=2, offset=peb.length)["IsProtectedProcess"].tolist() == [0, 1]
+    with pytest.raises(pydia.Error):
+        peb.extract_bitfields(instances, ["Ldr.NoSuchMember"])
+
+
 def test_structs_are_equal():
     data_source_a = DataSource(get_adhoc_test_file("equal_structs_a.pdb"))
     data_source_b = DataSource(get_adhoc_test_file("equal_structs_b.pdb"))
@@ -125,3 +279,53 @@ def test_enum_members_and_hash():
     struct = data_source.get_struct("_KUSER_SHARED_DATA")
     for member in list(struct.enumerate_members()):
         assert hash(member), "Hash expected to not be 0 !"
+
+
+def test_repr():
+    data_source = get_ntdll_datasource()
+    for struct_name in ["_KUSER_SHARED_DATA", "_PEB"]:
+        struct = data_source.get_struct(struct_name)
+        for symbol in [struct] + list(struct.enumerate_members()):
+            text = repr(symbol)
+            assert text.startswith(f"pydia.{type(symbol).__name__}(R'")
+            assert text.endswith(f"', 0x{hash(symbol) & 0xFFFFFFFFFFFFFFFF:016X})")
+            assert "ntdll.pdb" in text.lower()
+
+
+def test_pickle_struct_roundtrip():
+    data_source = get_ntdll_datasource()
+    struct = data_source.get_struct("_KUSER_SHARED_DATA")
+    unpickled_struct = pickle.loads(pickle.dumps(struct))
+    assert type(unpickled_struct) is type(struct)
+    assert unpickled_struct.get_name() == struct.get_name()
+
+
+# Unpickles the symbols in reverse order, so the session of the subprocess assigns them different symIndexIds than the one they were pickled from.
+UNPICKLE_IN_REVERSE_ORDER = """
+import pickle, sys
+pickled_symbols = pickle.loads(sys.stdin.buffer.read())
+symbols = [pickle.loads(pickled_symbol) for pickled_symbol in reversed(pickled_symbols)][::-1]
+print(repr([(type(symbol).__name__, symbol.get_name()) for symbol in symbols]))
+"""
+
+
+def test_pickle_roundtrip_in_another_session():
+    data_source = get_ntdll_datasource()
+    structs = [data_source.get_struct(name) for name in ["_PEB", "_LIST_ENTRY", "_KUSER_SHARED_DATA"]]
+    symbols = structs + list(structs[0].enumerate_members())[:3]
+    result = subprocess.run(
+        [sys.executable, "-c", UNPICKLE_IN_REVERSE_ORDER],
+        input=pickle.dumps([pickle.dumps(symbol) for symbol in symbols]),
+        capture_output=True,
+        check=True,
+    )
+    expected = [(type(symbol).__name__, symbol.get_name()) for symbol in symbols]
+    assert ast.literal_eval(result.stdout.decode()) == expected
+
+
+def test_pickling_support_is_not_in_to_dict():
+    data_source = get_ntdll_datasource()
+    struct = data_source.get_struct("_KUSER_SHARED_DATA")
+    for symbol in [struct] + list(struct.enumerate_members()):
+        assert "__reduce__" not in symbol.to_dict()
+        assert "reduce" not in symbol.to_dict()
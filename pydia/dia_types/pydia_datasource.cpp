@@ -14,6 +14,7 @@
 #include "pydia_symbol_private.h"
 #include "pydia_trivial_init.h"
 #include "pydia_typedef.h"
+#include "pydia_typegraph.h"
 #include "pydia_udts.h"
 
 // C++ DiaSymbolMaster imports
@@ -35,12 +36,16 @@ static PyObject* PyDiaDataSource_getUserDefinedTypes(PyDiaDataSource* self);
 static PyObject* PyDiaDataSource_getTypedef(PyDiaDataSource* self, PyObject* args);
 static PyObject* PyDiaDataSource_getTypedefs(PyDiaDataSource* self);
 
+static PyObject* PyDiaDataSource_getTypeDependencyGraph(PyDiaDataSource* self);
+
 static void PyDiaDataSource_dealloc(PyDiaDataSource* self)
 {
     if (self->diaDataSource)
     {
         delete self->diaDataSource;
     }
+    Py_CLEAR(self->loadedPdbFile);
+    Py_CLEAR(self->symbolNames);
     Py_TYPE(((PyObject*)((self))))->tp_free((PyObject*)self);
 }
 
@@ -125,6 +130,8 @@ static int PyDiaDataSource_init(PyDiaDataSource* self, PyObject* args, PyObject*
     tempDataSource       = nullptr;
     self->diaGlobalScope = (PyDiaSymbol*)tempGlobalScope;
     tempGlobalScope      = nullptr;
+    Py_CLEAR(self->loadedPdbFile);
+    Py_CLEAR(self->symbolNames);
 
     return 0;
 }
@@ -148,6 +155,9 @@ static PyMethodDef PyDiaDataSource_methods[] = {
 
     {"get_typedef", (PyCFunction)PyDiaDataSource_getTypedef, METH_VARARGS, "Get typedef by name."},
     {"get_typedefs", (PyCFunction)PyDiaDataSource_getTypedefs, METH_NOARGS, "Get all typedefs."},
+
+    {"get_type_dependency_graph", (PyCFunction)PyDiaDataSource_getTypeDependencyGraph, METH_NOARGS,
+     "Build the dependency graph of all the named user defined types, enums and typedefs."},
     {NULL, NULL, 0, NULL},
 };
 
@@ -214,6 +224,8 @@ static PyObject* PyDiaDataSource_loadDataFromPdb(PyDiaDataSource* self, PyObject
         PyErr_SetString(PyDiaInvalidUsageError, e.what());
         return NULL;
     }
+    Py_CLEAR(self->loadedPdbFile);
+    Py_CLEAR(self->symbolNames);
 
     // Return self for method chaining
     Py_INCREF(self);
@@ -353,6 +365,8 @@ static PyObject* PyDiaDataSource_getTypedef(PyDiaDataSource* self, PyObject* arg
 
 static PyObject* PyDiaDataSource_getTypedefs(PyDiaDataSource* self) { return getSymbolsEnumeration(self, self->diaDataSource->getTypedefs()); }
 
+static PyObject* PyDiaDataSource_getTypeDependencyGraph(PyDiaDataSource* self) { return PyDiaTypeDependencyGraph_FromDataSource(self); }
+
 PyDiaDataSource* PyDiaDataSource_FromInitializerList(PyObject* initializerList)
 {
     if (PyObject_IsInstance(initializerList, (PyObject*)&PyDiaDataSource_Type))
@@ -390,3 +404,58 @@ PyDiaDataSource* PyDiaDataSource_FromInitializerList(PyObject* initializerList)
     PyErr_SetString(PyExc_TypeError, "A DataSource object cannot be deduced from the given parameters.");
     return NULL;
 }
+
+PyObject* PyDiaDataSource_getLoadedPdbFile(PyDiaDataSource* self)
+{
+    if (!self->loadedPdbFile)
+    {
+        _ASSERT_EXPR(nullptr != self->diaDataSource, L"Internal data source raw pointer must be initialized!");
+        PYDIA_SAFE_TRY({ self->loadedPdbFile = PyObject_FromWstring(self->diaDataSource->getLoadedPdbFile()); });
+    }
+    return self->loadedPdbFile;
+}
+
+PyObject* PyDiaDataSource_getSymbolName(PyDiaDataSource* self, const dia::Symbol& symbol)
+{
+    _ASSERT_EXPR(nullptr != self->diaDataSource, L"Internal data source raw pointer must be initialized!");
+    dia::StringId nameId{};
+    PYDIA_SAFE_TRY({ nameId = self->diaDataSource->getNameId(symbol); });
+    return PyDiaDataSource_getInternedString(self, nameId);
+}
+
+PyObject* PyDiaDataSource_getInternedString(PyDiaDataSource* self, dia::StringId id)
+{
+    _ASSERT_EXPR(nullptr != self->diaDataSource, L"Internal data source raw pointer must be initialized!");
+    if (!self->symbolNames)
+    {
+        self->symbolNames = PyList_New(0);
+        if (!self->symbolNames)
+        {
+            return NULL;
+        }
+    }
+
+    // String ids are dense and handed out in order, so the list only ever grows by the few ids interned since the last call.
+    while (static_cast<Py_ssize_t>(id) >= PyList_GET_SIZE(self->symbolNames))
+    {
+        if (0 != PyList_Append(self->symbolNames, Py_None))
+        {
+            return NULL;
+        }
+    }
+
+    PyObject* string = PyList_GET_ITEM(self->symbolNames, id);
+    if (Py_None == string)
+    {
+        const auto internedString = self->diaDataSource->getInternedString(id);
+        string                    = PyObject_FromUtf8String(internedString.data, internedString.size);
+        if (!string)
+        {
+            return NULL;
+        }
+        // PyList_SetItem steals the new reference and releases the one to None.
+        PyList_SetItem(self->symbolNames, id, string);
+    }
+    Py_INCREF(string);
+    return string;
+}
@@ -11,8 +11,20 @@ typedef struct
     PyObject_HEAD;
     dia::DataSource* diaDataSource;  // Pointer to the C++ DiaDataSource object
     PyDiaSymbol_s* diaGlobalScope;   // Pointer to the Python Symbol which is the global scope of the data source
+    PyObject* loadedPdbFile;         // Lazily created str of the loaded PDB path, shared by all the symbols of the data source
+    PyObject* symbolNames;           // Lazily created list of the str of each name, indexed by name id (None until a name is first asked for)
 } PyDiaDataSource;
 
 extern PyTypeObject PyDiaDataSource_Type;
 
 PyDiaDataSource* PyDiaDataSource_FromInitializerList(PyObject* initializerList);
+
+// Returns a borrowed reference to the path of the loaded PDB, which is created once per data source.
+PyObject* PyDiaDataSource_getLoadedPdbFile(PyDiaDataSource* self);
+
+// Returns a new reference to the name of a symbol of the data source. Symbols with the same name share the same str object, which is created
+// once per data source.
+PyObject* PyDiaDataSource_getSymbolName(PyDiaDataSource* self, const dia::Symbol& symbol);
+
+// Returns a new reference to a string of the name pool of the data source, which is created once per data source.
+PyObject* PyDiaDataSource_getInternedString(PyDiaDataSource* self, dia::StringId id);
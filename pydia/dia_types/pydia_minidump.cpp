@@ -0,0 +1,463 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+// Python.h must be included before anything else
+#include <objbase.h>
+
+// C pydia imports
+#include "pydia_datasource.h"
+#include "pydia_decode.h"
+#include "pydia_exceptions.h"
+#include "pydia_helper_routines.h"
+#include "pydia_minidump.h"
+#include "pydia_register_classes.h"
+#include "pydia_symbol.h"
+
+// C++ DiaSymbolMaster imports
+#include <DiaMinidump.h>
+#include <algorithm>
+#include <cstring>
+
+static PyObject* PyDiaMinidump_getModules(PyDiaMinidump* self);
+static PyObject* PyDiaMinidump_getMemoryRanges(PyDiaMinidump* self);
+static PyObject* PyDiaMinidump_getPointerSize(PyDiaMinidump* self);
+static PyObject* PyDiaMinidump_getCachedPageCount(PyDiaMinidump* self);
+static PyObject* PyDiaMinidump_findModule(PyDiaMinidump* self, PyObject* args);
+static PyObject* PyDiaMinidump_read(PyDiaMinidump* self, PyObject* args);
+static PyObject* PyDiaMinidump_readPointer(PyDiaMinidump* self, PyObject* args);
+static PyObject* PyDiaMinidump_view(PyDiaMinidump* self, PyObject* args);
+static PyObject* PyDiaMinidump_viewStruct(PyDiaMinidump* self, PyObject* args);
+static PyObject* PyDiaMinidump_decodeStruct(PyDiaMinidump* self, PyObject* args, PyObject* kwargs);
+static PyObject* PyDiaMinidump_followPointer(PyDiaMinidump* self, PyObject* args);
+
+static void PyDiaMinidump_dealloc(PyDiaMinidump* self)
+{
+    if (self->diaMinidumpReader)
+    {
+        delete self->diaMinidumpReader;
+    }
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int PyDiaMinidump_init(PyDiaMinidump* self, PyObject* args, PyObject* kwds)
+{
+    PyObject* pyFilePath = nullptr;
+    if (!PyArg_ParseTuple(args, "U", &pyFilePath))
+    {
+        return -1;
+    }
+    const std::wstring filePath(PyObjectToAnyString(pyFilePath));
+    if (PyErr_Occurred())
+    {
+        return -1;
+    }
+
+    // Views of the dump point straight into its mapping, so it must not be replaced while they are alive.
+    if (self->diaMinidumpReader)
+    {
+        PyErr_SetString(PyDiaInvalidUsageError, "The minidump is already loaded.");
+        return -1;
+    }
+
+    dia::MinidumpReader* reader = nullptr;
+    PYDIA_SAFE_TRY_EXCEPT({ reader = new dia::MinidumpReader(filePath); },
+                          {
+                              PyErr_SetString(PyDiaError, e.what());
+                              return -1;
+                          });
+    self->diaMinidumpReader = reader;
+    return 0;
+}
+
+static int PyDiaMinidump_getBuffer(PyDiaMinidump* self, Py_buffer* view, int flags)
+{
+    if (!self->diaMinidumpReader)
+    {
+        PyErr_SetString(PyExc_BufferError, "The minidump is not loaded.");
+        view->obj = NULL;
+        return -1;
+    }
+    const auto reader = self->diaMinidumpReader;
+    return PyBuffer_FillInfo(view, (PyObject*)self, const_cast<uint8_t*>(reader->getFileData()), static_cast<Py_ssize_t>(reader->getFileSize()), 1,
+                             flags);
+}
+
+static PyBufferProcs PyDiaMinidump_bufferProcs = {
+    (getbufferproc)PyDiaMinidump_getBuffer, /* bf_getbuffer */
+    0,                                      /* bf_releasebuffer */
+};
+
+static PyMethodDef PyDiaMinidump_methods[] = {
+    {"get_modules", (PyCFunction)PyDiaMinidump_getModules, METH_NOARGS, "Get the modules of the dumped process, as dicts."},
+    {"get_memory_ranges", (PyCFunction)PyDiaMinidump_getMemoryRanges, METH_NOARGS, "Get the (address, size) ranges of the dumped memory."},
+    {"get_pointer_size", (PyCFunction)PyDiaMinidump_getPointerSize, METH_NOARGS, "Get the size of a pointer of the dumped process."},
+    {"get_cached_page_count", (PyCFunction)PyDiaMinidump_getCachedPageCount, METH_NOARGS,
+     "Get the number of pages whose translation to the dump file is cached."},
+    {"find_module", (PyCFunction)PyDiaMinidump_findModule, METH_VARARGS,
+     "find_module(key)\n"
+     "Find a module by an address within it, by its name or path, or by the DataSource of its PDB. Returns None if there is no such module."},
+    {"read", (PyCFunction)PyDiaMinidump_read, METH_VARARGS,
+     "read(address, size)\n"
+     "Copy bytes of the dumped memory, up to the first byte which is not in the dump."},
+    {"read_pointer", (PyCFunction)PyDiaMinidump_readPointer, METH_VARARGS, "read_pointer(address)\nRead a pointer of the dumped process."},
+    {"view", (PyCFunction)PyDiaMinidump_view, METH_VARARGS,
+     "view(address, size)\n"
+     "Get a read-only memoryview of bytes of the dumped memory, without copying them."},
+    {"view_struct", (PyCFunction)PyDiaMinidump_viewStruct, METH_VARARGS,
+     "view_struct(udt, address)\n"
+     "Get a read-only memoryview of an instance of a UDT in the dumped memory, e.g. for Udt.decode or numpy.frombuffer with Udt.to_numpy_dtype."},
+    {"decode_struct", (PyCFunction)PyDiaMinidump_decodeStruct, METH_VARARGS | METH_KEYWORDS,
+     "decode_struct(udt, address, as_tuple=False)\n"
+     "Decode an instance of a UDT in the dumped memory (see Udt.decode)."},
+    {"follow_pointer", (PyCFunction)PyDiaMinidump_followPointer, METH_VARARGS,
+     "follow_pointer(udt, address, path)\n"
+     "Read the pointer a field path of a UDT leads to (see Udt.resolve_field_path), from an instance at address."},
+    {NULL, NULL, 0, NULL}  // Sentinel
+};
+
+PyTypeObject PyDiaMinidump_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0) "pydia.Minidump", /* tp_name */
+    sizeof(PyDiaMinidump),                           /* tp_basicsize */
+    0,                                               /* tp_itemsize */
+    (destructor)PyDiaMinidump_dealloc,               /* tp_dealloc */
+    0,                                               /* tp_print */
+    0,                                               /* tp_getattr */
+    0,                                               /* tp_setattr */
+    0,                                               /* tp_as_async */
+    0,                                               /* tp_repr */
+    0,                                               /* tp_as_number */
+    0,                                               /* tp_as_sequence */
+    0,                                               /* tp_as_mapping */
+    0,                                               /* tp_hash  */
+    0,                                               /* tp_call */
+    0,                                               /* tp_str */
+    0,                                               /* tp_getattro */
+    0,                                               /* tp_setattro */
+    &PyDiaMinidump_bufferProcs,                      /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                              /* tp_flags */
+    "Minidump of a process",                         /* tp_doc */
+    0,                                               /* tp_traverse */
+    0,                                               /* tp_clear */
+    0,                                               /* tp_richcompare */
+    0,                                               /* tp_weaklistoffset */
+    0,                                               /* tp_iter */
+    0,                                               /* tp_iternext */
+    PyDiaMinidump_methods,                           /* tp_methods */
+    0,                                               /* tp_members */
+    0,                                               /* tp_getset */
+    0,                                               /* tp_base */
+    0,                                               /* tp_dict */
+    0,                                               /* tp_descr_get */
+    0,                                               /* tp_descr_set */
+    0,                                               /* tp_dictoffset */
+    (initproc)PyDiaMinidump_init,                    /* tp_init */
+    0,                                               /* tp_alloc */
+    PyType_GenericNew,                               /* tp_new */
+};
+
+static PyObject* registerMinidumpPyClasses(PyObject* module)
+{
+    if (PyType_Ready(&PyDiaMinidump_Type) < 0)
+    {
+        return NULL;
+    }
+    Py_INCREF(&PyDiaMinidump_Type);
+    PyModule_AddObject(module, "Minidump", (PyObject*)&PyDiaMinidump_Type);
+    return module;
+}
+REGISTER_PYCLASS_REGISTRATION_FUNCTION(registerMinidumpPyClasses)
+
+static bool checkLoaded(PyDiaMinidump* self)
+{
+    if (!self->diaMinidumpReader)
+    {
+        PyErr_SetString(PyDiaError, "The minidump is not loaded.");
+        return false;
+    }
+    return true;
+}
+
+static PyObject* PyObject_FromMinidumpModule(const dia::MinidumpModule& module)
+{
+    // The GUID is given as its 16 raw bytes, like in the pickled symbols.
+    PyObject* path = PyUnicode_FromWideChar(module.path.c_str(), static_cast<Py_ssize_t>(module.path.size()));
+    return Py_BuildValue("{s:N,s:K,s:k,s:k,s:N,s:y#,s:k}", "path", path, "base_address", module.baseAddress, "size", module.size,
+                         "time_date_stamp", module.timeDateStamp, "has_pdb_signature", PyBool_FromLong(module.hasPdbSignature), "pdb_guid",
+                         reinterpret_cast<const char*>(&module.pdbGuid), static_cast<Py_ssize_t>(sizeof(module.pdbGuid)), "pdb_age",
+                         module.pdbAge);
+}
+
+// Returns a new reference to a slice of a memoryview of the whole dump file, which keeps the dump alive.
+static PyObject* getFileSlice(PyDiaMinidump* self, const dia::MemoryView& view)
+{
+    if (view.empty())
+    {
+        PyErr_SetString(PyDiaError, "The memory is not in the minidump.");
+        return NULL;
+    }
+    const auto fileOffset = static_cast<Py_ssize_t>(view.data - self->diaMinidumpReader->getFileData());
+    PyObject* sliceStart  = PyLong_FromSsize_t(fileOffset);
+    PyObject* sliceStop   = PyLong_FromSsize_t(fileOffset + static_cast<Py_ssize_t>(view.size));
+    PyObject* slice       = (sliceStart && sliceStop) ? PySlice_New(sliceStart, sliceStop, NULL) : NULL;
+    PyObject* fileView    = slice ? PyMemoryView_FromObject((PyObject*)self) : NULL;
+    PyObject* memoryView  = fileView ? PyObject_GetItem(fileView, slice) : NULL;
+    Py_XDECREF(fileView);
+    Py_XDECREF(slice);
+    Py_XDECREF(sliceStop);
+    Py_XDECREF(sliceStart);
+    return memoryView;
+}
+
+static PyObject* PyDiaMinidump_getModules(PyDiaMinidump* self)
+{
+    if (!checkLoaded(self))
+    {
+        return NULL;
+    }
+    const auto& modules = self->diaMinidumpReader->getModules();
+    PyObject* pyModules = PyList_New(static_cast<Py_ssize_t>(modules.size()));
+    for (size_t i = 0; pyModules && i < modules.size(); ++i)
+    {
+        PyObject* pyModule = PyObject_FromMinidumpModule(modules[i]);
+        if (!pyModule)
+        {
+            Py_CLEAR(pyModules);
+            break;
+        }
+        PyList_SET_ITEM(pyModules, static_cast<Py_ssize_t>(i), pyModule);
+    }
+    return pyModules;
+}
+
+static PyObject* PyDiaMinidump_getMemoryRanges(PyDiaMinidump* self)
+{
+    if (!checkLoaded(self))
+    {
+        return NULL;
+    }
+    const auto& ranges = self->diaMinidumpReader->getMemoryRanges();
+    PyObject* pyRanges = PyList_New(static_cast<Py_ssize_t>(ranges.size()));
+    for (size_t i = 0; pyRanges && i < ranges.size(); ++i)
+    {
+        PyObject* pyRange = Py_BuildValue("(KK)", ranges[i].address, ranges[i].size);
+        if (!pyRange)
+        {
+            Py_CLEAR(pyRanges);
+            break;
+        }
+        PyList_SET_ITEM(pyRanges, static_cast<Py_ssize_t>(i), pyRange);
+    }
+    return pyRanges;
+}
+
+static PyObject* PyDiaMinidump_getPointerSize(PyDiaMinidump* self)
+{
+    return checkLoaded(self) ? PyLong_FromSize_t(self->diaMinidumpReader->getPointerSize()) : NULL;
+}
+
+static PyObject* PyDiaMinidump_getCachedPageCount(PyDiaMinidump* self)
+{
+    return checkLoaded(self) ? PyLong_FromSize_t(self->diaMinidumpReader->getCachedPageCount()) : NULL;
+}
+
+static PyObject* PyDiaMinidump_findModule(PyDiaMinidump* self, PyObject* args)
+{
+    PyObject* key = nullptr;
+    if (!PyArg_ParseTuple(args, "O", &key) || !checkLoaded(self))
+    {
+        return NULL;
+    }
+
+    const dia::MinidumpModule* module = nullptr;
+    if (PyLong_Check(key))
+    {
+        const auto address = PyLong_AsUnsignedLongLong(key);
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+        module = self->diaMinidumpReader->findModule(address);
+    }
+    else if (PyUnicode_Check(key))
+    {
+        const std::wstring name(PyObjectToAnyString(key));
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+        module = self->diaMinidumpReader->findModule(name);
+    }
+    else if (PyObject_TypeCheck(key, &PyDiaDataSource_Type))
+    {
+        PYDIA_SAFE_TRY({ module = self->diaMinidumpReader->findModule(*reinterpret_cast<PyDiaDataSource*>(key)->diaDataSource); });
+    }
+    else
+    {
+        PyErr_SetString(PyExc_TypeError, "A module is found by an address, a name or a DataSource.");
+        return NULL;
+    }
+
+    if (!module)
+    {
+        Py_RETURN_NONE;
+    }
+    return PyObject_FromMinidumpModule(*module);
+}
+
+static PyObject* PyDiaMinidump_read(PyDiaMinidump* self, PyObject* args)
+{
+    unsigned long long address = 0;
+    Py_ssize_t size            = 0;
+    if (!PyArg_ParseTuple(args, "Kn", &address, &size) || !checkLoaded(self))
+    {
+        return NULL;
+    }
+    if (size < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "size must not be negative.");
+        return NULL;
+    }
+
+    PyObject* bytes = PyBytes_FromStringAndSize(NULL, size);
+    if (!bytes)
+    {
+        return NULL;
+    }
+    const auto copied = self->diaMinidumpReader->read(address, PyBytes_AS_STRING(bytes), static_cast<size_t>(size));
+    if (static_cast<Py_ssize_t>(copied) != size && 0 != _PyBytes_Resize(&bytes, static_cast<Py_ssize_t>(copied)))
+    {
+        return NULL;
+    }
+    return bytes;
+}
+
+static PyObject* PyDiaMinidump_readPointer(PyDiaMinidump* self, PyObject* args)
+{
+    unsigned long long address = 0;
+    if (!PyArg_ParseTuple(args, "K", &address) || !checkLoaded(self))
+    {
+        return NULL;
+    }
+    PYDIA_SAFE_TRY({ return PyLong_FromUnsignedLongLong(self->diaMinidumpReader->readPointer(address)); });
+    Py_UNREACHABLE();
+}
+
+static PyObject* PyDiaMinidump_view(PyDiaMinidump* self, PyObject* args)
+{
+    unsigned long long address = 0;
+    Py_ssize_t size            = 0;
+    if (!PyArg_ParseTuple(args, "Kn", &address, &size) || !checkLoaded(self))
+    {
+        return NULL;
+    }
+    if (size < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "size must not be negative.");
+        return NULL;
+    }
+    return getFileSlice(self, self->diaMinidumpReader->getView(address, static_cast<size_t>(size)));
+}
+
+static PyObject* PyDiaMinidump_viewStruct(PyDiaMinidump* self, PyObject* args)
+{
+    PyObject* udt              = nullptr;
+    unsigned long long address = 0;
+    if (!PyArg_ParseTuple(args, "O!K", &PyDiaSymbol_Type, &udt, &address) || !checkLoaded(self))
+    {
+        return NULL;
+    }
+
+    dia::MemoryView view{};
+    PYDIA_SAFE_TRY({ view = self->diaMinidumpReader->getView(*reinterpret_cast<PyDiaSymbol*>(udt)->diaSymbol, address); });
+    return getFileSlice(self, view);
+}
+
+static PyObject* PyDiaMinidump_decodeStruct(PyDiaMinidump* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"udt", "address", "as_tuple", nullptr};
+    PyObject* udt                 = nullptr;
+    unsigned long long address    = 0;
+    int asTuple                   = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!K|p", const_cast<char**>(keywords), &PyDiaSymbol_Type, &udt, &address, &asTuple) ||
+        !checkLoaded(self))
+    {
+        return NULL;
+    }
+
+    const auto pyUdt            = reinterpret_cast<PyDiaSymbol*>(udt);
+    const dia::DecodePlan* plan = nullptr;
+    dia::MemoryView view{};
+    PYDIA_SAFE_TRY({
+        plan = &pyUdt->dataSource->diaDataSource->getDecodePlan(*pyUdt->diaSymbol);
+        view = self->diaMinidumpReader->getView(address, static_cast<size_t>(plan->size));
+    });
+    if (view.empty())
+    {
+        PyErr_SetString(PyDiaError, "The memory is not in the minidump.");
+        return NULL;
+    }
+    return PyDiaDecode_decodeInstance(pyUdt->dataSource, *plan, view.data, 0 != asTuple);
+}
+
+static PyObject* PyDiaMinidump_followPointer(PyDiaMinidump* self, PyObject* args)
+{
+    PyObject* udt              = nullptr;
+    unsigned long long address = 0;
+    PyObject* pyPath           = nullptr;
+    if (!PyArg_ParseTuple(args, "O!KU", &PyDiaSymbol_Type, &udt, &address, &pyPath) || !checkLoaded(self))
+    {
+        return NULL;
+    }
+    const std::wstring path(PyObjectToAnyString(pyPath));
+    if (PyErr_Occurred())
+    {
+        return NULL;
+    }
+
+    const auto pyUdt = reinterpret_cast<PyDiaSymbol*>(udt);
+    PYDIA_SAFE_TRY({
+        return PyLong_FromUnsignedLongLong(
+            self->diaMinidumpReader->followPointer(*pyUdt->dataSource->diaDataSource, *pyUdt->diaSymbol, address, path));
+    });
+    Py_UNREACHABLE();
+}
+
+bool PyDiaMinidump_getMemoryReader(PyObject* memory, dia::MemoryReader& readMemory)
+{
+    if (PyObject_TypeCheck(memory, &PyDiaMinidump_Type))
+    {
+        const auto reader = reinterpret_cast<PyDiaMinidump*>(memory)->diaMinidumpReader;
+        if (!reader)
+        {
+            PyErr_SetString(PyDiaError, "The minidump is not loaded.");
+            return false;
+        }
+        readMemory = [reader](ULONGLONG address, void* buffer, size_t size) { return reader->read(address, buffer, size); };
+        return true;
+    }
+    if (!PyCallable_Check(memory))
+    {
+        PyErr_SetString(PyExc_TypeError, "Memory is read from a Minidump or a callable taking (address, size).");
+        return false;
+    }
+
+    readMemory = [memory](ULONGLONG address, void* buffer, size_t size) -> size_t
+    {
+        if (PyErr_Occurred())
+        {
+            return 0;
+        }
+        PyObject* bytes = PyObject_CallFunction(memory, "Kn", address, static_cast<Py_ssize_t>(size));
+        Py_buffer view{};
+        if (!bytes || 0 != PyObject_GetBuffer(bytes, &view, PyBUF_SIMPLE))
+        {
+            Py_XDECREF(bytes);
+            return 0;
+        }
+        const auto copied = (std::min)(size, static_cast<size_t>(view.len));
+        memcpy(buffer, view.buf, copied);
+        PyBuffer_Release(&view);
+        Py_DECREF(bytes);
+        return copied;
+    };
+    return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <Python.h>
+//
+#include <DiaLinkWalker.h>
+#include <DiaMinidump.h>
+
+// Define the Python DiaMinidump object.
+// It exposes the whole mapped dump file through the buffer protocol, so views of the dumped memory are slices of a memoryview of it, which keep
+// the dump alive and never copy its bytes.
+typedef struct
+{
+    PyObject_HEAD;
+    dia::MinidumpReader* diaMinidumpReader;  // Pointer to the C++ MinidumpReader object
+} PyDiaMinidump;
+
+extern PyTypeObject PyDiaMinidump_Type;
+
+// Make a memory reader out of a Minidump, which reads natively, or out of a callable taking (address, size) and returning a bytes-like object
+// (shorter than size if the memory is not available). The object must outlive the reader. If the callable raises, the reader reads nothing
+// from then on, and the exception is left set. Returns false with an exception set if the object is neither.
+bool PyDiaMinidump_getMemoryReader(PyObject* memory, dia::MemoryReader& readMemory);
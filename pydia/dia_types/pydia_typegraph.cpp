@@ -0,0 +1,286 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+// Python.h must be included before anything else
+#include <objbase.h>
+
+// C pydia imports
+#include "pydia_exceptions.h"
+#include "pydia_register_classes.h"
+#include "pydia_symbol.h"
+#include "pydia_typegraph.h"
+
+// C++ DiaSymbolMaster imports
+#include <DiaTypeDependencyGraph.h>
+
+static PyObject* PyDiaTypeDependencyGraph_getNodeCount(PyDiaTypeDependencyGraph* self);
+static PyObject* PyDiaTypeDependencyGraph_getSymbol(PyDiaTypeDependencyGraph* self, PyObject* args);
+static PyObject* PyDiaTypeDependencyGraph_getNode(PyDiaTypeDependencyGraph* self, PyObject* args);
+static PyObject* PyDiaTypeDependencyGraph_getDependencies(PyDiaTypeDependencyGraph* self, PyObject* args);
+static PyObject* PyDiaTypeDependencyGraph_getTopologicalOrder(PyDiaTypeDependencyGraph* self);
+static PyObject* PyDiaTypeDependencyGraph_getStronglyConnectedComponents(PyDiaTypeDependencyGraph* self, PyObject* args, PyObject* kwargs);
+static PyObject* PyDiaTypeDependencyGraph_suggestCycleBreaks(PyDiaTypeDependencyGraph* self);
+
+static void PyDiaTypeDependencyGraph_dealloc(PyDiaTypeDependencyGraph* self)
+{
+    if (self->diaTypeDependencyGraph)
+    {
+        delete self->diaTypeDependencyGraph;
+    }
+    Py_CLEAR(self->dataSource);
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyMethodDef PyDiaTypeDependencyGraph_methods[] = {
+    {"get_node_count", (PyCFunction)PyDiaTypeDependencyGraph_getNodeCount, METH_NOARGS, "Get the number of types in the graph."},
+    {"get_symbol", (PyCFunction)PyDiaTypeDependencyGraph_getSymbol, METH_VARARGS, "Get the type symbol of a node."},
+    {"get_node", (PyCFunction)PyDiaTypeDependencyGraph_getNode, METH_VARARGS, "Get the node of a type symbol."},
+    {"get_dependencies", (PyCFunction)PyDiaTypeDependencyGraph_getDependencies, METH_VARARGS,
+     "Get the (node, by_pointer) pairs of the types a node depends on."},
+    {"get_topological_order", (PyCFunction)PyDiaTypeDependencyGraph_getTopologicalOrder, METH_NOARGS,
+     "Get all the nodes, each after the types it needs the definition of."},
+    {"get_strongly_connected_components", (PyCFunction)PyDiaTypeDependencyGraph_getStronglyConnectedComponents, METH_VARARGS | METH_KEYWORDS,
+     "Get the groups of nodes which depend on each other."},
+    {"suggest_cycle_breaks", (PyCFunction)PyDiaTypeDependencyGraph_suggestCycleBreaks, METH_NOARGS,
+     "Get the (dependent, dependency) by-pointer edges whose dependency should be forward declared to break all the cycles."},
+    {NULL, NULL, 0, NULL}  // Sentinel
+};
+
+PyTypeObject PyDiaTypeDependencyGraph_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0) "pydia.TypeDependencyGraph",   /* tp_name */
+    sizeof(PyDiaTypeDependencyGraph),                             /* tp_basicsize */
+    0,                                                            /* tp_itemsize */
+    (destructor)PyDiaTypeDependencyGraph_dealloc,                 /* tp_dealloc */
+    0,                                                            /* tp_print */
+    0,                                                            /* tp_getattr */
+    0,                                                            /* tp_setattr */
+    0,                                                            /* tp_as_async */
+    0,                                                            /* tp_repr */
+    0,                                                            /* tp_as_number */
+    0,                                                            /* tp_as_sequence */
+    0,                                                            /* tp_as_mapping */
+    0,                                                            /* tp_hash  */
+    0,                                                            /* tp_call */
+    0,                                                            /* tp_str */
+    0,                                                            /* tp_getattro */
+    0,                                                            /* tp_setattro */
+    0,                                                            /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                                           /* tp_flags */
+    "Dependency graph of the types of a DataSource",              /* tp_doc */
+    0,                                                            /* tp_traverse */
+    0,                                                            /* tp_clear */
+    0,                                                            /* tp_richcompare */
+    0,                                                            /* tp_weaklistoffset */
+    0,                                                            /* tp_iter */
+    0,                                                            /* tp_iternext */
+    PyDiaTypeDependencyGraph_methods,                             /* tp_methods */
+    0,                                                            /* tp_members */
+    0,                                                            /* tp_getset */
+    0,                                                            /* tp_base */
+    0,                                                            /* tp_dict */
+    0,                                                            /* tp_descr_get */
+    0,                                                            /* tp_descr_set */
+    0,                                                            /* tp_dictoffset */
+    0 /* This object should never be created by Python callers */, /* tp_init */
+    PyType_GenericAlloc,                                          /* tp_alloc */
+    0,                                                            /* tp_new */
+};
+
+static PyObject* registerTypeDependencyGraphPyClasses(PyObject* module)
+{
+    if (PyType_Ready(&PyDiaTypeDependencyGraph_Type) < 0)
+    {
+        return NULL;
+    }
+    Py_INCREF(&PyDiaTypeDependencyGraph_Type);
+    PyModule_AddObject(module, "TypeDependencyGraph", (PyObject*)&PyDiaTypeDependencyGraph_Type);
+    return module;
+}
+REGISTER_PYCLASS_REGISTRATION_FUNCTION(registerTypeDependencyGraphPyClasses)
+
+PyObject* PyDiaTypeDependencyGraph_FromDataSource(PyDiaDataSource* dataSource)
+{
+    _ASSERT_EXPR(nullptr != dataSource->diaDataSource, L"DataSource must have a valid internal state!");
+    PyDiaTypeDependencyGraph* pyGraph = PyObject_New(PyDiaTypeDependencyGraph, &PyDiaTypeDependencyGraph_Type);
+    if (!pyGraph)
+    {
+        PyErr_SetString(PyExc_MemoryError, "Failed to create TypeDependencyGraph object.");
+        return NULL;
+    }
+    pyGraph->diaTypeDependencyGraph = nullptr;
+    Py_INCREF(dataSource);
+    pyGraph->dataSource = dataSource;
+
+    PYDIA_SAFE_TRY_EXCEPT({ pyGraph->diaTypeDependencyGraph = new dia::TypeDependencyGraph(*dataSource->diaDataSource); },
+                          {
+                              Py_DECREF(pyGraph);
+                              PyErr_SetString(PyDiaError, e.what());
+                              return NULL;
+                          });
+    return reinterpret_cast<PyObject*>(pyGraph);
+}
+
+static PyObject* PyObject_FromNodeList(const std::vector<size_t>& nodes)
+{
+    PyObject* pyNodes = PyList_New(static_cast<Py_ssize_t>(nodes.size()));
+    if (!pyNodes)
+    {
+        return NULL;
+    }
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        PyObject* pyNode = PyLong_FromSize_t(nodes[i]);
+        if (!pyNode)
+        {
+            Py_DECREF(pyNodes);
+            return NULL;
+        }
+        PyList_SET_ITEM(pyNodes, static_cast<Py_ssize_t>(i), pyNode);
+    }
+    return pyNodes;
+}
+
+static PyObject* PyDiaTypeDependencyGraph_getNodeCount(PyDiaTypeDependencyGraph* self)
+{
+    return PyLong_FromSize_t(self->diaTypeDependencyGraph->getNodeCount());
+}
+
+static PyObject* PyDiaTypeDependencyGraph_getSymbol(PyDiaTypeDependencyGraph* self, PyObject* args)
+{
+    Py_ssize_t node = 0;
+    if (!PyArg_ParseTuple(args, "n", &node))
+    {
+        return NULL;
+    }
+    if (0 > node || static_cast<size_t>(node) >= self->diaTypeDependencyGraph->getNodeCount())
+    {
+        PyErr_SetString(PyExc_IndexError, "Node index out of range.");
+        return NULL;
+    }
+
+    PYDIA_SAFE_TRY({
+        auto symbol = self->dataSource->diaDataSource->getSymbolById(self->diaTypeDependencyGraph->getSymIndexId(static_cast<size_t>(node)));
+        return PyDiaSymbol_FromSymbol(std::move(symbol), self->dataSource);
+    });
+    Py_UNREACHABLE();
+}
+
+static PyObject* PyDiaTypeDependencyGraph_getNode(PyDiaTypeDependencyGraph* self, PyObject* args)
+{
+    PyObject* symbol = nullptr;
+    if (!PyArg_ParseTuple(args, "O!", &PyDiaSymbol_Type, &symbol))
+    {
+        return NULL;
+    }
+
+    PYDIA_SAFE_TRY_EXCEPT(
+        {
+            const auto symIndexId = reinterpret_cast<PyDiaSymbol*>(symbol)->diaSymbol->getSymIndexId();
+            return PyLong_FromSize_t(self->diaTypeDependencyGraph->getNode(symIndexId));
+        },
+        {
+            PyErr_SetString(PyExc_ValueError, e.what());
+            return NULL;
+        });
+    Py_UNREACHABLE();
+}
+
+static PyObject* PyDiaTypeDependencyGraph_getDependencies(PyDiaTypeDependencyGraph* self, PyObject* args)
+{
+    Py_ssize_t node = 0;
+    if (!PyArg_ParseTuple(args, "n", &node))
+    {
+        return NULL;
+    }
+    if (0 > node || static_cast<size_t>(node) >= self->diaTypeDependencyGraph->getNodeCount())
+    {
+        PyErr_SetString(PyExc_IndexError, "Node index out of range.");
+        return NULL;
+    }
+
+    const auto dependencies  = self->diaTypeDependencyGraph->getDependencies(static_cast<size_t>(node));
+    PyObject* pyDependencies = PyList_New(static_cast<Py_ssize_t>(dependencies.size()));
+    if (!pyDependencies)
+    {
+        return NULL;
+    }
+    Py_ssize_t i = 0;
+    for (const auto& edge : dependencies)
+    {
+        PyObject* pyEdge = Py_BuildValue("(IO)", static_cast<unsigned int>(edge.target),
+                                         dia::TypeEdgeKind::ByPointer == edge.kind ? Py_True : Py_False);
+        if (!pyEdge)
+        {
+            Py_DECREF(pyDependencies);
+            return NULL;
+        }
+        PyList_SET_ITEM(pyDependencies, i++, pyEdge);
+    }
+    return pyDependencies;
+}
+
+static PyObject* PyDiaTypeDependencyGraph_getTopologicalOrder(PyDiaTypeDependencyGraph* self)
+{
+    PYDIA_SAFE_TRY_EXCEPT({ return PyObject_FromNodeList(self->diaTypeDependencyGraph->getTopologicalOrder()); },
+                          {
+                              PyErr_SetString(PyDiaInvalidUsageError, e.what());
+                              return NULL;
+                          });
+    Py_UNREACHABLE();
+}
+
+static PyObject* PyDiaTypeDependencyGraph_getStronglyConnectedComponents(PyDiaTypeDependencyGraph* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"include_pointer_edges", NULL};
+    int includePointerEdges       = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|p", const_cast<char**>(keywords), &includePointerEdges))
+    {
+        return NULL;
+    }
+
+    std::vector<std::vector<size_t>> components{};
+    PYDIA_SAFE_TRY({ components = self->diaTypeDependencyGraph->getStronglyConnectedComponents(0 != includePointerEdges); });
+
+    PyObject* pyComponents = PyList_New(static_cast<Py_ssize_t>(components.size()));
+    if (!pyComponents)
+    {
+        return NULL;
+    }
+    for (size_t i = 0; i < components.size(); ++i)
+    {
+        PyObject* pyComponent = PyObject_FromNodeList(components[i]);
+        if (!pyComponent)
+        {
+            Py_DECREF(pyComponents);
+            return NULL;
+        }
+        PyList_SET_ITEM(pyComponents, static_cast<Py_ssize_t>(i), pyComponent);
+    }
+    return pyComponents;
+}
+
+static PyObject* PyDiaTypeDependencyGraph_suggestCycleBreaks(PyDiaTypeDependencyGraph* self)
+{
+    std::vector<std::pair<size_t, size_t>> cycleBreaks{};
+    PYDIA_SAFE_TRY_EXCEPT({ cycleBreaks = self->diaTypeDependencyGraph->suggestCycleBreaks(); },
+                          {
+                              PyErr_SetString(PyDiaInvalidUsageError, e.what());
+                              return NULL;
+                          });
+
+    PyObject* pyCycleBreaks = PyList_New(static_cast<Py_ssize_t>(cycleBreaks.size()));
+    if (!pyCycleBreaks)
+    {
+        return NULL;
+    }
+    for (size_t i = 0; i < cycleBreaks.size(); ++i)
+    {
+        PyObject* pyCycleBreak = Py_BuildValue("(nn)", static_cast<Py_ssize_t>(cycleBreaks[i].first), static_cast<Py_ssize_t>(cycleBreaks[i].second));
+        if (!pyCycleBreak)
+        {
+            Py_DECREF(pyCycleBreaks);
+            return NULL;
+        }
+        PyList_SET_ITEM(pyCycleBreaks, static_cast<Py_ssize_t>(i), pyCycleBreak);
+    }
+    return pyCycleBreaks;
+}
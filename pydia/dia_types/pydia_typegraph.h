@@ -0,0 +1,20 @@
+#pragma once
+#include <Python.h>
+//
+#include "dia_types/pydia_datasource.h"
+//
+#include <DiaTypeDependencyGraph.h>
+
+// Define the Python DiaTypeDependencyGraph object.
+// Unlike the symbol types, it is only ever created by DataSource.get_type_dependency_graph(). Nodes are exposed as their dense indices, which
+// get_symbol() turns back into symbols.
+typedef struct
+{
+    PyObject_HEAD;
+    dia::TypeDependencyGraph* diaTypeDependencyGraph;  // Pointer to the C++ TypeDependencyGraph object
+    PyDiaDataSource* dataSource;                       // Ref-counted pointer to the datasource which the graph was built from
+} PyDiaTypeDependencyGraph;
+
+extern PyTypeObject PyDiaTypeDependencyGraph_Type;
+
+PyObject* PyDiaTypeDependencyGraph_FromDataSource(PyDiaDataSource* dataSource);
@@ -37,9 +37,15 @@ static PyMethodDef PyDiaBaseType_methods[] = {
     {NULL, NULL, 0, NULL}  // Sentinel
 };
 
+// Shadows the inherited `name` property, which would otherwise call IDiaSymbol::get_name .
+static PyGetSetDef PyDiaBaseType_getset[] = {
+    {"name", (getter)PyDiaBaseType_getName, NULL, "The C syntax name of the base type.", NULL},
+    {NULL, NULL, NULL, NULL, NULL}  // Sentinel
+};
+
 // Define the Python DiaEnum type object
 
-PYDIA_SYMBOL_TYPE_DEFINITION(BaseType, PyDiaBaseType_methods);
+PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE_ITER_AND_GETSET(BaseType, PyDiaBaseType_methods, &PyDiaSymbol_Type, 0, PyDiaBaseType_getset);
 TRIVIAL_C_TO_PYTHON_SYMBOL_CONVERSION(BaseType);
 
 static PyObject* PyDiaBaseType_getName(const PyDiaBaseType* self)
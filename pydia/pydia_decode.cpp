@@ -0,0 +1,290 @@
+#include "pydia_decode.h"
+#include <string>
+#include <unordered_set>
+
+static PyObject* decodeElement(PyDiaDataSource* dataSource, const dia::DecodeOp& op, const uint8_t* element, bool asTuple)
+{
+    switch (op.kind)
+    {
+    case dia::DecodeKind::Signed:
+        return PyLong_FromLongLong(dia::readSigned(op, element));
+    case dia::DecodeKind::Unsigned:
+        return PyLong_FromUnsignedLongLong(dia::readUnsigned(op, element));
+    case dia::DecodeKind::Float:
+        return PyFloat_FromDouble(dia::readFloat(op, element));
+    case dia::DecodeKind::Bool:
+        return PyBool_FromLong(0 != dia::readUnsigned(op, element));
+    case dia::DecodeKind::Nested:
+        return PyDiaDecode_decodeInstance(dataSource, *op.nested, element, asTuple);
+    default:
+        return PyBytes_FromStringAndSize(reinterpret_cast<const char*>(element), static_cast<Py_ssize_t>(op.width));
+    }
+}
+
+static PyObject* decodeField(PyDiaDataSource* dataSource, const dia::DecodeOp& op, const uint8_t* instance, bool asTuple)
+{
+    const auto field = instance + op.offset;
+    if (!op.isArray())
+    {
+        return decodeElement(dataSource, op, field, asTuple);
+    }
+
+    PyObject* elements = PyList_New(static_cast<Py_ssize_t>(op.count));
+    if (!elements)
+    {
+        return NULL;
+    }
+    for (ULONGLONG i = 0; i < op.count; ++i)
+    {
+        PyObject* element = decodeElement(dataSource, op, field + i * op.stride, asTuple);
+        if (!element)
+        {
+            Py_DECREF(elements);
+            return NULL;
+        }
+        PyList_SET_ITEM(elements, static_cast<Py_ssize_t>(i), element);
+    }
+    return elements;
+}
+
+PyObject* PyDiaDecode_decodeInstance(PyDiaDataSource* dataSource, const dia::DecodePlan& plan, const uint8_t* instance, bool asTuple)
+{
+    if (asTuple)
+    {
+        PyObject* fields = PyTuple_New(static_cast<Py_ssize_t>(plan.ops.size()));
+        if (!fields)
+        {
+            return NULL;
+        }
+        for (size_t i = 0; i < plan.ops.size(); ++i)
+        {
+            PyObject* field = decodeField(dataSource, plan.ops[i], instance, asTuple);
+            if (!field)
+            {
+                Py_DECREF(fields);
+                return NULL;
+            }
+            PyTuple_SET_ITEM(fields, static_cast<Py_ssize_t>(i), field);
+        }
+        return fields;
+    }
+
+    PyObject* fields = PyDict_New();
+    if (!fields)
+    {
+        return NULL;
+    }
+    for (const auto& op : plan.ops)
+    {
+        PyObject* name   = PyDiaDataSource_getInternedString(dataSource, op.nameId);
+        PyObject* field  = name ? decodeField(dataSource, op, instance, asTuple) : NULL;
+        const int result = field ? PyDict_SetItem(fields, name, field) : -1;
+        Py_XDECREF(name);
+        Py_XDECREF(field);
+        if (0 != result)
+        {
+            Py_DECREF(fields);
+            return NULL;
+        }
+    }
+    return fields;
+}
+
+namespace
+{
+std::string getNumpyScalarFormat(const dia::DecodeOp& op)
+{
+    const auto width = std::to_string(op.width);
+    if (op.isBitfield())
+    {
+        return "<u" + width;
+    }
+    switch (op.kind)
+    {
+    case dia::DecodeKind::Signed:
+        return "<i" + width;
+    case dia::DecodeKind::Unsigned:
+        return "<u" + width;
+    case dia::DecodeKind::Float:
+        return "<f" + width;
+    case dia::DecodeKind::Bool:
+        return (1 == op.width) ? "?" : "<u" + width;
+    default:
+        return "V" + width;
+    }
+}
+
+// Accumulates the names, formats and offsets of a dtype spec (the dict form accepted by numpy.dtype), along with the bitfields.
+class NumpyDtypeSpecBuilder
+{
+public:
+    explicit NumpyDtypeSpecBuilder(PyDiaDataSource* dataSource)
+        : m_dataSource{dataSource}
+        , m_names{PyList_New(0)}
+        , m_formats{PyList_New(0)}
+        , m_offsets{PyList_New(0)}
+        , m_bitfields{PyDict_New()}
+    {
+    }
+
+    ~NumpyDtypeSpecBuilder()
+    {
+        Py_XDECREF(m_names);
+        Py_XDECREF(m_formats);
+        Py_XDECREF(m_offsets);
+        Py_XDECREF(m_bitfields);
+    }
+
+    NumpyDtypeSpecBuilder(const NumpyDtypeSpecBuilder&)            = delete;
+    NumpyDtypeSpecBuilder& operator=(const NumpyDtypeSpecBuilder&) = delete;
+
+    // Returns a new reference to the spec of the plan, or NULL with an exception set.
+    PyObject* build(const dia::DecodePlan& plan)
+    {
+        if (!m_names || !m_formats || !m_offsets || !m_bitfields || !appendPlan(plan, 0, std::string{}))
+        {
+            return NULL;
+        }
+        return Py_BuildValue("{s:O,s:O,s:O,s:K}", "names", m_names, "formats", m_formats, "offsets", m_offsets, "itemsize", plan.size);
+    }
+
+    // Borrowed reference to the bitfields of the last built spec.
+    PyObject* getBitfields() const { return m_bitfields; }
+
+private:
+    bool appendPlan(const dia::DecodePlan& plan, ULONGLONG baseOffset, const std::string& prefix)
+    {
+        for (const auto& op : plan.ops)
+        {
+            const auto internedName = m_dataSource->diaDataSource->getInternedString(op.nameId);
+            const auto name         = prefix + std::string(internedName.data, internedName.size);
+            const auto offset       = baseOffset + op.offset;
+            if (op.isBitfield())
+            {
+                // Bitfields are read from their storage unit, which is added once however many bitfields share it.
+                char storageName[64] = {};
+                sprintf_s(storageName, "__bitfields_0x%llx", op.offset);
+                const auto storageFieldName = prefix + storageName;
+                if (!appendField(storageFieldName, PyUnicode_FromString(getNumpyScalarFormat(op).c_str()), offset))
+                {
+                    return false;
+                }
+                PyObject* bitfield = Py_BuildValue("(s#kkN)", storageFieldName.data(), static_cast<Py_ssize_t>(storageFieldName.size()),
+                                                   op.bitPosition, op.bitLength, PyBool_FromLong(dia::DecodeKind::Signed == op.kind));
+                const int result   = bitfield ? PyDict_SetItemString(m_bitfields, name.c_str(), bitfield) : -1;
+                Py_XDECREF(bitfield);
+                if (0 != result)
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            if (dia::DecodeKind::Nested == op.kind && !op.isArray())
+            {
+                if (!appendPlan(*op.nested, offset, name + "."))
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            PyObject* format = NULL;
+            if (dia::DecodeKind::Nested == op.kind)
+            {
+                // The bitfields of the elements are left out of the metadata, but their storage units are part of the nested dtype.
+                NumpyDtypeSpecBuilder elementBuilder{m_dataSource};
+                format = Py_BuildValue("(N(K))", elementBuilder.build(*op.nested), op.count);
+            }
+            else if (dia::DecodeKind::Bytes == op.kind && 0 == op.width)
+            {
+                // Empty (variable sized) arrays take no bytes.
+                continue;
+            }
+            else
+            {
+                const auto scalarFormat = getNumpyScalarFormat(op);
+                const auto fieldFormat  = op.isArray() ? "(" + std::to_string(op.count) + ",)" + scalarFormat : scalarFormat;
+                format                  = PyUnicode_FromString(fieldFormat.c_str());
+            }
+            if (!appendField(name, format, offset))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Steals the reference to the format. Fields whose name was already added (e.g. members of a base class hidden by the derived class) are left
+    // out, as numpy requires unique names.
+    bool appendField(const std::string& name, PyObject* format, ULONGLONG offset)
+    {
+        if (!format)
+        {
+            return false;
+        }
+        if (!m_addedNames.insert(name).second)
+        {
+            Py_DECREF(format);
+            return true;
+        }
+        PyObject* pyName   = PyUnicode_FromStringAndSize(name.data(), static_cast<Py_ssize_t>(name.size()));
+        PyObject* pyOffset = PyLong_FromUnsignedLongLong(offset);
+        const bool added   = pyName && pyOffset && 0 == PyList_Append(m_names, pyName) && 0 == PyList_Append(m_formats, format) &&
+                           0 == PyList_Append(m_offsets, pyOffset);
+        Py_XDECREF(pyName);
+        Py_XDECREF(pyOffset);
+        Py_DECREF(format);
+        return added;
+    }
+
+    PyDiaDataSource* m_dataSource;
+    PyObject* m_names;
+    PyObject* m_formats;
+    PyObject* m_offsets;
+    PyObject* m_bitfields;
+    std::unordered_set<std::string> m_addedNames{};
+};
+}  // namespace
+
+PyObject* PyDiaDecode_toNumpyDtype(PyDiaDataSource* dataSource, const dia::DecodePlan& plan)
+{
+    NumpyDtypeSpecBuilder builder{dataSource};
+    PyObject* spec = builder.build(plan);
+    if (!spec)
+    {
+        return NULL;
+    }
+
+    PyObject* dtype     = NULL;
+    PyObject* numpy     = PyImport_ImportModule("numpy");
+    PyObject* dtypeType = numpy ? PyObject_GetAttrString(numpy, "dtype") : NULL;
+    PyObject* args      = Py_BuildValue("(O)", spec);
+    PyObject* kwargs    = Py_BuildValue("{s:{s:O}}", "metadata", "bitfields", builder.getBitfields());
+    if (dtypeType && args && kwargs)
+    {
+        dtype = PyObject_Call(dtypeType, args, kwargs);
+    }
+    Py_XDECREF(kwargs);
+    Py_XDECREF(args);
+    Py_XDECREF(dtypeType);
+    Py_XDECREF(numpy);
+    Py_DECREF(spec);
+    return dtype;
+}
+
+PyObject* PyDiaDecode_extractIntegers(const dia::DecodeOp& op, const uint8_t* instances, Py_ssize_t count, ULONGLONG stride)
+{
+    PyObject* values = PyByteArray_FromStringAndSize(NULL, count * static_cast<Py_ssize_t>(sizeof(ULONGLONG)));
+    if (!values)
+    {
+        return NULL;
+    }
+    dia::extractIntegers(op, instances, static_cast<size_t>(count), stride, reinterpret_cast<ULONGLONG*>(PyByteArray_AS_STRING(values)));
+
+    PyObject* bytesView  = PyMemoryView_FromObject(values);
+    PyObject* valuesView = bytesView ? PyObject_CallMethod(bytesView, "cast", "s", (dia::DecodeKind::Signed == op.kind) ? "q" : "Q") : NULL;
+    Py_XDECREF(bytesView);
+    Py_DECREF(values);
+    return valuesView;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+//
+#include "dia_types/pydia_datasource.h"
+//
+#include <DiaDecodePlan.h>
+
+// Decodes an instance of a UDT out of its bytes into a new dict of its fields keyed by name, or a new tuple of its fields in the order of the plan.
+// Nested UDTs are decoded the same way, and arrays into lists. The keys are the interned names of the data source. The caller must make sure the
+// buffer holds plan.size bytes. Returns NULL with an exception set on failure.
+PyObject* PyDiaDecode_decodeInstance(PyDiaDataSource* dataSource, const dia::DecodePlan& plan, const uint8_t* instance, bool asTuple);
+
+// Builds a numpy structured dtype with the offsets and itemsize of the plan. Nested UDTs are flattened into fields named `outer.inner`, arrays
+// become subarrays (of a nested dtype for arrays of UDTs), and every storage unit of bitfields becomes a single unsigned field. The bitfields are
+// described in the metadata of the dtype, under "bitfields", as {name: (storage field name, bit position, bit length, is signed)}.
+// numpy is imported when called, so pydia does not depend on it otherwise. Returns NULL with an exception set on failure.
+PyObject* PyDiaDecode_toNumpyDtype(PyDiaDataSource* dataSource, const dia::DecodePlan& plan);
+
+// Extracts an integer field out of `count` instances laid `stride` bytes apart into a new memoryview of 64 bit integers ('q' for signed fields,
+// 'Q' otherwise) over a bytearray, which numpy.frombuffer views without a copy. The operation must be made by dia::makeIntegerDecodeOp, and the
+// caller must make sure the buffer holds the instances. Returns NULL with an exception set on failure.
+PyObject* PyDiaDecode_extractIntegers(const dia::DecodeOp& op, const uint8_t* instances, Py_ssize_t count, ULONGLONG stride);
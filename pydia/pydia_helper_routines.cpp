@@ -1,5 +1,6 @@
 #include "pydia_helper_routines.h"
 #include "pydia_symbol.h"
+#include "pydia_wrapping_types.h"
 #include <DiaSymbol.h>
 #include <datetime.h>     // For PyDateTime_FromDateAndTime
 #include <propvarutil.h>  // For VariantToDouble
@@ -57,6 +58,57 @@ PyObject* PyObject_FromBstrWrapper(const BstrWrapper& bstrWrapper) { return PyUn
 
 PyObject* PyObject_FromWstring(const std::wstring& string) { return PyUnicode_FromWideChar(string.c_str(), string.length()); }
 
+PyObject* PyObject_FromUtf8String(const char* data, size_t size)
+{
+    return PyUnicode_FromStringAndSize(data, static_cast<Py_ssize_t>(size));
+}
+
+PyObject* PyObject_FromStructLayout(const dia::StructLayout& layout)
+{
+    PyObject* fields = PyList_New(static_cast<Py_ssize_t>(layout.fields.size()));
+    PyObject* holes  = PyList_New(static_cast<Py_ssize_t>(layout.holes.size()));
+    if (!fields || !holes)
+    {
+        Py_XDECREF(fields);
+        Py_XDECREF(holes);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < layout.fields.size(); ++i)
+    {
+        const auto& field = layout.fields[i];
+        PyObject* pyField = Py_BuildValue("{s:N,s:N,s:K,s:K,s:K,s:K,s:N}", "kind", PyObject_FromWstring(dia::layoutFieldKindToName(field.kind)),
+                                          "name", PyObject_FromWstring(field.name), "offset", field.offset, "size", field.size, "alignment",
+                                          field.alignment, "used_bits", field.usedBits, "straddles_cache_line",
+                                          PyBool_FromLong(field.straddlesCacheLine));
+        if (!pyField)
+        {
+            Py_DECREF(fields);
+            Py_DECREF(holes);
+            return NULL;
+        }
+        PyList_SET_ITEM(fields, static_cast<Py_ssize_t>(i), pyField);
+    }
+    for (size_t i = 0; i < layout.holes.size(); ++i)
+    {
+        PyObject* pyHole = Py_BuildValue("(KK)", layout.holes[i].offset, layout.holes[i].size);
+        if (!pyHole)
+        {
+            Py_DECREF(fields);
+            Py_DECREF(holes);
+            return NULL;
+        }
+        PyList_SET_ITEM(holes, static_cast<Py_ssize_t>(i), pyHole);
+    }
+
+    // The fields and holes lists are stolen by the dict.
+    return Py_BuildValue("{s:N,s:k,s:N,s:K,s:K,s:K,s:N,s:N,s:K,s:K,s:K,s:K}", "name", PyObject_FromWstring(layout.name), "sym_index_id",
+                         layout.symIndexId, "udt_kind", PyDiaUdtKind_FromUdtKind(layout.udtKind), "size", layout.size, "alignment",
+                         layout.alignment, "natural_alignment", layout.naturalAlignment, "fields", fields, "holes", holes, "tail_padding",
+                         layout.tailPadding, "padding", layout.getPaddingSize(), "unused_bitfield_bits", layout.unusedBitfieldBits, "minimum_size",
+                         layout.minimumSize);
+}
+
 PyObject* PyObject_FromVariant(const VARIANT& variantValue)
 {
     switch (variantValue.vt)
@@ -11,6 +11,7 @@
 // From C++ DiaLib
 #include <AnyString.h>
 #include <BstrWrapper.h>
+#include <DiaStructLayout.h>
 
 // Pydia includes
 #include "pydia_symbol.h"
@@ -21,7 +22,10 @@
 AnyString PyObjectToAnyString(PyObject* obj);
 PyObject* PyObject_FromBstrWrapper(const BstrWrapper& bstrWrapper);
 PyObject* PyObject_FromWstring(const std::wstring& string);
+PyObject* PyObject_FromUtf8String(const char* data, size_t size);
 PyObject* PyObject_FromVariant(const VARIANT& variantValue);
+// Returns a dict describing the layout, with a dict per field and a (offset, size) tuple per hole.
+PyObject* PyObject_FromStructLayout(const dia::StructLayout& layout);
 
 template <typename T>
 PyObject* PyObject_FromSymbolSet(const std::set<T>& s, PyDiaDataSource* dataSource)
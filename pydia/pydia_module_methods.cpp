@@ -1,6 +1,123 @@
 #include "pydia_module_methods.h"
+#include <DiaHeaderGenerator.h>
+#include <DiaStructLayout.h>
+#include <DiaSymbolDump.h>
+#include <DiaUndecorate.h>
 #include <pydia_exceptions.h>
 #include <pydia_helper_routines.h>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+// A DataSource opened to rehydrate unpickled symbols, along with the signature of the PDB it was opened for.
+struct PyDiaRehydrationDataSource
+{
+    PyDiaDataSource* dataSource;  // Strong reference, kept for the lifetime of the process
+    GUID guid;
+    DWORD age;
+};
+}  // namespace
+
+// Process pool workers unpickle many symbols coming from the same few PDBs, and opening a PDB costs far more than a lookup.
+static std::unordered_map<std::wstring, PyDiaRehydrationDataSource>& getRehydrationDataSources()
+{
+    static std::unordered_map<std::wstring, PyDiaRehydrationDataSource> dataSources{};
+    return dataSources;
+}
+
+static PyDiaDataSource* getRehydrationDataSource(PyObject* pdbPath, const GUID& guid, DWORD age)
+{
+    const std::wstring pdbPathKey = PyObjectToAnyString(pdbPath);
+    if (PyErr_Occurred())
+    {
+        return nullptr;
+    }
+
+    auto& dataSources = getRehydrationDataSources();
+    auto cachedSource = dataSources.find(pdbPathKey);
+    if (dataSources.end() == cachedSource)
+    {
+        PyDiaDataSource* dataSource = PyDiaDataSource_FromInitializerList(pdbPath);
+        if (!dataSource)
+        {
+            return nullptr;
+        }
+
+        GUID loadedGuid{};
+        DWORD loadedAge = 0;
+        PYDIA_SAFE_TRY_EXCEPT(
+            {
+                const auto& globalScope = dataSource->diaDataSource->getGlobalScope();
+                loadedGuid              = globalScope.getGuid();
+                loadedAge               = globalScope.getAge();
+            },
+            {
+                Py_DECREF(dataSource);
+                PyErr_SetString(PyDiaError, e.what());
+                return nullptr;
+            });
+        cachedSource = dataSources.emplace(pdbPathKey, PyDiaRehydrationDataSource{dataSource, loadedGuid, loadedAge}).first;
+    }
+
+    if (!IsEqualGUID(guid, cachedSource->second.guid) || age != cachedSource->second.age)
+    {
+        PyErr_Format(PyDiaError, "The PDB at \"%U\" does not match the signature of the pickled symbol.", pdbPath);
+        return nullptr;
+    }
+    return cachedSource->second.dataSource;
+}
+
+PyObject* PyDiaModule_rehydrateSymbol(PyObject* module, PyObject* args)
+{
+    PyObject* pdbPath     = nullptr;
+    const char* guidBytes = nullptr;
+    Py_ssize_t guidLength = 0;
+    unsigned long age     = 0;
+    PyObject* pyPath      = nullptr;
+
+    if (!PyArg_ParseTuple(args, "Uy#kO!", &pdbPath, &guidBytes, &guidLength, &age, &PyTuple_Type, &pyPath))
+    {
+        return nullptr;
+    }
+    if (sizeof(GUID) != guidLength)
+    {
+        PyErr_SetString(PyExc_ValueError, "A pickled symbol's GUID must be exactly 16 bytes long.");
+        return nullptr;
+    }
+
+    dia::SymbolPath path(static_cast<size_t>(PyTuple_GET_SIZE(pyPath)));
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+        unsigned long symTag = 0;
+        Py_ssize_t position  = 0;
+        if (!PyArg_ParseTuple(PyTuple_GET_ITEM(pyPath, static_cast<Py_ssize_t>(i)), "kn", &symTag, &position))
+        {
+            return nullptr;
+        }
+        if (SymTagMax <= symTag || position < 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "A pickled symbol's path is malformed.");
+            return nullptr;
+        }
+        path[i] = dia::SymbolPathStep{static_cast<enum SymTagEnum>(symTag), static_cast<size_t>(position)};
+    }
+
+    GUID guid{};
+    memcpy(&guid, guidBytes, sizeof(guid));
+
+    PyDiaDataSource* dataSource = getRehydrationDataSource(pdbPath, guid, static_cast<DWORD>(age));
+    if (!dataSource)
+    {
+        return nullptr;
+    }
+
+    PYDIA_SAFE_TRY({
+        auto symbol = dataSource->diaDataSource->getSymbolByPath(path);
+        return PyDiaSymbol_FromSymbol(std::move(symbol), dataSource);
+    });
+    Py_UNREACHABLE();
+}
 
 PyObject* PyDiaModule_resolveTypeName(PyObject* module, PyObject* args)
 {
@@ -12,7 +129,219 @@ PyObject* PyDiaModule_resolveTypeName(PyObject* module, PyObject* args)
         return nullptr;  // Parsing failed; raise an appropriate exception
     }
 
-    const auto unsafeCode = [](const PyDiaSymbol* self) -> PyObject* { return PyObject_FromWstring(dia::resolveTypeName(*self->diaSymbol)); };
+    const auto unsafeCode = [](const PyDiaSymbol* self) -> PyObject*
+    {
+        // Go through the data source so that the names stay cached for the whole session.
+        return PyObject_FromWstring(self->dataSource->diaDataSource->resolveTypeName(*self->diaSymbol));
+    };
     PYDIA_SAFE_TRY({ return unsafeCode(reinterpret_cast<PyDiaSymbol*>(symbol)); });
     Py_UNREACHABLE();
 }
+
+PyObject* PyDiaModule_generateHeader(PyObject* module, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"data_source", "output_path", "namespace", "aliases", "worker_count", nullptr};
+    PyObject* dataSource          = nullptr;
+    PyObject* outputPath          = Py_None;
+    PyObject* namespaceName       = nullptr;
+    int emitAliases               = 1;
+    Py_ssize_t workerCount        = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|OUpn", const_cast<char**>(keywords), &PyDiaDataSource_Type, &dataSource, &outputPath,
+                                     &namespaceName, &emitAliases, &workerCount))
+    {
+        return nullptr;
+    }
+    if (workerCount < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "worker_count must not be negative.");
+        return nullptr;
+    }
+
+    dia::HeaderGeneratorOptions options{};
+    if (namespaceName)
+    {
+        options.namespaceName = std::wstring(PyObjectToAnyString(namespaceName));
+    }
+    options.emitAliases = (0 != emitAliases);
+    options.workerCount = static_cast<size_t>(workerCount);
+    std::wstring outputFilePath{};
+    if (Py_None != outputPath)
+    {
+        outputFilePath = std::wstring(PyObjectToAnyString(outputPath));
+    }
+    if (PyErr_Occurred())
+    {
+        return nullptr;
+    }
+
+    const auto& diaDataSource = *reinterpret_cast<PyDiaDataSource*>(dataSource)->diaDataSource;
+    PYDIA_SAFE_TRY({
+        if (outputFilePath.empty())
+        {
+            const auto header = dia::generateHeader(diaDataSource, options);
+            return PyUnicode_DecodeUTF8(header.data(), static_cast<Py_ssize_t>(header.size()), nullptr);
+        }
+        dia::writeHeaderFile(diaDataSource, outputFilePath, options);
+        Py_RETURN_NONE;
+    });
+    Py_UNREACHABLE();
+}
+
+PyObject* PyDiaModule_dumpSymbols(PyObject* module, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"data_source", "output_path", "types", "globals", "publics", "compilands", "sym_index_ids", "worker_count",
+                                     nullptr};
+    PyObject* dataSource          = nullptr;
+    PyObject* outputPath          = Py_None;
+    int includeTypes              = 1;
+    int includeGlobals            = 1;
+    int includePublics            = 1;
+    int includeCompilands         = 1;
+    int includeSymIndexIds        = 0;
+    Py_ssize_t workerCount        = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|Oppppppn", const_cast<char**>(keywords), &PyDiaDataSource_Type, &dataSource, &outputPath,
+                                     &includeTypes, &includeGlobals, &includePublics, &includeCompilands, &includeSymIndexIds, &workerCount))
+    {
+        return nullptr;
+    }
+    if (workerCount < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "worker_count must not be negative.");
+        return nullptr;
+    }
+
+    dia::SymbolDumpOptions options{};
+    options.includeTypes       = (0 != includeTypes);
+    options.includeGlobals     = (0 != includeGlobals);
+    options.includePublics     = (0 != includePublics);
+    options.includeCompilands  = (0 != includeCompilands);
+    options.includeSymIndexIds = (0 != includeSymIndexIds);
+    options.workerCount        = static_cast<size_t>(workerCount);
+    std::wstring outputFilePath{};
+    if (Py_None != outputPath)
+    {
+        outputFilePath = std::wstring(PyObjectToAnyString(outputPath));
+    }
+    if (PyErr_Occurred())
+    {
+        return nullptr;
+    }
+
+    const auto& diaDataSource = *reinterpret_cast<PyDiaDataSource*>(dataSource)->diaDataSource;
+    PYDIA_SAFE_TRY({
+        if (outputFilePath.empty())
+        {
+            const auto dump = dia::dumpSymbolsToString(diaDataSource, options);
+            return PyUnicode_DecodeUTF8(dump.data(), static_cast<Py_ssize_t>(dump.size()), nullptr);
+        }
+        dia::dumpSymbolsToFile(diaDataSource, outputFilePath, options);
+        Py_RETURN_NONE;
+    });
+    Py_UNREACHABLE();
+}
+
+PyObject* PyDiaModule_analyzeStructLayouts(PyObject* module, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[]    = {"data_source", "cache_line_size", "worker_count", nullptr};
+    PyObject* dataSource             = nullptr;
+    unsigned long long cacheLineSize = dia::DEFAULT_CACHE_LINE_SIZE;
+    Py_ssize_t workerCount           = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O!|Kn", const_cast<char**>(keywords), &PyDiaDataSource_Type, &dataSource, &cacheLineSize,
+                                     &workerCount))
+    {
+        return nullptr;
+    }
+    if (workerCount < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "worker_count must not be negative.");
+        return nullptr;
+    }
+
+    dia::StructLayoutReportOptions options{};
+    options.cacheLineSize = cacheLineSize;
+    options.workerCount   = static_cast<size_t>(workerCount);
+
+    const auto& diaDataSource = *reinterpret_cast<PyDiaDataSource*>(dataSource)->diaDataSource;
+    std::vector<dia::StructLayout> layouts{};
+    PYDIA_SAFE_TRY({ layouts = dia::analyzeStructLayouts(diaDataSource, options); });
+
+    PyObject* pyLayouts = PyList_New(static_cast<Py_ssize_t>(layouts.size()));
+    if (!pyLayouts)
+    {
+        return nullptr;
+    }
+    for (size_t i = 0; i < layouts.size(); ++i)
+    {
+        PyObject* pyLayout = PyObject_FromStructLayout(layouts[i]);
+        if (!pyLayout)
+        {
+            Py_DECREF(pyLayouts);
+            return nullptr;
+        }
+        PyList_SET_ITEM(pyLayouts, static_cast<Py_ssize_t>(i), pyLayout);
+    }
+    return pyLayouts;
+}
+
+PyObject* PyDiaModule_undecorateMany(PyObject* module, PyObject* args, PyObject* kwargs)
+{
+    static const char* keywords[] = {"names", "flags", "worker_count", nullptr};
+    PyObject* names               = nullptr;
+    unsigned long flags           = 0;
+    Py_ssize_t workerCount        = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|kn", const_cast<char**>(keywords), &names, &flags, &workerCount))
+    {
+        return nullptr;
+    }
+    if (workerCount < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "worker_count must not be negative.");
+        return nullptr;
+    }
+
+    PyObject* nameSequence = PySequence_Fast(names, "names must be a sequence of str.");
+    if (!nameSequence)
+    {
+        return nullptr;
+    }
+    const auto nameCount = PySequence_Fast_GET_SIZE(nameSequence);
+    std::vector<std::string> decoratedNames{};
+    decoratedNames.reserve(static_cast<size_t>(nameCount));
+    for (Py_ssize_t i = 0; i < nameCount; ++i)
+    {
+        Py_ssize_t size  = 0;
+        const char* name = PyUnicode_AsUTF8AndSize(PySequence_Fast_GET_ITEM(nameSequence, i), &size);
+        if (!name)
+        {
+            Py_DECREF(nameSequence);
+            return nullptr;
+        }
+        decoratedNames.emplace_back(name, static_cast<size_t>(size));
+    }
+    Py_DECREF(nameSequence);
+
+    std::vector<std::string> undecoratedNames{};
+    PYDIA_SAFE_TRY({ undecoratedNames = dia::undecorateNames(decoratedNames, static_cast<uint32_t>(flags), static_cast<size_t>(workerCount)); });
+
+    PyObject* pyNames = PyList_New(nameCount);
+    if (!pyNames)
+    {
+        return nullptr;
+    }
+    for (Py_ssize_t i = 0; i < nameCount; ++i)
+    {
+        const auto& undecoratedName = undecoratedNames[static_cast<size_t>(i)];
+        PyObject* pyName            = PyUnicode_DecodeUTF8(undecoratedName.data(), static_cast<Py_ssize_t>(undecoratedName.size()), nullptr);
+        if (!pyName)
+        {
+            Py_DECREF(pyNames);
+            return nullptr;
+        }
+        PyList_SET_ITEM(pyNames, i, pyName);
+    }
+    return pyNames;
+}
@@ -5,7 +5,38 @@
 #include <pydia_symbol.h>
 
 
+PyObject* PyDiaModule_rehydrateSymbol(PyObject* module, PyObject* args);
+static PyMethodDef PyDiaModuleMethodEntry_rehydrateSymbol = {
+    "_rehydrate_symbol", (PyCFunction)PyDiaModule_rehydrateSymbol, METH_VARARGS,
+    "Internal. Recreates a pickled Symbol from its PDB path, GUID, age and symbol path, reusing this process' DataSource for that PDB."};
+
 PyObject* PyDiaModule_resolveTypeName(PyObject* module, PyObject* args);
 static PyMethodDef PyDiaModuleMethodEntry_resolveTypeName = {
     "resolve_type_name", (PyCFunction)PyDiaModule_resolveTypeName, METH_VARARGS,
     "Returns a C-style name as closely resembling the source code of the Symbol as possible."};
+
+PyObject* PyDiaModule_generateHeader(PyObject* module, PyObject* args, PyObject* kwargs);
+static PyMethodDef PyDiaModuleMethodEntry_generateHeader = {
+    "generate_header", (PyCFunction)PyDiaModule_generateHeader, METH_VARARGS | METH_KEYWORDS,
+    "generate_header(data_source, output_path=None, namespace='windows', aliases=True, worker_count=0)\n"
+    "Generates a C++ header declaring all the named UDTs and enums of the DataSource, in dependency order. Returns the header as a str, or writes "
+    "it to output_path and returns None."};
+
+PyObject* PyDiaModule_dumpSymbols(PyObject* module, PyObject* args, PyObject* kwargs);
+static PyMethodDef PyDiaModuleMethodEntry_dumpSymbols = {
+    "dump_symbols", (PyCFunction)PyDiaModule_dumpSymbols, METH_VARARGS | METH_KEYWORDS,
+    "dump_symbols(data_source, output_path=None, types=True, globals=True, publics=True, compilands=True, sym_index_ids=False, worker_count=0)\n"
+    "Dumps the symbols of the DataSource as text, one line per symbol. Returns the dump as a str, or writes it to output_path and returns None."};
+
+PyObject* PyDiaModule_analyzeStructLayouts(PyObject* module, PyObject* args, PyObject* kwargs);
+static PyMethodDef PyDiaModuleMethodEntry_analyzeStructLayouts = {
+    "analyze_struct_layouts", (PyCFunction)PyDiaModule_analyzeStructLayouts, METH_VARARGS | METH_KEYWORDS,
+    "analyze_struct_layouts(data_source, cache_line_size=64, worker_count=0)\n"
+    "Analyzes the layout of every UDT defined in the DataSource in parallel. Returns a list of dicts like Udt.analyze_layout, in a stable order."};
+
+PyObject* PyDiaModule_undecorateMany(PyObject* module, PyObject* args, PyObject* kwargs);
+static PyMethodDef PyDiaModuleMethodEntry_undecorateMany = {
+    "undecorate_many", (PyCFunction)PyDiaModule_undecorateMany, METH_VARARGS | METH_KEYWORDS,
+    "undecorate_many(names, flags=0, worker_count=0)\n"
+    "Undecorates MSVC decorated names natively and in parallel, without DIA. flags are the UNDNAME_* flags of get_undecorated_name_ex. "
+    "Returns a list of str, in which the names which are not decorated are left as they are."};
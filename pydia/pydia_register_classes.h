@@ -31,6 +31,7 @@ static inline void registerPyClassRegistrationFunction(PyClassRegistrationFuncti
 #define __REGISTER_PYDIA_CLASS(className)                                                                                                            \
     do                                                                                                                                               \
     {                                                                                                                                                \
+        PyDiaSymbol_addAvailableProperties(&(PyDia##className##_Type));                                                                              \
         if (PyType_Ready(&(PyDia##className##_Type)) < 0)                                                                                            \
         {                                                                                                                                            \
             return NULL;                                                                                                                             \
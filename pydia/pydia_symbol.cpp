@@ -17,7 +17,12 @@
 #include <DiaUserDefinedTypeWrapper.h>
 #include <SymbolTypes/DiaArray.h>
 #include <SymbolTypes/DiaBaseType.h>
+#include <list>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #define PYDIA_ASSERT_SYMBOL_POINTERS(__self)                                                                                                         \
     do                                                                                                                                               \
@@ -48,6 +53,7 @@ static PyObject* PyDiaRawSymbol_FromSymbol(dia::Symbol&& symbol, PyDiaDataSource
 
     Py_INCREF(dataSource);
     pySymbol->dataSource = dataSource;
+    pySymbol->cachedHash = PYDIA_SYMBOL_HASH_NOT_CALCULATED;
 
     Py_INCREF(pySymbol);
     return reinterpret_cast<PyObject*>(pySymbol);
@@ -181,24 +187,68 @@ PyObject* PyDiaSymbol_richcompare(PyObject* self, PyObject* other, int op)
 PyObject* PyDiaSymbol_repr(const PyDiaSymbol* self)
 {
     PYDIA_ASSERT_SYMBOL_POINTERS(self);
-    auto safeExecution = [&]() -> PyObject*
+    PyObject* dataSource = PyDiaDataSource_getLoadedPdbFile(self->dataSource);
+    if (!dataSource)
     {
-        _ASSERT_EXPR(nullptr != self->dataSource->diaDataSource, L"Internal data source raw pointer must be initialized!");
-        const std::wstring dataSource = self->dataSource->diaDataSource->getLoadedPdbFile();
-        const auto hash               = self->diaSymbol->calcHash();
+        return NULL;
+    }
 
-        return PyUnicode_FromFormat("%T(R'%U', 0x%.16llX)", self, PyObject_FromWstring(dataSource), hash);
-    };
-    PYDIA_SAFE_TRY({ return safeExecution(); });
+    const auto hash = PyDiaSymbol_hash(reinterpret_cast<PyObject*>(const_cast<PyDiaSymbol*>(self)));
+    if (-1 == hash)
+    {
+        return NULL;
+    }
+    // PyUnicode_FromFormat has no conversion for fixed width upper case hexadecimal, nor (before Python 3.13) for the type of an object.
+    char hashText[sizeof("0x") + 2 * sizeof(hash)]{};
+    snprintf(hashText, sizeof(hashText), "0x%.16llX", static_cast<unsigned long long>(hash));
+    return PyUnicode_FromFormat("%s(R'%U', %s)", Py_TYPE(self)->tp_name, dataSource, hashText);
 }
 
 Py_hash_t PyDiaSymbol_hash(PyObject* self)
 {
     _ASSERT_EXPR(nullptr != self, L"Self must not be null when hashing!");
-    dia::Symbol* selfSymbol = reinterpret_cast<PyDiaSymbol*>(self)->diaSymbol;
+    PyDiaSymbol* pySymbol = reinterpret_cast<PyDiaSymbol*>(self);
+    if (PYDIA_SYMBOL_HASH_NOT_CALCULATED != pySymbol->cachedHash)
+    {
+        return pySymbol->cachedHash;
+    }
+
+    dia::Symbol* selfSymbol = pySymbol->diaSymbol;
     _ASSERT_EXPR(nullptr != selfSymbol, L"Self->diaSymbol must not be null when hashing!");
-    PYDIA_SAFE_TRY_EXCEPT({ return static_cast<Py_hash_t>(selfSymbol->calcHash()); }, { Py_UNREACHABLE(); });
-    Py_UNREACHABLE();
+    Py_hash_t hash            = PYDIA_SYMBOL_HASH_NOT_CALCULATED;
+    bool propertyNotAvailable = false;
+    PYDIA_SAFE_TRY_EXCEPT_NOT_AVAILABLE(
+        {
+            // The data source memoizes the structural hashes, which make up most of the cost of hashing UDTs.
+            hash = static_cast<Py_hash_t>(pySymbol->dataSource->diaDataSource->calcHash(*selfSymbol));
+        },
+        { propertyNotAvailable = true; },
+        {
+            PyErr_SetString(PyDiaError, e.what());
+            return -1;
+        });
+    if (propertyNotAvailable)
+    {
+        // Some symbols lack a property their hash covers. Symbols are equal when their symIndexIds are, which makes it a valid hash too.
+        PYDIA_SAFE_TRY_EXCEPT_NOT_AVAILABLE(
+            { hash = static_cast<Py_hash_t>(dia::getSymIndexId(*selfSymbol)); },
+            {
+                PyErr_SetString(PyDiaPropertyNotAvailableError, e.what());
+                return -1;
+            },
+            {
+                PyErr_SetString(PyDiaError, e.what());
+                return -1;
+            });
+    }
+
+    // Returning -1 would signal an error to Python, which remaps it the same way for its own types.
+    if (PYDIA_SYMBOL_HASH_NOT_CALCULATED == hash)
+    {
+        hash = -2;
+    }
+    pySymbol->cachedHash = hash;
+    return hash;
 }
 
 static void PyDiaSymbol_dealloc(PyDiaSymbol* self)
@@ -222,7 +272,8 @@ static void PyDiaSymbol_dealloc(PyDiaSymbol* self)
 
 static int PyDiaSymbol_init(PyDiaSymbol* self, PyObject* args, PyObject* kwds)
 {
-    self->diaSymbol = new (std::nothrow) dia::Symbol();
+    self->cachedHash = PYDIA_SYMBOL_HASH_NOT_CALCULATED;
+    self->diaSymbol  = new (std::nothrow) dia::Symbol();
     if (!self->diaSymbol)
     {
         PyErr_SetString(PyExc_MemoryError, "Failed to create Symbol object.");
@@ -232,6 +283,8 @@ static int PyDiaSymbol_init(PyDiaSymbol* self, PyObject* args, PyObject* kwds)
 };
 
 static PyMethodDef PyDiaSymbol_methods[] = {
+    PyDiaSymbolMethodEntry_reduce,
+    PyDiaSymbolMethodEntry_toDict,
     PyDiaSymbolMethodEntry_getAccess,
     PyDiaSymbolMethodEntry_getSymIndexId,
     PyDiaSymbolMethodEntry_isScoped,
@@ -430,13 +483,354 @@ static PyMethodDef PyDiaSymbol_methods[] = {
     {NULL, NULL, 0, NULL}  // Sentinel
 };
 
+// Hot attributes exposed as properties (`symbol.name` instead of `symbol.get_name()`).
+// In release mode, each pydia symbol type only gets the properties whose getter method it exposes (see PyDiaSymbol_addAvailableProperties).
+static PyGetSetDef PyDiaSymbol_getset[] = {
+    PYDIA_SYMBOL_PROPERTY("name", getName, "The name of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("sym_index_id", getSymIndexId, "The symbol index ID."),
+    PYDIA_SYMBOL_PROPERTY("sym_tag", getSymTag, "The symbol tag (SymTagEnum) of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("length", getLength, "The length (in bytes or bits) of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("offset", getOffset, "The offset of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("bit_position", getBitPosition, "The bit position of a bitfield member."),
+    PYDIA_SYMBOL_PROPERTY("type", getType, "The type of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("type_id", getTypeId, "The type ID of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("base_type", getBaseType, "The base type of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("count", getCount, "The number of items in a list or array."),
+    PYDIA_SYMBOL_PROPERTY("data_kind", getDataKind, "The data kind of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("location_type", getLocationType, "The location type of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("udt_kind", getUdtKind, "The kind of the user defined type (struct, class, union, ...)."),
+    PYDIA_SYMBOL_PROPERTY("value", getValue, "The value of a constant."),
+    PYDIA_SYMBOL_PROPERTY("class_parent_id", getClassParentId, "The class parent ID of the symbol."),
+    PYDIA_SYMBOL_PROPERTY("lexical_parent_id", getLexicalParentId, "The lexical parent ID of the symbol."),
+    {NULL, NULL, NULL, NULL, NULL}  // Sentinel
+};
+
 #ifdef _DEBUG
 // Allow complete and unmonitored usage of the DiaLib private symbol functions in debug mode.
-PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE(Symbol, PyDiaSymbol_methods, 0);
+PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE_ITER_AND_GETSET(Symbol, PyDiaSymbol_methods, 0, 0, PyDiaSymbol_getset);
 #else
+// Methods which are valid for every symbol type, and are therefore inherited by all of them.
+static PyMethodDef PyDiaSymbol_commonMethods[] = {
+    PyDiaSymbolMethodEntry_reduce,
+    PyDiaSymbolMethodEntry_toDict,
+    {NULL, NULL, 0, NULL}  // Sentinel
+};
+
 // In release mode, users should never directly access DiaLib methods without pydia checking that the type is valid.
-PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE(Symbol, 0, 0);
+// The same goes for the properties, which the derived types get through PyDiaSymbol_addAvailableProperties.
+PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE_ITER_AND_GETSET(Symbol, PyDiaSymbol_commonMethods, 0, 0, 0);
+#endif
+
+static bool PyDiaSymbol_exposesMethod(const PyTypeObject* type, PyCFunction method)
+{
+    for (; nullptr != type; type = type->tp_base)
+    {
+        for (const PyMethodDef* entry = type->tp_methods; nullptr != entry && nullptr != entry->ml_name; ++entry)
+        {
+            if (method == entry->ml_meth)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void PyDiaSymbol_addAvailableProperties(PyTypeObject* type)
+{
+#ifndef _DEBUG
+    bool isDerivedSymbolType = false;
+    for (const PyTypeObject* baseType = type->tp_base; nullptr != baseType; baseType = baseType->tp_base)
+    {
+        isDerivedSymbolType |= (&PyDiaSymbol_Type == baseType);
+    }
+    if (!isDerivedSymbolType)
+    {
+        return;
+    }
+
+    // The tables must outlive the type objects, which live as long as the process.
+    static std::list<std::vector<PyGetSetDef>> availablePropertyTables{};
+    std::vector<PyGetSetDef> properties{};
+    std::unordered_set<std::string> propertyNames{};
+    for (const PyGetSetDef* property = type->tp_getset; nullptr != property && nullptr != property->name; ++property)
+    {
+        // The type's own properties shadow the common ones (e.g. BaseType's name).
+        properties.push_back(*property);
+        propertyNames.insert(property->name);
+    }
+    for (const PyGetSetDef* property = PyDiaSymbol_getset; nullptr != property->name; ++property)
+    {
+        const auto* getterMethod = static_cast<const PyMethodDef*>(property->closure);
+        if (!propertyNames.count(property->name) && PyDiaSymbol_exposesMethod(type, getterMethod->ml_meth))
+        {
+            properties.push_back(*property);
+        }
+    }
+    properties.push_back({NULL, NULL, NULL, NULL, NULL});  // Sentinel
+
+    availablePropertyTables.push_back(std::move(properties));
+    type->tp_getset = availablePropertyTables.back().data();
+#else
+    UNREFERENCED_PARAMETER(type);
 #endif
+}
+
+namespace
+{
+// A single property readable by `to_dict`, backed either by a `METH_NOARGS` getter method or by a `tp_getset` getter.
+struct PyDiaSymbolDictField
+{
+    PyObject* key;  // Interned, and intentionally never released (the layouts live as long as the module)
+    PyCFunction method;
+    getter property;
+    void* closure;
+};
+
+// Every property readable on instances of a specific Python type, in output order.
+struct PyDiaSymbolDictLayout
+{
+    std::vector<PyDiaSymbolDictField> fields;
+    std::unordered_map<std::string, size_t> fieldIndexByKey;
+};
+}  // namespace
+
+static PyObject* PyDiaSymbol_readDictField(PyObject* self, const PyDiaSymbolDictField& field)
+{
+    return (nullptr != field.method) ? field.method(self, NULL) : field.property(self, field.closure);
+}
+
+// Builds (once per type) the list of properties available on `type`.
+// The type's MRO is walked from the most derived type, so a derived type's getter shadows its base's getter of the same name.
+// Only the getters from PyDiaSymbol_methods are considered, which keeps generators and other non-property methods out of the dict.
+// Python protocol methods (`__reduce__`) take no arguments either, but are not properties, so dunder names are skipped.
+static const PyDiaSymbolDictLayout* PyDiaSymbol_getDictLayout(PyTypeObject* type)
+{
+    static std::unordered_map<PyTypeObject*, PyDiaSymbolDictLayout> layoutsByType{};
+    const auto cachedLayout = layoutsByType.find(type);
+    if (layoutsByType.end() != cachedLayout)
+    {
+        return &cachedLayout->second;
+    }
+
+    static const std::unordered_set<PyCFunction> symbolGetters = []()
+    {
+        std::unordered_set<PyCFunction> getters{};
+        for (const PyMethodDef* method = PyDiaSymbol_methods; nullptr != method->ml_name; ++method)
+        {
+            if (METH_NOARGS == method->ml_flags && 0 != strncmp(method->ml_name, "__", 2))
+            {
+                getters.insert(method->ml_meth);
+            }
+        }
+        return getters;
+    }();
+
+    PyDiaSymbolDictLayout layout{};
+    const auto addField = [&layout](const char* name, PyCFunction method, getter property, void* closure) -> bool
+    {
+        if (layout.fieldIndexByKey.count(name))
+        {
+            return true;
+        }
+        PyObject* key = PyUnicode_InternFromString(name);
+        if (!key)
+        {
+            return false;
+        }
+        layout.fieldIndexByKey.emplace(name, layout.fields.size());
+        layout.fields.push_back({key, method, property, closure});
+        return true;
+    };
+
+    PyObject* mro = type->tp_mro;
+    _ASSERT_EXPR(nullptr != mro, L"Type must be ready before its instances are converted to dicts!");
+    for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(mro); ++i)
+    {
+        PyTypeObject* baseType = reinterpret_cast<PyTypeObject*>(PyTuple_GET_ITEM(mro, i));
+        if (!PyType_IsSubtype(baseType, &PyDiaSymbol_Type))
+        {
+            continue;
+        }
+
+        for (const PyGetSetDef* property = baseType->tp_getset; nullptr != property && nullptr != property->name; ++property)
+        {
+            if (nullptr != property->get && !addField(property->name, nullptr, property->get, property->closure))
+            {
+                return nullptr;
+            }
+        }
+
+        for (const PyMethodDef* method = baseType->tp_methods; nullptr != method && nullptr != method->ml_name; ++method)
+        {
+            if (METH_NOARGS != method->ml_flags || !symbolGetters.count(method->ml_meth))
+            {
+                continue;
+            }
+            // "get_name" is exported as "name", while "is_const" and "has_eh" keep their predicate prefix.
+            const char* name = (0 == strncmp(method->ml_name, "get_", 4)) ? (method->ml_name + 4) : method->ml_name;
+            if (!addField(name, method->ml_meth, nullptr, nullptr))
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    return &layoutsByType.emplace(type, std::move(layout)).first->second;
+}
+
+// Method: PyDiaSymbol_reduce
+PyObject* PyDiaSymbol_reduce(const PyDiaSymbol* self)
+{
+    PYDIA_ASSERT_SYMBOL_POINTERS(self);
+
+    // The raw pointers held by a PyDiaSymbol are meaningless in another process, so the symbol is reduced to the identity of its PDB and its
+    // path (see dia::SymbolLocator), which pydia._rehydrate_symbol resolves back against a per-process DataSource cache. symIndexIds would not
+    // do, as each session assigns them in the order symbols are looked up.
+    static PyObject* rehydrateSymbol = NULL;
+    if (!rehydrateSymbol)
+    {
+        PyObject* module = PyImport_ImportModule("pydia");
+        if (!module)
+        {
+            return NULL;
+        }
+        rehydrateSymbol = PyObject_GetAttrString(module, "_rehydrate_symbol");
+        Py_DECREF(module);
+        if (!rehydrateSymbol)
+        {
+            return NULL;
+        }
+    }
+
+    PYDIA_SAFE_TRY({
+        _ASSERT_EXPR(nullptr != self->dataSource->diaDataSource, L"Internal data source raw pointer must be initialized!");
+        PyObject* pdbPath = PyDiaDataSource_getLoadedPdbFile(self->dataSource);
+        if (!pdbPath)
+        {
+            return NULL;
+        }
+        const auto& globalScope = self->dataSource->diaDataSource->getGlobalScope();
+        const GUID guid         = globalScope.getGuid();
+        const DWORD age         = globalScope.getAge();
+        const auto path         = self->dataSource->diaDataSource->getSymbolPath(*self->diaSymbol);
+        PyObject* pyPath        = PyTuple_New(static_cast<Py_ssize_t>(path.size()));
+        for (size_t i = 0; pyPath && i < path.size(); ++i)
+        {
+            PyObject* step = Py_BuildValue("(kn)", static_cast<unsigned long>(path[i].symTag), static_cast<Py_ssize_t>(path[i].position));
+            if (!step)
+            {
+                Py_CLEAR(pyPath);
+                break;
+            }
+            PyTuple_SET_ITEM(pyPath, static_cast<Py_ssize_t>(i), step);
+        }
+        if (!pyPath)
+        {
+            return NULL;
+        }
+        return Py_BuildValue("O(Oy#kN)", rehydrateSymbol, pdbPath, reinterpret_cast<const char*>(&guid), static_cast<Py_ssize_t>(sizeof(guid)),
+                             static_cast<unsigned long>(age), pyPath);
+    });
+    Py_UNREACHABLE();
+}
+
+// Method: PyDiaSymbol_toDict
+PyObject* PyDiaSymbol_toDict(PyObject* self, PyObject* args, PyObject* kwargs)
+{
+    PYDIA_ASSERT_SYMBOL_POINTERS(reinterpret_cast<const PyDiaSymbol*>(self));
+
+    static const char* keywords[] = {"fields", NULL};
+    PyObject* requestedFields     = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|O", const_cast<char**>(keywords), &requestedFields))
+    {
+        return NULL;
+    }
+
+    const PyDiaSymbolDictLayout* layout = nullptr;
+    PYDIA_SAFE_TRY({ layout = PyDiaSymbol_getDictLayout(Py_TYPE(self)); });
+    if (!layout)
+    {
+        return NULL;
+    }
+
+    PyObject* dict = PyDict_New();
+    if (!dict)
+    {
+        return NULL;
+    }
+
+    // Returns false only on a genuine error; properties which are not available for this symbol are silently skipped.
+    const auto addFieldToDict = [self, dict](const PyDiaSymbolDictField& field) -> bool
+    {
+        PyObject* value = PyDiaSymbol_readDictField(self, field);
+        if (!value)
+        {
+            if (PyErr_ExceptionMatches(PyDiaPropertyNotAvailableError) || PyErr_ExceptionMatches(PyDiaInvalidUsageError))
+            {
+                PyErr_Clear();
+                return true;
+            }
+            return false;
+        }
+        const int result = PyDict_SetItem(dict, field.key, value);
+        Py_DECREF(value);
+        return 0 == result;
+    };
+
+    if (Py_None == requestedFields)
+    {
+        for (const auto& field : layout->fields)
+        {
+            if (!addFieldToDict(field))
+            {
+                Py_DECREF(dict);
+                return NULL;
+            }
+        }
+        return dict;
+    }
+
+    PyObject* iterator = PyObject_GetIter(requestedFields);
+    if (!iterator)
+    {
+        Py_DECREF(dict);
+        return NULL;
+    }
+
+    PyObject* requestedField = NULL;
+    while (NULL != (requestedField = PyIter_Next(iterator)))
+    {
+        const char* fieldName = PyUnicode_AsUTF8(requestedField);
+        if (!fieldName)
+        {
+            Py_DECREF(requestedField);
+            break;
+        }
+
+        const auto fieldIndex = layout->fieldIndexByKey.find(fieldName);
+        if (layout->fieldIndexByKey.end() == fieldIndex)
+        {
+            PyErr_Format(PyExc_ValueError, "\"%s\" is not a property of %s.", fieldName, Py_TYPE(self)->tp_name);
+            Py_DECREF(requestedField);
+            break;
+        }
+
+        Py_DECREF(requestedField);
+        if (!addFieldToDict(layout->fields.at(fieldIndex->second)))
+        {
+            break;
+        }
+    }
+    Py_DECREF(iterator);
+
+    if (PyErr_Occurred())
+    {
+        Py_DECREF(dict);
+        return NULL;
+    }
+    return dict;
+}
 
 // Method: PyDiaSymbol_getClassParent
 PyObject* PyDiaSymbol_getClassParent(const PyDiaSymbol* self)
@@ -1919,8 +2313,8 @@ PyObject* PyDiaSymbol_getName(const PyDiaSymbol* self)
 {
     PYDIA_ASSERT_SYMBOL_POINTERS(self);
     PYDIA_SAFE_TRY({
-        const BstrWrapper name = self->diaSymbol->getName();
-        return PyObject_FromBstrWrapper(name);
+        // Names are interned per session, and each distinct name is turned into a str once, which every symbol with that name shares.
+        return PyDiaDataSource_getSymbolName(self->dataSource, *self->diaSymbol);
     });
     Py_UNREACHABLE();
 }
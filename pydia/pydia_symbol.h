@@ -7,7 +7,12 @@
 
 #define PYDIA_DERIVED_SYMBOL_ADDITIONAL_MEMBERS                                                                                                      \
     PyDiaDataSource* dataSource; /* Ref-counted pointer to the datasource which this symbol comes from                                               \
-                                  */
+                                  */                                                                                                                 \
+    Py_hash_t cachedHash; /* PYDIA_SYMBOL_HASH_NOT_CALCULATED until the symbol is first hashed */
+
+// Symbols are immutable, so their (expensive) hash is calculated once and kept in the object.
+// -1 is never a valid Python hash, so it doubles as the marker for a hash which was not calculated yet.
+#define PYDIA_SYMBOL_HASH_NOT_CALCULATED (-1)
 
 // Define the Python DiaSymbolType object
 // This is much much to permissive and abstract to expose to Python users.
@@ -23,6 +28,9 @@ extern PyTypeObject PyDiaSymbol_Type;
 
 PyObject* PyDiaSymbol_FromSymbol(dia::Symbol&& symbol, PyDiaDataSource* dataSource);
 
+// Give a symbol type the common properties (`name`, `length`, ...) whose getter method it exposes. Must be called before PyType_Ready.
+void PyDiaSymbol_addAvailableProperties(PyTypeObject* type);
+
 // Auto decleration of trivial conversions like PyDiaSymbol_FromSymbol for all types
 #define DECLARE_PYDIA_SYMBOL_FROM_SYMBOL_TRIVIAL_CONVERSION(diaTypeName)                                                                             \
     PyObject* PyDia##diaTypeName##_From##diaTypeName##Symbol(dia::##diaTypeName&& symbol, PyDiaDataSource* dataSource);                              \
@@ -16,6 +16,9 @@
     PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE_AND_ITER(className, classMethods, &PyDiaSymbol_Type, iterFunc)
 
 #define PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE_AND_ITER(className, classMethods, baseType, iterFunc)                                                 \
+    PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE_ITER_AND_GETSET(className, classMethods, baseType, iterFunc, 0)
+
+#define PYDIA_SYMBOL_TYPE_DEFINITION_WITH_BASE_ITER_AND_GETSET(className, classMethods, baseType, iterFunc, classGetSet)                              \
     PyTypeObject PyDia##className##_Type = {                                                                                                         \
         PyVarObject_HEAD_INIT(NULL, 0) "pydia." #className,                      /* tp_name */                                                       \
         sizeof(PyDia##className),                                                /* tp_basicsize */                                                  \
@@ -25,7 +28,7 @@
         0,                                                                       /* tp_getattr */                                                    \
         0,                                                                       /* tp_setattr */                                                    \
         0,                                                                       /* tp_as_async */                                                   \
-        0 /* (reprfunc)PyDiaSymbol_repr --- TODO: This doesn't work too well */, /* tp_repr */                                                       \
+        (reprfunc)PyDiaSymbol_repr,                                              /* tp_repr */                                                       \
         0,                                                                       /* tp_as_number */                                                  \
         0,                                                                       /* tp_as_sequence */                                                \
         0,                                                                       /* tp_as_mapping */                                                 \
@@ -45,7 +48,7 @@
         0,                                                                       /* tp_iternext */                                                   \
         classMethods,                                                            /* tp_methods */                                                    \
         0,                                                                       /* tp_members */                                                    \
-        0,                                                                       /* tp_getset */                                                     \
+        classGetSet,                                                             /* tp_getset */                                                     \
         baseType,                                                                /* tp_base */                                                       \
         0,                                                                       /* tp_dict */                                                       \
         0,                                                                       /* tp_descr_get */                                                  \
@@ -57,10 +60,37 @@
     };
 
 
+// Adapts a `PyDiaSymbol_getX` implementation to the `getter` signature expected by `tp_getset`.
+// The getter is a template argument (rather than the `closure`) so the call is direct and inlinable; attribute access through the resulting
+// descriptor skips the bound-method creation and argument vector handling that `METH_NOARGS` entries pay on every call.
+// Exceptions are still translated by the wrapped getter, whose `try` block has no cost on the success path.
+template <PyObject* (*symbolGetter)(const PyDiaSymbol*)>
+static PyObject* PyDiaSymbol_propertyGetter(PyObject* self, void* /* closure */)
+{
+    return symbolGetter(reinterpret_cast<const PyDiaSymbol*>(self));
+}
+
+// The closure is the method entry of the same getter, which `PyDiaSymbol_addAvailableProperties` uses to gate the property like the method.
+#define PYDIA_SYMBOL_PROPERTY(propertyName, getterName, doc)                                                                                         \
+    {                                                                                                                                                \
+        propertyName, (getter)PyDiaSymbol_propertyGetter<PyDiaSymbol_##getterName>, NULL, doc, &PyDiaSymbolMethodEntry_##getterName                  \
+    }
+
 Py_hash_t PyDiaSymbol_hash(PyObject* self);
 PyObject* PyDiaSymbol_richcompare(PyObject* self, PyObject* other, int op);
 PyObject* PyDiaSymbol_repr(const PyDiaSymbol* self);
 
+PyObject* PyDiaSymbol_toDict(PyObject* self, PyObject* args, PyObject* kwargs);
+static PyMethodDef PyDiaSymbolMethodEntry_toDict = {
+    "to_dict", (PyCFunction)PyDiaSymbol_toDict, METH_VARARGS | METH_KEYWORDS,
+    "Return a dict of every available property of the symbol (or only the given `fields`). Unavailable properties are skipped."};
+
+PyObject* PyDiaSymbol_reduce(const PyDiaSymbol* self);
+static PyMethodDef PyDiaSymbolMethodEntry_reduce = {
+    "__reduce__", (PyCFunction)PyDiaSymbol_reduce, METH_NOARGS,
+    "Pickle support. A symbol is pickled as its PDB path, GUID, age and the enumeration positions leading to it, and rehydrated against a "
+    "per-process DataSource cache."};
+
 PyObject* PyDiaSymbol_getAccess(const PyDiaSymbol* self);
 static PyMethodDef PyDiaSymbolMethodEntry_getAccess = {"get_access", (PyCFunction)PyDiaSymbol_getAccess, METH_NOARGS,
                                                        "Get the access level of the function."};
@@ -19,6 +19,8 @@
                                                                                                                                                      \
     static int PyDia##diaName##_init(PyDia##diaName* self, PyObject* args, PyObject* kwds)                                                           \
     {                                                                                                                                                \
+        self->cachedHash = PYDIA_SYMBOL_HASH_NOT_CALCULATED;                                                                                         \
+                                                                                                                                                     \
         const auto unsafeInit =                                                                                                                      \
             [&]() -> int { /* Check if the function was called with 0 or 2 arguments*/                                                               \
                            if (0 == PyTuple_Size(args))                                                                                              \
@@ -107,6 +109,7 @@
                                                                                                                                                      \
         Py_INCREF(dataSource);                                                                                                                       \
         pySymbol->dataSource = dataSource;                                                                                                           \
+        pySymbol->cachedHash = PYDIA_SYMBOL_HASH_NOT_CALCULATED;                                                                                     \
                                                                                                                                                      \
         Py_INCREF(pySymbol);                                                                                                                         \
         return reinterpret_cast<PyObject*>(pySymbol);                                                                                                \
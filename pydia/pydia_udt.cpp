@@ -26,7 +26,8 @@ static void PyDiaUdt_dealloc(PyDiaUdt* self)
 
 static int PyDiaUdt_init(PyDiaUdt* self, PyObject* args, PyObject* kwds)
 {
-    self->diaUdt = new (std::nothrow) dia::UserDefinedType();
+    self->cachedHash = PYDIA_SYMBOL_HASH_NOT_CALCULATED;
+    self->diaUdt     = new (std::nothrow) dia::UserDefinedType();
     if (!self->diaUdt)
     {
         PyErr_SetString(PyExc_MemoryError, "Failed to create Udt object.");
@@ -74,7 +75,7 @@ PyTypeObject PyDiaUdt_Type = {
     0,                                          /* tp_getattr */
     0,                                          /* tp_setattr */
     0,                                          /* tp_as_async */
-    0,                                          /* tp_repr */
+    (reprfunc)PyDiaSymbol_repr,                 /* tp_repr */
     0,                                          /* tp_as_number */
     0,                                          /* tp_as_sequence */
     0,                                          /* tp_as_mapping */
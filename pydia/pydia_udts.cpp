@@ -4,9 +4,12 @@
 // Python.h must be included before anything else
 #include <objbase.h>
 #include <optional>
+#include <vector>
 
 // C pydia imports
+#include "dia_types/pydia_minidump.h"
 #include "pydia_data.h"
+#include "pydia_decode.h"
 #include "pydia_enum.h"
 #include "pydia_exceptions.h"
 #include "pydia_generators.h"
@@ -22,6 +25,14 @@
 
 static PyObject* PyDiaUdt_Abstract_enumerateMembers(PyDiaUdt_Abstract* self);
 static PyObject* PyDiaUdt_Abstract_getDependencies(PyDiaUdt_Abstract* self);
+static PyObject* PyDiaUdt_Abstract_analyzeLayout(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs);
+static PyObject* PyDiaUdt_Abstract_resolveFieldPath(PyDiaUdt_Abstract* self, PyObject* args);
+static PyObject* PyDiaUdt_Abstract_decode(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs);
+static PyObject* PyDiaUdt_Abstract_decodeMany(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs);
+static PyObject* PyDiaUdt_Abstract_toNumpyDtype(PyDiaUdt_Abstract* self);
+static PyObject* PyDiaUdt_Abstract_extractBitfields(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs);
+static PyObject* PyDiaUdt_Abstract_walkList(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs);
+static PyObject* PyDiaUdt_Abstract_walkTree(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs);
 
 
 #define __INIT_DEINIT_UDT(udtName) TRIVIAL_INIT_DEINIT_CUSTOM_FIELD(udtName, UserDefinedType)
@@ -55,6 +66,42 @@ static PyMethodDef PyDiaUdt_Abstract_methods[] = {
     {"enumerate_members", (PyCFunction)PyDiaUdt_Abstract_enumerateMembers, METH_NOARGS, "Iterate over all members (fields) of the UDT."},
     {"get_dependencies", (PyCFunction)PyDiaUdt_Abstract_getDependencies, METH_NOARGS,
      "Return the other user defined types that this UDT depends on. Pointer dependecies (forward declerations) are not included."},
+    {"analyze_layout", (PyCFunction)PyDiaUdt_Abstract_analyzeLayout, METH_VARARGS | METH_KEYWORDS,
+     "analyze_layout(cache_line_size=64)\n"
+     "Return a dict describing the memory layout of the UDT: its fields, the holes between them, the tail padding, the unused bitfield bits, the "
+     "fields straddling cache lines and the minimum size reordering the fields would give."},
+    {"resolve_field_path", (PyCFunction)PyDiaUdt_Abstract_resolveFieldPath, METH_VARARGS,
+     "resolve_field_path(path)\n"
+     "Resolve a path of members and array indices such as 'Pcb.DirectoryTableBase' or 'a.b[3].c', looking through anonymous unions, anonymous "
+     "structs and base classes. Returns a dict with the offset, size, bitfield position and length, and type of the field. Resolved paths are "
+     "cached by the DataSource."},
+    {"decode", (PyCFunction)PyDiaUdt_Abstract_decode, METH_VARARGS | METH_KEYWORDS,
+     "decode(buffer, offset=0, as_tuple=False)\n"
+     "Decode an instance of the UDT from a bytes-like object, starting at offset. Returns a dict of the fields by name (or a tuple of the fields in "
+     "declaration order), with nested UDTs decoded the same way and arrays decoded into lists. The decode plan is compiled once per type."},
+    {"decode_many", (PyCFunction)PyDiaUdt_Abstract_decodeMany, METH_VARARGS | METH_KEYWORDS,
+     "decode_many(buffer, count=None, offset=0, as_tuple=False)\n"
+     "Decode count contiguous instances of the UDT from a bytes-like object such as a memoryview, starting at offset. By default, decode as many "
+     "instances as the buffer holds. Returns a list of what decode returns."},
+    {"to_numpy_dtype", (PyCFunction)PyDiaUdt_Abstract_toNumpyDtype, METH_NOARGS,
+     "Return a numpy structured dtype with the offsets and itemsize of the UDT, to view buffers of instances with numpy.frombuffer. Nested UDTs "
+     "are flattened into fields named 'outer.inner' and arrays become subarrays. Each storage unit of bitfields is a single unsigned field, and "
+     "dtype.metadata['bitfields'] maps the name of every bitfield to (storage field name, bit position, bit length, is signed). Requires numpy."},
+    {"extract_bitfields", (PyCFunction)PyDiaUdt_Abstract_extractBitfields, METH_VARARGS | METH_KEYWORDS,
+     "extract_bitfields(buffer, names, count=None, offset=0)\n"
+     "Extract bitfields (or any integer fields) out of count contiguous instances of the UDT in a bytes-like object, starting at offset. names are "
+     "field paths as accepted by resolve_field_path. Returns a dict of a memoryview of 64 bit integers per name, which numpy.frombuffer views "
+     "without a copy. By default, extract out of as many instances as the buffer holds."},
+    {"walk_list", (PyCFunction)PyDiaUdt_Abstract_walkList, METH_VARARGS | METH_KEYWORDS,
+     "walk_list(memory, head_address, link_path, next_member='Flink', max_nodes=0x100000, decode=False, as_tuple=False)\n"
+     "Walk an intrusive list of instances of the UDT, linked by the field at link_path (e.g. a LIST_ENTRY), from the address of its head until it "
+     "goes back to the head or reaches a null link. memory is a Minidump or a callable taking (address, size) and returning bytes. Returns "
+     "(nodes, status), where nodes are the addresses of the instances (or their decoded dicts, or None if unreadable) and status is 'Completed', "
+     "'CycleDetected', 'MemoryNotReadable' or 'NodeLimitReached'."},
+    {"walk_tree", (PyCFunction)PyDiaUdt_Abstract_walkTree, METH_VARARGS | METH_KEYWORDS,
+     "walk_tree(memory, root_address, link_path, left_member='Left', right_member='Right', max_nodes=0x100000, decode=False, as_tuple=False)\n"
+     "Walk a binary tree of instances of the UDT in order, linked by the field at link_path (e.g. a RTL_BALANCED_NODE), from the address of the "
+     "link of its root. Returns (nodes, status) like walk_list."},
     {NULL, NULL, 0, NULL}  // Sentinel
 };
 
@@ -129,6 +176,436 @@ static PyObject* PyDiaUdt_Abstract_getDependencies(PyDiaUdt_Abstract* self)
     Py_UNREACHABLE();
 }
 
+static PyObject* PyDiaUdt_Abstract_analyzeLayout(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs)
+{
+    _ASSERT(NULL != self);
+    _ASSERT(NULL != self->diaUserDefinedType);
+
+    static const char* keywords[]    = {"cache_line_size", nullptr};
+    unsigned long long cacheLineSize = dia::DEFAULT_CACHE_LINE_SIZE;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|K", const_cast<char**>(keywords), &cacheLineSize))
+    {
+        return NULL;
+    }
+
+    PYDIA_SAFE_TRY({ return PyObject_FromStructLayout(self->diaUserDefinedType->analyzeLayout(cacheLineSize)); });
+    Py_UNREACHABLE();
+}
+
+static PyObject* PyDiaUdt_Abstract_resolveFieldPath(PyDiaUdt_Abstract* self, PyObject* args)
+{
+    _ASSERT(NULL != self);
+    _ASSERT(NULL != self->diaUserDefinedType);
+
+    PyObject* pyPath = nullptr;
+    if (!PyArg_ParseTuple(args, "U", &pyPath))
+    {
+        return NULL;
+    }
+    const std::wstring path(PyObjectToAnyString(pyPath));
+    if (PyErr_Occurred())
+    {
+        return NULL;
+    }
+
+    PYDIA_SAFE_TRY({
+        const auto& fieldPath = self->dataSource->diaDataSource->resolveFieldPath(*self->diaUserDefinedType, path);
+        auto type             = fieldPath.type;
+        return Py_BuildValue("{s:K,s:K,s:N,s:k,s:K,s:N}", "offset", fieldPath.offset, "size", fieldPath.size, "is_bitfield",
+                             PyBool_FromLong(fieldPath.isBitfield), "bit_position", fieldPath.bitPosition, "bit_length", fieldPath.bitLength,
+                             "type", PyDiaSymbol_FromSymbol(std::move(type), self->dataSource));
+    });
+    Py_UNREACHABLE();
+}
+
+// Get the decode plan of the UDT, along with the buffer holding `count` instances of it starting at `offset` (all the instances it holds if count
+// is negative). On success, the caller must release the buffer.
+static const dia::DecodePlan* getDecodePlanAndBuffer(PyDiaUdt_Abstract* self, PyObject* bufferObject, Py_ssize_t offset, Py_ssize_t& count,
+                                                     Py_buffer& buffer)
+{
+    const dia::DecodePlan* plan = nullptr;
+    PYDIA_SAFE_TRY({ plan = &self->dataSource->diaDataSource->getDecodePlan(*self->diaUserDefinedType); });
+    if (0 == plan->size)
+    {
+        PyErr_SetString(PyExc_ValueError, "Cannot decode a UDT without a size.");
+        return NULL;
+    }
+    if (offset < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "offset must not be negative.");
+        return NULL;
+    }
+    if (0 != PyObject_GetBuffer(bufferObject, &buffer, PyBUF_SIMPLE))
+    {
+        return NULL;
+    }
+
+    const auto instanceSize   = static_cast<Py_ssize_t>(plan->size);
+    const auto availableBytes = (buffer.len > offset) ? buffer.len - offset : 0;
+    if (count < 0)
+    {
+        count = availableBytes / instanceSize;
+    }
+    if (count > availableBytes / instanceSize)
+    {
+        PyBuffer_Release(&buffer);
+        PyErr_SetString(PyExc_ValueError, "The buffer is too small for the requested instances.");
+        return NULL;
+    }
+    return plan;
+}
+
+static PyObject* PyDiaUdt_Abstract_decode(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs)
+{
+    _ASSERT(NULL != self);
+    _ASSERT(NULL != self->diaUserDefinedType);
+
+    static const char* keywords[] = {"buffer", "offset", "as_tuple", nullptr};
+    PyObject* bufferObject        = nullptr;
+    Py_ssize_t offset             = 0;
+    int asTuple                   = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|np", const_cast<char**>(keywords), &bufferObject, &offset, &asTuple))
+    {
+        return NULL;
+    }
+
+    Py_ssize_t count = 1;
+    Py_buffer buffer{};
+    const auto plan = getDecodePlanAndBuffer(self, bufferObject, offset, count, buffer);
+    if (!plan)
+    {
+        return NULL;
+    }
+    PyObject* instance = PyDiaDecode_decodeInstance(self->dataSource, *plan, static_cast<const uint8_t*>(buffer.buf) + offset, 0 != asTuple);
+    PyBuffer_Release(&buffer);
+    return instance;
+}
+
+static PyObject* PyDiaUdt_Abstract_decodeMany(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs)
+{
+    _ASSERT(NULL != self);
+    _ASSERT(NULL != self->diaUserDefinedType);
+
+    static const char* keywords[] = {"buffer", "count", "offset", "as_tuple", nullptr};
+    PyObject* bufferObject        = nullptr;
+    PyObject* countObject         = Py_None;
+    Py_ssize_t offset             = 0;
+    int asTuple                   = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Onp", const_cast<char**>(keywords), &bufferObject, &countObject, &offset, &asTuple))
+    {
+        return NULL;
+    }
+    Py_ssize_t count = -1;
+    if (Py_None != countObject)
+    {
+        count = PyLong_AsSsize_t(countObject);
+        if (-1 == count && PyErr_Occurred())
+        {
+            return NULL;
+        }
+        if (count < 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "count must not be negative.");
+            return NULL;
+        }
+    }
+
+    Py_buffer buffer{};
+    const auto plan = getDecodePlanAndBuffer(self, bufferObject, offset, count, buffer);
+    if (!plan)
+    {
+        return NULL;
+    }
+    PyObject* instances = PyList_New(count);
+    for (Py_ssize_t i = 0; instances && i < count; ++i)
+    {
+        const auto instanceBytes = static_cast<const uint8_t*>(buffer.buf) + offset + i * static_cast<Py_ssize_t>(plan->size);
+        PyObject* instance       = PyDiaDecode_decodeInstance(self->dataSource, *plan, instanceBytes, 0 != asTuple);
+        if (!instance)
+        {
+            Py_CLEAR(instances);
+            break;
+        }
+        PyList_SET_ITEM(instances, i, instance);
+    }
+    PyBuffer_Release(&buffer);
+    return instances;
+}
+
+static PyObject* PyDiaUdt_Abstract_toNumpyDtype(PyDiaUdt_Abstract* self)
+{
+    _ASSERT(NULL != self);
+    _ASSERT(NULL != self->diaUserDefinedType);
+
+    const dia::DecodePlan* plan = nullptr;
+    PYDIA_SAFE_TRY({ plan = &self->dataSource->diaDataSource->getDecodePlan(*self->diaUserDefinedType); });
+    return PyDiaDecode_toNumpyDtype(self->dataSource, *plan);
+}
+
+// Resolve a field path of the UDT into the operation extracting its integer. Returns false with an exception set on failure.
+// The field must lie within an instance, as the instances are only checked to fit in the buffer.
+static bool getIntegerDecodeOp(PyDiaUdt_Abstract* self, PyObject* pyPath, dia::DecodeOp& op)
+{
+    if (!PyUnicode_Check(pyPath))
+    {
+        PyErr_SetString(PyExc_TypeError, "Field names must be strings.");
+        return false;
+    }
+    const std::wstring path(PyObjectToAnyString(pyPath));
+    if (PyErr_Occurred())
+    {
+        return false;
+    }
+
+    PYDIA_SAFE_TRY_EXCEPT_NOT_AVAILABLE(
+        {
+            const auto& plan = self->dataSource->diaDataSource->getDecodePlan(*self->diaUserDefinedType);
+            op               = dia::makeIntegerDecodeOp(self->dataSource->diaDataSource->resolveFieldPath(*self->diaUserDefinedType, path));
+            if (op.width > plan.size || op.offset > plan.size - op.width)
+            {
+                PyErr_SetString(PyExc_ValueError, "The field does not lie within an instance of the UDT.");
+                return false;
+            }
+            return true;
+        },
+        {
+            PyErr_SetString(PyDiaPropertyNotAvailableError, e.what());
+            return false;
+        },
+        {
+            PyErr_SetString(PyDiaError, e.what());
+            return false;
+        });
+    Py_UNREACHABLE();
+}
+
+static PyObject* PyDiaUdt_Abstract_extractBitfields(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs)
+{
+    _ASSERT(NULL != self);
+    _ASSERT(NULL != self->diaUserDefinedType);
+
+    static const char* keywords[] = {"buffer", "names", "count", "offset", nullptr};
+    PyObject* bufferObject        = nullptr;
+    PyObject* namesObject         = nullptr;
+    PyObject* countObject         = Py_None;
+    Py_ssize_t offset             = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|On", const_cast<char**>(keywords), &bufferObject, &namesObject, &countObject, &offset))
+    {
+        return NULL;
+    }
+    Py_ssize_t count = -1;
+    if (Py_None != countObject)
+    {
+        count = PyLong_AsSsize_t(countObject);
+        if (-1 == count && PyErr_Occurred())
+        {
+            return NULL;
+        }
+        if (count < 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "count must not be negative.");
+            return NULL;
+        }
+    }
+
+    PyObject* names = PySequence_Fast(namesObject, "names must be a sequence of field paths.");
+    if (!names)
+    {
+        return NULL;
+    }
+    // Resolve all the fields before touching the buffer, so a bad name does not scan anything.
+    const auto nameCount = PySequence_Fast_GET_SIZE(names);
+    std::vector<dia::DecodeOp> ops(static_cast<size_t>(nameCount));
+    for (Py_ssize_t i = 0; i < nameCount; ++i)
+    {
+        if (!getIntegerDecodeOp(self, PySequence_Fast_GET_ITEM(names, i), ops[i]))
+        {
+            Py_DECREF(names);
+            return NULL;
+        }
+    }
+
+    Py_buffer buffer{};
+    const auto plan = getDecodePlanAndBuffer(self, bufferObject, offset, count, buffer);
+    if (!plan)
+    {
+        Py_DECREF(names);
+        return NULL;
+    }
+    const auto instances = static_cast<const uint8_t*>(buffer.buf) + offset;
+    PyObject* fields     = PyDict_New();
+    for (Py_ssize_t i = 0; fields && i < nameCount; ++i)
+    {
+        PyObject* values = PyDiaDecode_extractIntegers(ops[i], instances, count, plan->size);
+        if (!values || 0 != PyDict_SetItem(fields, PySequence_Fast_GET_ITEM(names, i), values))
+        {
+            Py_CLEAR(fields);
+        }
+        Py_XDECREF(values);
+    }
+    PyBuffer_Release(&buffer);
+    Py_DECREF(names);
+    return fields;
+}
+
+// Walk a list or a tree of instances of the UDT (see dia::LinkWalker), reporting the addresses of the instances or their decoded records.
+static PyObject* walkLinks(PyDiaUdt_Abstract* self, bool isTree, PyObject* memory, unsigned long long startAddress, PyObject* pyLinkPath,
+                           const dia::LinkWalkOptions& options, bool decode, bool asTuple)
+{
+    dia::MemoryReader readMemory{};
+    if (!PyDiaMinidump_getMemoryReader(memory, readMemory))
+    {
+        return NULL;
+    }
+    const std::wstring linkPath(PyObjectToAnyString(pyLinkPath));
+    if (PyErr_Occurred())
+    {
+        return NULL;
+    }
+
+    PyObject* nodes = PyList_New(0);
+    if (!nodes)
+    {
+        return NULL;
+    }
+    const dia::DecodePlan* plan = nullptr;
+    std::vector<uint8_t> record{};
+    const auto onBatch = [&](const ULONGLONG* containerAddresses, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            PyObject* node = NULL;
+            if (!plan)
+            {
+                node = PyLong_FromUnsignedLongLong(containerAddresses[i]);
+            }
+            else if (record.size() == readMemory(containerAddresses[i], record.data(), record.size()))
+            {
+                node = PyDiaDecode_decodeInstance(self->dataSource, *plan, record.data(), asTuple);
+            }
+            else if (!PyErr_Occurred())
+            {
+                Py_INCREF(Py_None);
+                node = Py_None;
+            }
+            if (!node || 0 != PyList_Append(nodes, node))
+            {
+                Py_XDECREF(node);
+                return false;
+            }
+            Py_DECREF(node);
+        }
+        return !PyErr_Occurred();
+    };
+
+    auto status = dia::LinkWalkStatus::Completed;
+    PYDIA_SAFE_TRY_EXCEPT_NOT_AVAILABLE(
+        {
+            if (decode)
+            {
+                plan = &self->dataSource->diaDataSource->getDecodePlan(*self->diaUserDefinedType);
+                record.resize(static_cast<size_t>(plan->size));
+            }
+            dia::LinkWalker walker(*self->dataSource->diaDataSource, *self->diaUserDefinedType, linkPath, readMemory);
+            status = isTree ? walker.walkTree(startAddress, options, onBatch) : walker.walkList(startAddress, options, onBatch);
+        },
+        {
+            Py_DECREF(nodes);
+            PyErr_SetString(PyDiaPropertyNotAvailableError, e.what());
+            return NULL;
+        },
+        {
+            Py_DECREF(nodes);
+            PyErr_SetString(PyDiaError, e.what());
+            return NULL;
+        });
+    // The walk stops when the memory callable raises or a record cannot be decoded.
+    if (PyErr_Occurred())
+    {
+        Py_DECREF(nodes);
+        return NULL;
+    }
+    return Py_BuildValue("(NN)", nodes, PyObject_FromWstring(dia::linkWalkStatusToName(status)));
+}
+
+static PyObject* PyDiaUdt_Abstract_walkList(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs)
+{
+    _ASSERT(NULL != self);
+    _ASSERT(NULL != self->diaUserDefinedType);
+
+    static const char* keywords[]  = {"memory", "head_address", "link_path", "next_member", "max_nodes", "decode", "as_tuple", nullptr};
+    PyObject* memory               = nullptr;
+    unsigned long long headAddress = 0;
+    PyObject* pyLinkPath           = nullptr;
+    PyObject* pyNextMember         = nullptr;
+    dia::LinkWalkOptions options{};
+    Py_ssize_t maxNodes = static_cast<Py_ssize_t>(options.maxNodes);
+    int decode          = 0;
+    int asTuple         = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OKU|Unpp", const_cast<char**>(keywords), &memory, &headAddress, &pyLinkPath, &pyNextMember,
+                                     &maxNodes, &decode, &asTuple))
+    {
+        return NULL;
+    }
+    if (maxNodes < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "max_nodes must not be negative.");
+        return NULL;
+    }
+    options.maxNodes = static_cast<size_t>(maxNodes);
+    if (pyNextMember)
+    {
+        options.nextMember = std::wstring(PyObjectToAnyString(pyNextMember));
+        if (PyErr_Occurred())
+        {
+            return NULL;
+        }
+    }
+    return walkLinks(self, false, memory, headAddress, pyLinkPath, options, 0 != decode, 0 != asTuple);
+}
+
+static PyObject* PyDiaUdt_Abstract_walkTree(PyDiaUdt_Abstract* self, PyObject* args, PyObject* kwargs)
+{
+    _ASSERT(NULL != self);
+    _ASSERT(NULL != self->diaUserDefinedType);
+
+    static const char* keywords[] = {"memory", "root_address", "link_path", "left_member", "right_member", "max_nodes", "decode", "as_tuple",
+                                     nullptr};
+    PyObject* memory               = nullptr;
+    unsigned long long rootAddress = 0;
+    PyObject* pyLinkPath           = nullptr;
+    PyObject* pyLeftMember         = nullptr;
+    PyObject* pyRightMember        = nullptr;
+    dia::LinkWalkOptions options{};
+    Py_ssize_t maxNodes = static_cast<Py_ssize_t>(options.maxNodes);
+    int decode          = 0;
+    int asTuple         = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OKU|UUnpp", const_cast<char**>(keywords), &memory, &rootAddress, &pyLinkPath, &pyLeftMember,
+                                     &pyRightMember, &maxNodes, &decode, &asTuple))
+    {
+        return NULL;
+    }
+    if (maxNodes < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "max_nodes must not be negative.");
+        return NULL;
+    }
+    options.maxNodes = static_cast<size_t>(maxNodes);
+    if (pyLeftMember)
+    {
+        options.leftMember = std::wstring(PyObjectToAnyString(pyLeftMember));
+    }
+    if (pyRightMember)
+    {
+        options.rightMember = std::wstring(PyObjectToAnyString(pyRightMember));
+    }
+    if (PyErr_Occurred())
+    {
+        return NULL;
+    }
+    return walkLinks(self, true, memory, rootAddress, pyLinkPath, options, 0 != decode, 0 != asTuple);
+}
+
 PyObject* registerUdtPyClasses(PyObject* module)
 {
     if (!module)
@@ -221,6 +698,7 @@ PyObject* PyDiaUdt_FromSymbol(dia::Symbol&& symbol, PyDiaDataSource* dataSource)
 
     Py_INCREF(dataSource);
     reinterpret_cast<PyDiaUdt_Abstract*>(pySymbol)->dataSource = dataSource;
+    reinterpret_cast<PyDiaUdt_Abstract*>(pySymbol)->cachedHash = PYDIA_SYMBOL_HASH_NOT_CALCULATED;
 
     return pySymbol;
 }
@@ -19,6 +19,11 @@ static PyDiaModuleState* pydia_getModuleState(PyObject* module);
 
 static PyMethodDef PyDiaMethods[] = {
     PyDiaModuleMethodEntry_resolveTypeName,
+    PyDiaModuleMethodEntry_rehydrateSymbol,
+    PyDiaModuleMethodEntry_generateHeader,
+    PyDiaModuleMethodEntry_dumpSymbols,
+    PyDiaModuleMethodEntry_analyzeStructLayouts,
+    PyDiaModuleMethodEntry_undecorateMany,
 
     {NULL, NULL, 0, NULL} /* Sentinel */
 };